@@ -32,6 +32,7 @@
 #include "SDL_mutex.hpp"
 #include "SDL_surface.hpp"
 #include "SDL_window.hpp"
+#include "SDL_render.hpp"
 #include "SDL_audio.hpp"
 #include "SDL_openGL.hpp"
 #include "SDL_gpu.hpp"
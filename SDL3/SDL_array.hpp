@@ -0,0 +1,153 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_ARRAY_HPP__
+#define __SDL_ARRAY_HPP__
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_error.h>
+
+namespace SDL
+{
+/*
+==================================================================
+Array
+==================================================================
+    Growable array for plain data types, backed by SDL_realloc.
+    Elements are moved with SDL_memcpy and are never constructed or
+    destructed, so only use it with trivially copyable types.
+
+    Example usage:
+        SDL::Array<SDL_FRect> rects;
+        rects.Append( rect );
+        renderer.RenderFillRects( rects.Ptr(), rects.Num() );
+        rects.Clear();
+==================================================================
+*/
+    template<typename t_>
+    class Array
+    {
+    public:
+        Array( void ) : data( nullptr ), num( 0 ), capacity( 0 ) {}
+        ~Array( void ) { Free(); }
+
+        SDL_INLINE void Free( void )
+        {
+            SDL_free( data );
+            data = nullptr;
+            num = 0;
+            capacity = 0;
+        }
+
+        /// @brief Make room for at least count elements.
+        /// @return false if the allocation failed
+        SDL_INLINE bool Reserve( const int count )
+        {
+            if ( count <= capacity )
+                return true;
+
+            int grow = capacity > 0 ? capacity : 16;
+            while ( grow < count )
+                grow *= 2;
+
+            t_* ptr = static_cast<t_*>( SDL_realloc( data, sizeof( t_ ) * grow ) );
+            if ( ptr == nullptr )
+                return false;
+
+            data = ptr;
+            capacity = grow;
+            return true;
+        }
+
+        /// @brief Set the number of elements, new elements are left uninitialized.
+        SDL_INLINE bool Resize( const int count )
+        {
+            if ( !Reserve( count ) )
+                return false;
+            num = count;
+            return true;
+        }
+
+        /// @brief Add a element at the end
+        /// @return a pointer to the new element, or nullptr if the allocation failed
+        SDL_INLINE t_* Append( const t_ &value )
+        {
+            if ( !Reserve( num + 1 ) )
+                return nullptr;
+            SDL_memcpy( &data[num], &value, sizeof( t_ ) );
+            return &data[num++];
+        }
+
+        /// @brief Add count uninitialized elements at the end
+        /// @return a pointer to the first new element, or nullptr if the allocation failed
+        SDL_INLINE t_* AppendUninitialized( const int count )
+        {
+            if ( !Reserve( num + count ) )
+                return nullptr;
+            t_* first = &data[num];
+            num += count;
+            return first;
+        }
+
+        /// @brief Remove a element by moving the last one into its place
+        SDL_INLINE void RemoveIndexFast( const int index )
+        {
+            if ( index != num - 1 )
+                SDL_memcpy( &data[index], &data[num - 1], sizeof( t_ ) );
+            num--;
+        }
+
+        /// @brief Remove a element keeping the order of the others
+        SDL_INLINE void RemoveIndex( const int index )
+        {
+            SDL_memmove( &data[index], &data[index + 1], sizeof( t_ ) * ( num - index - 1 ) );
+            num--;
+        }
+
+        SDL_INLINE void         Clear( void ) { num = 0; }
+        SDL_INLINE int          Num( void ) const { return num; }
+        SDL_INLINE int          Capacity( void ) const { return capacity; }
+        SDL_INLINE size_t       Size( void ) const { return sizeof( t_ ) * num; }
+        SDL_INLINE bool         Empty( void ) const { return num == 0; }
+        SDL_INLINE t_*          Ptr( void ) { return data; }
+        SDL_INLINE const t_*    Ptr( void ) const { return data; }
+        SDL_INLINE t_&          Last( void ) { return data[num - 1]; }
+
+        SDL_INLINE t_&          operator[]( const int index ) { return data[index]; }
+        SDL_INLINE const t_&    operator[]( const int index ) const { return data[index]; }
+
+    private:
+        // not copyable, the storage is owned
+        Array( const Array &ref );
+        Array& operator=( const Array &ref );
+
+        t_*     data;
+        int     num;
+        int     capacity;
+    };
+};
+
+#endif //!__SDL_ARRAY_HPP__
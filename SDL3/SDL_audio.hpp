@@ -161,6 +161,7 @@ namespace SDL
         {
         public:
             Stream( void ) : stream( nullptr ) {}
+            Stream( SDL_AudioStream *ptr ) : stream( ptr ) {}
             Stream( const Stream &ref ) : stream( ref.stream ) {}
             ~Stream( void ) {}
         
@@ -0,0 +1,594 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_BIND_CACHE_HPP__
+#define __SDL_BIND_CACHE_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+        struct BindStats
+        {
+            Uint64  calls;          // bind calls made to the cache
+            Uint64  slots;          // slots ( or pipelines ) they set
+            Uint64  redundantSlots; // set to what was already bound, dropped
+            Uint64  sdlCalls;       // bind calls forwarded to SDL
+            Uint64  sdlSlots;       // slots they set, including the unchanged slots between two updates
+            Uint64  flushes;        // draws and dispatches
+        };
+
+        SDL_INLINE bool BindEqual( const SDL_GPUBufferBinding &a, const SDL_GPUBufferBinding &b ) { return a.buffer == b.buffer && a.offset == b.offset; }
+        SDL_INLINE bool BindEqual( const SDL_GPUTextureSamplerBinding &a, const SDL_GPUTextureSamplerBinding &b ) { return a.texture == b.texture && a.sampler == b.sampler; }
+        SDL_INLINE bool BindEqual( SDL_GPUTexture *a, SDL_GPUTexture *b ) { return a == b; }
+        SDL_INLINE bool BindEqual( SDL_GPUBuffer *a, SDL_GPUBuffer *b ) { return a == b; }
+
+/*
+==================================================================
+BindSlots
+==================================================================
+    Shadow of one kind of binding ( vertex buffers, fragment samplers,
+    ... ) for the bind caches below. Set records the wanted value of
+    each slot and only marks it dirty when it differs from what SDL
+    has bound, NextRun then returns the dirty slots as ranges to bind
+    with one call each. A range may cover clean slots between two dirty
+    ones as long as they hold a known value, rebinding those is cheaper
+    than a second call.
+==================================================================
+*/
+        template<typename t_, int count_>
+        class BindSlots
+        {
+        public:
+            BindSlots( void ) { Reset(); }
+
+            /// @brief Forget the bound state, at the start of a pass.
+            SDL_INLINE void Reset( void )
+            {
+                known = 0;
+                dirty = 0;
+            }
+
+            /// @return the number of slots dropped as identical to the bound ones.
+            SDL_INLINE Uint32 Set( const Uint32 first_slot, const t_ *values, const Uint32 num_values )
+            {
+                Uint32 redundant = 0;
+                for ( Uint32 i = 0; i < num_values && first_slot + i < ( Uint32 )count_; i++ )
+                {
+                    const Uint32 slot = first_slot + i;
+                    const Uint32 bit = 1u << slot;
+                    if ( ( known & bit ) != 0 && BindEqual( bound[slot], values[i] ) )
+                    {
+                        // also cancels an update pending since the last flush
+                        dirty &= ~bit;
+                        redundant++;
+                        continue;
+                    }
+                    pending[slot] = values[i];
+                    dirty |= bit;
+                }
+                return redundant;
+            }
+
+            SDL_INLINE bool IsDirty( void ) const { return dirty != 0; }
+
+            /// @brief Take the next range to bind, marking it bound.
+            SDL_INLINE bool NextRun( Uint32 &first_slot, Uint32 &num_slots, const t_ *&values )
+            {
+                if ( dirty == 0 )
+                    return false;
+
+                Uint32 first = 0;
+                while ( ( dirty & ( 1u << first ) ) == 0 )
+                    first++;
+
+                // extend over dirty or known slots, but end on a dirty one
+                Uint32 last = first;
+                for ( Uint32 slot = first + 1; slot < ( Uint32 )count_; slot++ )
+                {
+                    const Uint32 bit = 1u << slot;
+                    if ( ( dirty & bit ) != 0 )
+                        last = slot;
+                    else if ( ( known & bit ) == 0 )
+                        break;
+                }
+
+                for ( Uint32 slot = first; slot <= last; slot++ )
+                {
+                    const Uint32 bit = 1u << slot;
+                    if ( ( dirty & bit ) == 0 )
+                        pending[slot] = bound[slot];
+                    bound[slot] = pending[slot];
+                    known |= bit;
+                    dirty &= ~bit;
+                }
+
+                first_slot = first;
+                num_slots = last - first + 1;
+                values = &pending[first];
+                return true;
+            }
+
+        private:
+            t_      bound[count_];
+            t_      pending[count_];
+            Uint32  known;
+            Uint32  dirty;
+        };
+
+/*
+==================================================================
+RenderBindCache
+==================================================================
+    Shadows the state bound in a render pass so that binding the same
+    pipeline, buffers or textures again costs nothing. Binds are only
+    recorded, and sent to SDL by the draw calls of the cache ( or
+    Flush ): identical rebinds are dropped and the slots changed since
+    the last draw are bound with one ranged call per kind of binding,
+    so a material system may rebind everything before every draw.
+
+    The RenderPass wrappers are plain handles passed around by value,
+    so the shadow state lives here: Begin the cache on each render pass
+    and bind and draw through it. Viewport, scissor, blend constants and
+    stencil reference are deduplicated too. Binding through the pass
+    directly in between is not seen by the cache, call Invalidate after.
+
+    Example usage:
+        SDL::GPU::RenderBindCache binds;
+        binds.Begin( renderPass );
+        for ( int i = 0; i < numDraws; i++ )
+        {
+            binds.BindGraphicsPipeline( draws[i].pipeline );
+            binds.BindVertexBuffers( 0, &draws[i].vertices, 1 );
+            binds.BindIndexBuffer( &draws[i].indices, SDL_GPU_INDEXELEMENTSIZE_16BIT );
+            binds.BindFragmentSamplers( 0, draws[i].material->samplers, 4 );
+            binds.DrawIndexedPrimitives( draws[i].count, 1, 0, 0, 0 );
+        }
+        renderPass.End();
+        SDL::GPU::BindStats stats = binds.GetStats();
+==================================================================
+*/
+        class RenderBindCache
+        {
+        public:
+            static const int MAX_VERTEX_BUFFERS = 16;
+            static const int MAX_SAMPLERS = 16;
+            static const int MAX_STORAGE_TEXTURES = 8;
+            static const int MAX_STORAGE_BUFFERS = 8;
+
+            RenderBindCache( void ) : renderPass( nullptr )
+            {
+                Invalidate();
+                ResetStats();
+            }
+            ~RenderBindCache( void ) {}
+
+            /// @brief Start tracking a render pass, nothing is bound in it yet.
+            SDL_INLINE void Begin( const RenderPass &render_pass )
+            {
+                renderPass = render_pass.GetHandle();
+                Invalidate();
+            }
+
+            /// @brief Forget the bound state, after binding through the pass directly.
+            SDL_INLINE void Invalidate( void )
+            {
+                pipeline = nullptr;
+                pendingPipeline = nullptr;
+                hasIndexBuffer = false;
+                indexDirty = false;
+                hasViewport = false;
+                hasScissor = false;
+                hasBlendConstants = false;
+                hasStencilReference = false;
+                vertexBuffers.Reset();
+                vertexSamplers.Reset();
+                vertexStorageTextures.Reset();
+                vertexStorageBuffers.Reset();
+                fragmentSamplers.Reset();
+                fragmentStorageTextures.Reset();
+                fragmentStorageBuffers.Reset();
+            }
+
+            SDL_INLINE void BindGraphicsPipeline( const GraphicsPipeline &graphics_pipeline )
+            {
+                stats.calls++;
+                stats.slots++;
+                if ( graphics_pipeline.GetHandle() == pipeline )
+                    stats.redundantSlots++;
+                pendingPipeline = graphics_pipeline.GetHandle();
+            }
+
+            SDL_INLINE void BindVertexBuffers( const Uint32 first_slot, const SDL_GPUBufferBinding *bindings, const Uint32 num_bindings )
+            {
+                Record( vertexBuffers, first_slot, bindings, num_bindings );
+            }
+
+            SDL_INLINE void BindIndexBuffer( const SDL_GPUBufferBinding *binding, const SDL_GPUIndexElementSize index_element_size )
+            {
+                stats.calls++;
+                stats.slots++;
+                if ( hasIndexBuffer && BindEqual( indexBuffer, *binding ) && indexSize == index_element_size )
+                {
+                    stats.redundantSlots++;
+                    indexDirty = false;
+                    return;
+                }
+                pendingIndexBuffer = *binding;
+                pendingIndexSize = index_element_size;
+                indexDirty = true;
+            }
+
+            SDL_INLINE void BindVertexSamplers( const Uint32 first_slot, const SDL_GPUTextureSamplerBinding *texture_sampler_bindings, const Uint32 num_bindings )
+            {
+                Record( vertexSamplers, first_slot, texture_sampler_bindings, num_bindings );
+            }
+
+            SDL_INLINE void BindVertexStorageTextures( const Uint32 first_slot, SDL_GPUTexture *const *storage_textures, const Uint32 num_bindings )
+            {
+                Record( vertexStorageTextures, first_slot, storage_textures, num_bindings );
+            }
+
+            SDL_INLINE void BindVertexStorageBuffers( const Uint32 first_slot, SDL_GPUBuffer *const *storage_buffers, const Uint32 num_bindings )
+            {
+                Record( vertexStorageBuffers, first_slot, storage_buffers, num_bindings );
+            }
+
+            SDL_INLINE void BindFragmentSamplers( const Uint32 first_slot, const SDL_GPUTextureSamplerBinding *texture_sampler_bindings, const Uint32 num_bindings )
+            {
+                Record( fragmentSamplers, first_slot, texture_sampler_bindings, num_bindings );
+            }
+
+            SDL_INLINE void BindFragmentStorageTextures( const Uint32 first_slot, SDL_GPUTexture *const *storage_textures, const Uint32 num_bindings )
+            {
+                Record( fragmentStorageTextures, first_slot, storage_textures, num_bindings );
+            }
+
+            SDL_INLINE void BindFragmentStorageBuffers( const Uint32 first_slot, SDL_GPUBuffer *const *storage_buffers, const Uint32 num_bindings )
+            {
+                Record( fragmentStorageBuffers, first_slot, storage_buffers, num_bindings );
+            }
+
+            SDL_INLINE void SetViewport( const SDL_GPUViewport &viewport_ )
+            {
+                if ( hasViewport && SDL_memcmp( &viewport, &viewport_, sizeof( viewport ) ) == 0 )
+                    return;
+                viewport = viewport_;
+                hasViewport = true;
+                SDL_SetGPUViewport( renderPass, &viewport );
+            }
+
+            SDL_INLINE void SetScissor( const SDL_Rect &scissor_ )
+            {
+                if ( hasScissor && scissor.x == scissor_.x && scissor.y == scissor_.y && scissor.w == scissor_.w && scissor.h == scissor_.h )
+                    return;
+                scissor = scissor_;
+                hasScissor = true;
+                SDL_SetGPUScissor( renderPass, &scissor );
+            }
+
+            SDL_INLINE void SetBlendConstants( const SDL_FColor blend_constants )
+            {
+                if ( hasBlendConstants && blendConstants.r == blend_constants.r && blendConstants.g == blend_constants.g &&
+                     blendConstants.b == blend_constants.b && blendConstants.a == blend_constants.a )
+                    return;
+                blendConstants = blend_constants;
+                hasBlendConstants = true;
+                SDL_SetGPUBlendConstants( renderPass, blendConstants );
+            }
+
+            SDL_INLINE void SetStencilReference( const Uint8 stencil_reference )
+            {
+                if ( hasStencilReference && stencilReference == stencil_reference )
+                    return;
+                stencilReference = stencil_reference;
+                hasStencilReference = true;
+                SDL_SetGPUStencilReference( renderPass, stencilReference );
+            }
+
+            /// @brief Send the binds recorded since the last draw to SDL.
+            SDL_INLINE void Flush( void )
+            {
+                stats.flushes++;
+                if ( pendingPipeline != pipeline )
+                {
+                    pipeline = pendingPipeline;
+                    SDL_BindGPUGraphicsPipeline( renderPass, pipeline );
+                    stats.sdlCalls++;
+                    stats.sdlSlots++;
+                }
+                if ( indexDirty )
+                {
+                    indexBuffer = pendingIndexBuffer;
+                    indexSize = pendingIndexSize;
+                    hasIndexBuffer = true;
+                    indexDirty = false;
+                    SDL_BindGPUIndexBuffer( renderPass, &indexBuffer, indexSize );
+                    stats.sdlCalls++;
+                    stats.sdlSlots++;
+                }
+
+                Uint32 first, count;
+                const SDL_GPUBufferBinding *buffers;
+                while ( vertexBuffers.NextRun( first, count, buffers ) )
+                {
+                    SDL_BindGPUVertexBuffers( renderPass, first, buffers, count );
+                    Count( count );
+                }
+                const SDL_GPUTextureSamplerBinding *samplers;
+                while ( vertexSamplers.NextRun( first, count, samplers ) )
+                {
+                    SDL_BindGPUVertexSamplers( renderPass, first, samplers, count );
+                    Count( count );
+                }
+                while ( fragmentSamplers.NextRun( first, count, samplers ) )
+                {
+                    SDL_BindGPUFragmentSamplers( renderPass, first, samplers, count );
+                    Count( count );
+                }
+                SDL_GPUTexture *const *textures;
+                while ( vertexStorageTextures.NextRun( first, count, textures ) )
+                {
+                    SDL_BindGPUVertexStorageTextures( renderPass, first, textures, count );
+                    Count( count );
+                }
+                while ( fragmentStorageTextures.NextRun( first, count, textures ) )
+                {
+                    SDL_BindGPUFragmentStorageTextures( renderPass, first, textures, count );
+                    Count( count );
+                }
+                SDL_GPUBuffer *const *storage;
+                while ( vertexStorageBuffers.NextRun( first, count, storage ) )
+                {
+                    SDL_BindGPUVertexStorageBuffers( renderPass, first, storage, count );
+                    Count( count );
+                }
+                while ( fragmentStorageBuffers.NextRun( first, count, storage ) )
+                {
+                    SDL_BindGPUFragmentStorageBuffers( renderPass, first, storage, count );
+                    Count( count );
+                }
+            }
+
+            SDL_INLINE void DrawPrimitives( const Uint32 num_vertices, const Uint32 num_instances, const Uint32 first_vertex, const Uint32 first_instance )
+            {
+                Flush();
+                SDL_DrawGPUPrimitives( renderPass, num_vertices, num_instances, first_vertex, first_instance );
+            }
+
+            SDL_INLINE void DrawIndexedPrimitives( const Uint32 num_indices, const Uint32 num_instances, const Uint32 first_index, const Sint32 vertex_offset, const Uint32 first_instance )
+            {
+                Flush();
+                SDL_DrawGPUIndexedPrimitives( renderPass, num_indices, num_instances, first_index, vertex_offset, first_instance );
+            }
+
+            SDL_INLINE void DrawPrimitivesIndirect( SDL_GPUBuffer *buffer, const Uint32 offset, const Uint32 draw_count )
+            {
+                Flush();
+                SDL_DrawGPUPrimitivesIndirect( renderPass, buffer, offset, draw_count );
+            }
+
+            SDL_INLINE void DrawIndexedPrimitivesIndirect( SDL_GPUBuffer *buffer, const Uint32 offset, const Uint32 draw_count )
+            {
+                Flush();
+                SDL_DrawGPUIndexedPrimitivesIndirect( renderPass, buffer, offset, draw_count );
+            }
+
+            SDL_INLINE BindStats GetStats( void ) const { return stats; }
+            SDL_INLINE void ResetStats( void ) { SDL_zero( stats ); }
+
+        private:
+            RenderBindCache( const RenderBindCache & );
+            RenderBindCache &operator=( const RenderBindCache & );
+
+            template<typename t_, int count_>
+            SDL_INLINE void Record( BindSlots<t_, count_> &slots, const Uint32 first_slot, const t_ *values, const Uint32 num_values )
+            {
+                stats.calls++;
+                stats.slots += num_values;
+                stats.redundantSlots += slots.Set( first_slot, values, num_values );
+            }
+
+            SDL_INLINE void Count( const Uint32 num_slots )
+            {
+                stats.sdlCalls++;
+                stats.sdlSlots += num_slots;
+            }
+
+            SDL_GPURenderPass*                                      renderPass;
+            SDL_GPUGraphicsPipeline*                                pipeline;
+            SDL_GPUGraphicsPipeline*                                pendingPipeline;
+            SDL_GPUBufferBinding                                    indexBuffer;
+            SDL_GPUBufferBinding                                    pendingIndexBuffer;
+            SDL_GPUIndexElementSize                                 indexSize;
+            SDL_GPUIndexElementSize                                 pendingIndexSize;
+            bool                                                    hasIndexBuffer;
+            bool                                                    indexDirty;
+            BindSlots<SDL_GPUBufferBinding, MAX_VERTEX_BUFFERS>     vertexBuffers;
+            BindSlots<SDL_GPUTextureSamplerBinding, MAX_SAMPLERS>   vertexSamplers;
+            BindSlots<SDL_GPUTexture*, MAX_STORAGE_TEXTURES>        vertexStorageTextures;
+            BindSlots<SDL_GPUBuffer*, MAX_STORAGE_BUFFERS>          vertexStorageBuffers;
+            BindSlots<SDL_GPUTextureSamplerBinding, MAX_SAMPLERS>   fragmentSamplers;
+            BindSlots<SDL_GPUTexture*, MAX_STORAGE_TEXTURES>        fragmentStorageTextures;
+            BindSlots<SDL_GPUBuffer*, MAX_STORAGE_BUFFERS>          fragmentStorageBuffers;
+            SDL_GPUViewport                                         viewport;
+            SDL_Rect                                                scissor;
+            SDL_FColor                                              blendConstants;
+            Uint8                                                   stencilReference;
+            bool                                                    hasViewport;
+            bool                                                    hasScissor;
+            bool                                                    hasBlendConstants;
+            bool                                                    hasStencilReference;
+            BindStats                                               stats;
+        };
+
+/*
+==================================================================
+ComputeBindCache
+==================================================================
+    The RenderBindCache of compute passes: pipeline, samplers and read
+    only storage binds are recorded and sent by Dispatch, dropping
+    identical rebinds and coalescing adjacent slots.
+
+    Example usage:
+        SDL::GPU::ComputeBindCache binds;
+        binds.Begin( computePass );
+        binds.BindComputePipeline( cullPipeline );
+        binds.BindComputeStorageBuffers( 0, inputs, 2 );
+        binds.Dispatch( ( count + 63 ) / 64, 1, 1 );
+==================================================================
+*/
+        class ComputeBindCache
+        {
+        public:
+            static const int MAX_SAMPLERS = 16;
+            static const int MAX_STORAGE_TEXTURES = 8;
+            static const int MAX_STORAGE_BUFFERS = 8;
+
+            ComputeBindCache( void ) : computePass( nullptr )
+            {
+                Invalidate();
+                ResetStats();
+            }
+            ~ComputeBindCache( void ) {}
+
+            SDL_INLINE void Begin( const ComputePass &compute_pass )
+            {
+                computePass = compute_pass.GetHandle();
+                Invalidate();
+            }
+
+            SDL_INLINE void Invalidate( void )
+            {
+                pipeline = nullptr;
+                pendingPipeline = nullptr;
+                samplers.Reset();
+                storageTextures.Reset();
+                storageBuffers.Reset();
+            }
+
+            SDL_INLINE void BindComputePipeline( const ComputePipeline &compute_pipeline )
+            {
+                stats.calls++;
+                stats.slots++;
+                if ( compute_pipeline.GetHandle() == pipeline )
+                    stats.redundantSlots++;
+                pendingPipeline = compute_pipeline.GetHandle();
+            }
+
+            SDL_INLINE void BindComputeSamplers( const Uint32 first_slot, const SDL_GPUTextureSamplerBinding *texture_sampler_bindings, const Uint32 num_bindings )
+            {
+                Record( samplers, first_slot, texture_sampler_bindings, num_bindings );
+            }
+
+            SDL_INLINE void BindComputeStorageTextures( const Uint32 first_slot, SDL_GPUTexture *const *storage_textures, const Uint32 num_bindings )
+            {
+                Record( storageTextures, first_slot, storage_textures, num_bindings );
+            }
+
+            SDL_INLINE void BindComputeStorageBuffers( const Uint32 first_slot, SDL_GPUBuffer *const *storage_buffers, const Uint32 num_bindings )
+            {
+                Record( storageBuffers, first_slot, storage_buffers, num_bindings );
+            }
+
+            SDL_INLINE void Flush( void )
+            {
+                stats.flushes++;
+                if ( pendingPipeline != pipeline )
+                {
+                    pipeline = pendingPipeline;
+                    SDL_BindGPUComputePipeline( computePass, pipeline );
+                    Count( 1 );
+                }
+
+                Uint32 first, count;
+                const SDL_GPUTextureSamplerBinding *bindings;
+                while ( samplers.NextRun( first, count, bindings ) )
+                {
+                    SDL_BindGPUComputeSamplers( computePass, first, bindings, count );
+                    Count( count );
+                }
+                SDL_GPUTexture *const *textures;
+                while ( storageTextures.NextRun( first, count, textures ) )
+                {
+                    SDL_BindGPUComputeStorageTextures( computePass, first, textures, count );
+                    Count( count );
+                }
+                SDL_GPUBuffer *const *buffers;
+                while ( storageBuffers.NextRun( first, count, buffers ) )
+                {
+                    SDL_BindGPUComputeStorageBuffers( computePass, first, buffers, count );
+                    Count( count );
+                }
+            }
+
+            SDL_INLINE void Dispatch( const Uint32 groupcount_x, const Uint32 groupcount_y, const Uint32 groupcount_z )
+            {
+                Flush();
+                SDL_DispatchGPUCompute( computePass, groupcount_x, groupcount_y, groupcount_z );
+            }
+
+            SDL_INLINE void DispatchIndirect( SDL_GPUBuffer *buffer, const Uint32 offset )
+            {
+                Flush();
+                SDL_DispatchGPUComputeIndirect( computePass, buffer, offset );
+            }
+
+            SDL_INLINE BindStats GetStats( void ) const { return stats; }
+            SDL_INLINE void ResetStats( void ) { SDL_zero( stats ); }
+
+        private:
+            ComputeBindCache( const ComputeBindCache & );
+            ComputeBindCache &operator=( const ComputeBindCache & );
+
+            template<typename t_, int count_>
+            SDL_INLINE void Record( BindSlots<t_, count_> &slots, const Uint32 first_slot, const t_ *values, const Uint32 num_values )
+            {
+                stats.calls++;
+                stats.slots += num_values;
+                stats.redundantSlots += slots.Set( first_slot, values, num_values );
+            }
+
+            SDL_INLINE void Count( const Uint32 num_slots )
+            {
+                stats.sdlCalls++;
+                stats.sdlSlots += num_slots;
+            }
+
+            SDL_GPUComputePass*                                     computePass;
+            SDL_GPUComputePipeline*                                 pipeline;
+            SDL_GPUComputePipeline*                                 pendingPipeline;
+            BindSlots<SDL_GPUTextureSamplerBinding, MAX_SAMPLERS>   samplers;
+            BindSlots<SDL_GPUTexture*, MAX_STORAGE_TEXTURES>        storageTextures;
+            BindSlots<SDL_GPUBuffer*, MAX_STORAGE_BUFFERS>          storageBuffers;
+            BindStats                                               stats;
+        };
+    }
+}
+#endif //!__SDL_BIND_CACHE_HPP__
@@ -0,0 +1,801 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_BUFFER_HEAP_HPP__
+#define __SDL_BUFFER_HEAP_HPP__
+
+#include <SDL3/SDL_bits.h>
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+BufferHeap
+==================================================================
+    Packs many small vertex, index or storage ranges into a few large
+    GPU buffers, so meshes sharing a block can be bound with a single
+    vertex buffer binding and drawn with a first vertex / first index.
+
+    Blocks are created per usage flags on demand, each one is managed
+    by a TLSF allocator ( two level segregated fit, O(1) allocate and
+    free with immediate coalescing ). The allocator bookkeeping lives on
+    the CPU, the GPU memory is never touched by the heap.
+
+    Allocations are handles: Defragment moves ranges with
+    CopyPass::CopyBufferToBuffer, so query the binding of a handle when
+    recording, or after a defragment for the handles in GetMoved.
+    Like any other GPU resource, a range must not be freed while a
+    command buffer that is still in flight reads it.
+
+    Example usage:
+        SDL::GPU::BufferHeap heap;
+        heap.Create( device, 32 * 1024 * 1024 );
+        Uint32 mesh = heap.Allocate( SDL_GPU_BUFFERUSAGE_VERTEX, vertexBytes, 16 );
+        SDL_GPUBufferRegion region = heap.GetRegion( mesh );
+        copyPass.UploadToBuffer( &source, &region, false );
+        ...
+        SDL_GPUBufferBinding binding = heap.GetBinding( mesh );
+        renderPass.BindVertexBuffers( 0, &binding, 1 );
+        ...
+        // once in a while, in a copy pass of its own
+        heap.Defragment( copyPass, 4 * 1024 * 1024 );
+        ...
+        heap.Free( mesh );
+        heap.Release();
+==================================================================
+*/
+        class BufferHeap
+        {
+        public:
+            static const Uint32 MIN_ALIGNMENT = 16;
+
+            struct Stats
+            {
+                int     blocks;
+                Uint32  allocations;
+                Uint32  freeRanges;
+                Uint64  capacity;
+                Uint64  used;           // bytes in allocations, alignment padding included
+                Uint64  free;
+                Uint64  largestFree;
+                double  fragmentation;  // 1 - largestFree / free, 0 when all the free space is one range
+            };
+
+            BufferHeap( void ) : device( nullptr ), blockSize( 0 ), freeNodes( -1 ) {}
+            ~BufferHeap( void ) { Release(); }
+
+            /// @brief Prepare the heap, blocks are only created by Allocate.
+            /// @param device the device, it must outlive the heap.
+            /// @param block_size size of each block in bytes, larger requests get a block of their own size.
+            SDL_INLINE bool Create( const Device &_device, const Uint32 block_size )
+            {
+                Release();
+                if ( block_size < MIN_ALIGNMENT || block_size > MAX_BLOCK_SIZE )
+                    return SDL_SetError( "BufferHeap: invalid block size %u", block_size );
+
+                device = &_device;
+                blockSize = AlignUp( block_size, MIN_ALIGNMENT );
+                return true;
+            }
+
+            /// @brief Release every block, the handles become invalid.
+            SDL_INLINE void Release( void )
+            {
+                if ( device != nullptr )
+                {
+                    for ( int i = 0; i < blocks.Num(); i++ )
+                    {
+                        Buffer buffer( blocks[i].buffer );
+                        buffer.Release( *device );
+                    }
+                }
+
+                blocks.Free();
+                nodes.Free();
+                handles.Free();
+                freeHandles.Free();
+                moved.Free();
+                freeNodes = -1;
+                device = nullptr;
+            }
+
+            /// @brief Allocate size bytes from a block with the given usage.
+            /// @param alignment power of two, at least MIN_ALIGNMENT is used.
+            /// @return a handle, or 0 on failure; call SDL_GetError() for more information.
+            SDL_INLINE Uint32 Allocate( const SDL_GPUBufferUsageFlags usage, const Uint32 size, const Uint32 alignment = MIN_ALIGNMENT )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "BufferHeap: not created" );
+                    return 0;
+                }
+
+                const Uint32 align = alignment > MIN_ALIGNMENT ? alignment : MIN_ALIGNMENT;
+                if ( size == 0 || size > MAX_BLOCK_SIZE || ( align & ( align - 1 ) ) != 0 )
+                {
+                    SDL_SetError( "BufferHeap: invalid size %u or alignment %u", size, alignment );
+                    return 0;
+                }
+
+                int node = -1;
+                for ( int i = 0; i < blocks.Num() && node < 0; i++ )
+                {
+                    if ( blocks[i].buffer != nullptr && blocks[i].usage == usage )
+                        node = AllocateIn( i, size, align );
+                }
+
+                if ( node < 0 )
+                {
+                    const Uint64 need = ( Uint64 )AlignUp( size, MIN_ALIGNMENT ) + align;
+                    const int block = AddBlock( usage, need > blockSize ? AlignUp( ( Uint32 )SDL_min( need, ( Uint64 )MAX_BLOCK_SIZE ), MIN_ALIGNMENT ) : blockSize );
+                    if ( block < 0 )
+                        return 0;
+                    node = AllocateIn( block, size, align );
+                    if ( node < 0 )
+                    {
+                        SDL_SetError( "BufferHeap: allocation of %u bytes failed", size );
+                        return 0;
+                    }
+                }
+
+                Uint32 handle;
+                if ( !freeHandles.Empty() )
+                {
+                    handle = freeHandles.Last();
+                    freeHandles.Resize( freeHandles.Num() - 1 );
+                }
+                else
+                {
+                    if ( handles.Append( -1 ) == nullptr )
+                    {
+                        FreeNode( node );
+                        SDL_OutOfMemory();
+                        return 0;
+                    }
+                    handle = ( Uint32 )handles.Num();
+                }
+
+                handles[( int )handle - 1] = node;
+                nodes[node].handle = handle;
+                return handle;
+            }
+
+            SDL_INLINE void Free( const Uint32 handle )
+            {
+                const int node = NodeOf( handle );
+                if ( node < 0 )
+                    return;
+
+                FreeNode( node );
+                handles[( int )handle - 1] = -1;
+                freeHandles.Append( handle );
+            }
+
+            SDL_INLINE SDL_GPUBufferBinding GetBinding( const Uint32 handle ) const
+            {
+                SDL_GPUBufferBinding binding;
+                const int node = NodeOf( handle );
+                binding.buffer = node >= 0 ? blocks[nodes[node].block].buffer : nullptr;
+                binding.offset = node >= 0 ? nodes[node].offset : 0;
+                return binding;
+            }
+
+            SDL_INLINE SDL_GPUBufferRegion GetRegion( const Uint32 handle ) const
+            {
+                SDL_GPUBufferRegion region;
+                const int node = NodeOf( handle );
+                region.buffer = node >= 0 ? blocks[nodes[node].block].buffer : nullptr;
+                region.offset = node >= 0 ? nodes[node].offset : 0;
+                region.size = node >= 0 ? nodes[node].requested : 0;
+                return region;
+            }
+
+            SDL_INLINE SDL_GPUBufferLocation GetLocation( const Uint32 handle ) const
+            {
+                SDL_GPUBufferLocation location;
+                const int node = NodeOf( handle );
+                location.buffer = node >= 0 ? blocks[nodes[node].block].buffer : nullptr;
+                location.offset = node >= 0 ? nodes[node].offset : 0;
+                return location;
+            }
+
+            SDL_INLINE Buffer GetBuffer( const Uint32 handle ) const { return Buffer( GetBinding( handle ).buffer ); }
+
+            /// @brief Compact the heap: empty the least used blocks into the others, then slide ranges down into the free space before them.
+            /// @param copyPass a copy pass recorded before any pass that uses the new offsets.
+            /// @param max_bytes stop once this many bytes were copied.
+            /// @return the number of bytes copied, the moved handles are in GetMoved.
+            SDL_INLINE Uint64 Defragment( const CopyPass &copyPass, const Uint64 max_bytes )
+            {
+                moved.Clear();
+                Uint64 copied = 0;
+
+                // evacuate the emptiest block of a usage when the others can take its content
+                for ( int b = 0; b < blocks.Num() && copied < max_bytes; b++ )
+                {
+                    const int source = EmptiestBlock( blocks[b].usage );
+                    if ( source != b || blocks[b].buffer == nullptr || blocks[b].used == 0 )
+                        continue;
+
+                    Uint64 room = 0;
+                    for ( int i = 0; i < blocks.Num(); i++ )
+                    {
+                        if ( i != source && blocks[i].buffer != nullptr && blocks[i].usage == blocks[source].usage )
+                            room += blocks[i].size - blocks[i].used;
+                    }
+                    if ( room < ( Uint64 )blocks[source].used * 2 )
+                        continue;
+
+                    for ( int n = blocks[source].first; n >= 0 && copied < max_bytes; )
+                    {
+                        if ( nodes[n].free )
+                        {
+                            n = nodes[n].nextPhys;
+                            continue;
+                        }
+
+                        // the freed range is merged with its neighbours, carry on after the merged node
+                        const Uint32 size = nodes[n].size;
+                        const int merged = EvacuateNode( copyPass, n, source );
+                        if ( merged < 0 )
+                            break;
+                        copied += size;
+                        n = nodes[merged].nextPhys;
+                    }
+
+                    if ( blocks[source].used == 0 && CountBlocks( blocks[source].usage ) > 1 )
+                        DropBlock( source );
+                }
+
+                // slide every range down when the free range before it is large enough to hold it
+                for ( int b = 0; b < blocks.Num() && copied < max_bytes; b++ )
+                {
+                    for ( int n = blocks[b].buffer != nullptr ? blocks[b].first : -1; n >= 0 && copied < max_bytes; )
+                    {
+                        const int prev = nodes[n].prevPhys;
+                        if ( !nodes[n].free && prev >= 0 && nodes[prev].free && AlignUp( nodes[prev].offset, nodes[n].align ) + nodes[n].size <= nodes[n].offset )
+                        {
+                            const int to = SlideNode( copyPass, n );
+                            if ( to < 0 )
+                                return copied;
+                            copied += nodes[to].size;
+                            n = nodes[to].nextPhys;
+                        }
+                        else
+                            n = nodes[n].nextPhys;
+                    }
+                }
+
+                return copied;
+            }
+
+            /// @brief The handles moved by the last Defragment.
+            SDL_INLINE const Array<Uint32>& GetMoved( void ) const { return moved; }
+
+            /// @param usage 0 for every block, or the usage flags of the blocks to report
+            SDL_INLINE Stats GetStats( const SDL_GPUBufferUsageFlags usage = 0 ) const
+            {
+                Stats stats;
+                SDL_zero( stats );
+
+                for ( int b = 0; b < blocks.Num(); b++ )
+                {
+                    const Block &block = blocks[b];
+                    if ( block.buffer == nullptr || ( usage != 0 && block.usage != usage ) )
+                        continue;
+
+                    stats.blocks++;
+                    stats.capacity += block.size;
+                    stats.used += block.used;
+                    for ( int n = block.first; n >= 0; n = nodes[n].nextPhys )
+                    {
+                        if ( nodes[n].free )
+                        {
+                            stats.freeRanges++;
+                            if ( nodes[n].size > stats.largestFree )
+                                stats.largestFree = nodes[n].size;
+                        }
+                        else
+                            stats.allocations++;
+                    }
+                }
+
+                stats.free = stats.capacity - stats.used;
+                stats.fragmentation = stats.free > 0 ? 1.0 - ( double )stats.largestFree / ( double )stats.free : 0.0;
+                return stats;
+            }
+
+        private:
+            static const Uint32 MAX_BLOCK_SIZE = 0x80000000u;
+
+            // TLSF layout: sizes below SMALL_SIZE share the first level, every level is split in SL_COUNT lists
+            static const int    ALIGN_SHIFT = 4;
+            static const int    SL_BITS = 4;
+            static const int    SL_COUNT = 1 << SL_BITS;
+            static const int    FL_SHIFT = SL_BITS + ALIGN_SHIFT;
+            static const Uint32 SMALL_SIZE = 1u << FL_SHIFT;
+            static const int    FL_COUNT = 32 - FL_SHIFT + 1;
+
+            struct Node
+            {
+                Uint32  offset;
+                Uint32  size;
+                Uint32  requested;
+                Uint32  align;
+                int     block;
+                int     prevPhys;
+                int     nextPhys;
+                int     prevFree;   // also the free node pool link
+                int     nextFree;
+                Uint32  handle;
+                bool    free;
+            };
+
+            struct Block
+            {
+                SDL_GPUBuffer*          buffer;
+                SDL_GPUBufferUsageFlags usage;
+                Uint32                  size;
+                Uint32                  used;
+                int                     first;
+                Uint32                  flBitmap;
+                Uint32                  slBitmap[FL_COUNT];
+                int                     heads[FL_COUNT][SL_COUNT];
+            };
+
+            BufferHeap( const BufferHeap &ref );
+            BufferHeap& operator=( const BufferHeap &ref );
+
+            static SDL_INLINE Uint32 AlignUp( const Uint32 value, const Uint32 align )
+            {
+                return ( value + align - 1 ) & ~( align - 1 );
+            }
+
+            static SDL_INLINE int LowestBit( const Uint32 value )
+            {
+                return SDL_MostSignificantBitIndex32( value & ( ~value + 1 ) );
+            }
+
+            static SDL_INLINE void Mapping( const Uint32 size, int &fl, int &sl )
+            {
+                if ( size < SMALL_SIZE )
+                {
+                    fl = 0;
+                    sl = ( int )( size >> ALIGN_SHIFT );
+                }
+                else
+                {
+                    const int bit = SDL_MostSignificantBitIndex32( size );
+                    sl = ( int )( size >> ( bit - SL_BITS ) ) ^ SL_COUNT;
+                    fl = bit - FL_SHIFT + 1;
+                }
+            }
+
+            SDL_INLINE int NodeOf( const Uint32 handle ) const
+            {
+                return ( handle > 0 && ( int )handle <= handles.Num() ) ? handles[( int )handle - 1] : -1;
+            }
+
+            SDL_INLINE int NewNode( void )
+            {
+                if ( freeNodes >= 0 )
+                {
+                    const int node = freeNodes;
+                    freeNodes = nodes[node].prevFree;
+                    return node;
+                }
+
+                Node empty;
+                SDL_zero( empty );
+                return nodes.Append( empty ) != nullptr ? nodes.Num() - 1 : -1;
+            }
+
+            SDL_INLINE void DeleteNode( const int node )
+            {
+                nodes[node].prevFree = freeNodes;
+                freeNodes = node;
+            }
+
+            SDL_INLINE void InsertFree( const int node )
+            {
+                Node &n = nodes[node];
+                Block &block = blocks[n.block];
+                int fl, sl;
+                Mapping( n.size, fl, sl );
+
+                n.free = true;
+                n.prevFree = -1;
+                n.nextFree = block.heads[fl][sl];
+                if ( n.nextFree >= 0 )
+                    nodes[n.nextFree].prevFree = node;
+                block.heads[fl][sl] = node;
+                block.flBitmap |= 1u << fl;
+                block.slBitmap[fl] |= 1u << sl;
+            }
+
+            SDL_INLINE void RemoveFree( const int node )
+            {
+                Node &n = nodes[node];
+                Block &block = blocks[n.block];
+                int fl, sl;
+                Mapping( n.size, fl, sl );
+
+                if ( n.prevFree >= 0 )
+                    nodes[n.prevFree].nextFree = n.nextFree;
+                else
+                    block.heads[fl][sl] = n.nextFree;
+
+                if ( n.nextFree >= 0 )
+                    nodes[n.nextFree].prevFree = n.prevFree;
+
+                if ( block.heads[fl][sl] < 0 )
+                {
+                    block.slBitmap[fl] &= ~( 1u << sl );
+                    if ( block.slBitmap[fl] == 0 )
+                        block.flBitmap &= ~( 1u << fl );
+                }
+                n.free = false;
+            }
+
+            // a free node of at least size bytes, rounded up so any node of the list found fits
+            SDL_INLINE int FindFree( const int block, Uint32 size ) const
+            {
+                if ( size >= SMALL_SIZE )
+                {
+                    const Uint32 round = ( 1u << ( SDL_MostSignificantBitIndex32( size ) - SL_BITS ) ) - 1;
+                    if ( size > MAX_BLOCK_SIZE - round )
+                        return -1;
+                    size += round;
+                }
+
+                int fl, sl;
+                Mapping( size, fl, sl );
+                if ( fl >= FL_COUNT )
+                    return -1;
+
+                const Block &b = blocks[block];
+                Uint32 slMap = b.slBitmap[fl] & ( ~0u << sl );
+                if ( slMap == 0 )
+                {
+                    const Uint32 flMap = fl + 1 < 32 ? b.flBitmap & ( ~0u << ( fl + 1 ) ) : 0;
+                    if ( flMap == 0 )
+                        return -1;
+                    fl = LowestBit( flMap );
+                    slMap = b.slBitmap[fl];
+                }
+                return b.heads[fl][LowestBit( slMap )];
+            }
+
+            // split a node off the front or back of a node, the new node is linked physically and left used
+            SDL_INLINE int SplitNode( const int node, const Uint32 size, const bool front )
+            {
+                const int split = NewNode();
+                if ( split < 0 )
+                    return -1;
+
+                Node &n = nodes[node];
+                Node &s = nodes[split];
+                s.block = n.block;
+                s.size = size;
+                s.free = false;
+                s.handle = 0;
+                n.size -= size;
+
+                if ( front )
+                {
+                    s.offset = n.offset;
+                    n.offset += size;
+                    s.prevPhys = n.prevPhys;
+                    s.nextPhys = node;
+                    if ( n.prevPhys >= 0 )
+                        nodes[n.prevPhys].nextPhys = split;
+                    else
+                        blocks[n.block].first = split;
+                    n.prevPhys = split;
+                }
+                else
+                {
+                    s.offset = n.offset + n.size;
+                    s.prevPhys = node;
+                    s.nextPhys = n.nextPhys;
+                    if ( n.nextPhys >= 0 )
+                        nodes[n.nextPhys].prevPhys = split;
+                    n.nextPhys = split;
+                }
+                return split;
+            }
+
+            // carve [offset, offset + size) out of a free node, the padding around it goes back to the free lists
+            SDL_INLINE int Carve( const int node, const Uint32 offset, const Uint32 size, const Uint32 requested, const Uint32 align )
+            {
+                RemoveFree( node );
+
+                const Uint32 pad = offset - nodes[node].offset;
+                if ( pad > 0 )
+                {
+                    const int front = SplitNode( node, pad, true );
+                    if ( front < 0 )
+                    {
+                        InsertFree( node );
+                        return -1;
+                    }
+                    InsertFree( front );
+                }
+
+                const Uint32 rest = nodes[node].size - size;
+                if ( rest >= MIN_ALIGNMENT )
+                {
+                    const int back = SplitNode( node, rest, false );
+                    if ( back >= 0 )
+                        InsertFree( back );
+                }
+
+                Node &n = nodes[node];
+                n.requested = requested;
+                n.align = align;
+                blocks[n.block].used += n.size;
+                return node;
+            }
+
+            SDL_INLINE int AllocateIn( const int block, const Uint32 requested, const Uint32 align )
+            {
+                const Uint32 size = AlignUp( requested, MIN_ALIGNMENT );
+                const int node = FindFree( block, size + ( align - MIN_ALIGNMENT ) );
+                if ( node < 0 )
+                    return -1;
+                return Carve( node, AlignUp( nodes[node].offset, align ), size, requested, align );
+            }
+
+            // back to the free lists, merged with the free neighbours
+            SDL_INLINE int FreeNode( int node )
+            {
+                blocks[nodes[node].block].used -= nodes[node].size;
+                nodes[node].handle = 0;
+
+                const int prev = nodes[node].prevPhys;
+                if ( prev >= 0 && nodes[prev].free )
+                {
+                    RemoveFree( prev );
+                    nodes[prev].size += nodes[node].size;
+                    nodes[prev].nextPhys = nodes[node].nextPhys;
+                    if ( nodes[node].nextPhys >= 0 )
+                        nodes[nodes[node].nextPhys].prevPhys = prev;
+                    DeleteNode( node );
+                    node = prev;
+                }
+
+                const int next = nodes[node].nextPhys;
+                if ( next >= 0 && nodes[next].free )
+                {
+                    RemoveFree( next );
+                    nodes[node].size += nodes[next].size;
+                    nodes[node].nextPhys = nodes[next].nextPhys;
+                    if ( nodes[next].nextPhys >= 0 )
+                        nodes[nodes[next].nextPhys].prevPhys = node;
+                    DeleteNode( next );
+                }
+
+                InsertFree( node );
+                return node;
+            }
+
+            SDL_INLINE int AddBlock( const SDL_GPUBufferUsageFlags usage, const Uint32 size )
+            {
+                SDL_GPUBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = usage;
+                info.size = size;
+
+                Buffer buffer;
+                if ( !buffer.Create( *device, &info ) )
+                    return -1;
+
+                // the node first, so a failure never leaves a block slot half set up
+                const int node = NewNode();
+                if ( node < 0 )
+                {
+                    buffer.Release( *device );
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+
+                // reuse the slot of a dropped block
+                int index = -1;
+                for ( int i = 0; i < blocks.Num() && index < 0; i++ )
+                {
+                    if ( blocks[i].buffer == nullptr )
+                        index = i;
+                }
+
+                if ( index < 0 )
+                {
+                    Block empty;
+                    SDL_zero( empty );
+                    if ( blocks.Append( empty ) == nullptr )
+                    {
+                        DeleteNode( node );
+                        buffer.Release( *device );
+                        SDL_OutOfMemory();
+                        return -1;
+                    }
+                    index = blocks.Num() - 1;
+                }
+
+                Block &block = blocks[index];
+                block.buffer = buffer;
+                block.usage = usage;
+                block.size = size;
+                block.used = 0;
+                block.first = node;
+                block.flBitmap = 0;
+                SDL_zeroa( block.slBitmap );
+                for ( int fl = 0; fl < FL_COUNT; fl++ )
+                {
+                    for ( int sl = 0; sl < SL_COUNT; sl++ )
+                        block.heads[fl][sl] = -1;
+                }
+
+                Node &n = nodes[node];
+                n.offset = 0;
+                n.size = size;
+                n.block = index;
+                n.prevPhys = -1;
+                n.nextPhys = -1;
+                n.handle = 0;
+                InsertFree( node );
+                return index;
+            }
+
+            SDL_INLINE void DropBlock( const int index )
+            {
+                Block &block = blocks[index];
+                for ( int n = block.first; n >= 0; )
+                {
+                    const int next = nodes[n].nextPhys;
+                    DeleteNode( n );
+                    n = next;
+                }
+
+                Buffer buffer( block.buffer );
+                buffer.Release( *device );
+                block.buffer = nullptr;
+                block.first = -1;
+            }
+
+            SDL_INLINE int EmptiestBlock( const SDL_GPUBufferUsageFlags usage ) const
+            {
+                int best = -1;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].buffer == nullptr || blocks[i].usage != usage )
+                        continue;
+                    if ( best < 0 || ( double )blocks[i].used / blocks[i].size < ( double )blocks[best].used / blocks[best].size )
+                        best = i;
+                }
+                return best;
+            }
+
+            SDL_INLINE int CountBlocks( const SDL_GPUBufferUsageFlags usage ) const
+            {
+                int count = 0;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].buffer != nullptr && blocks[i].usage == usage )
+                        count++;
+                }
+                return count;
+            }
+
+            SDL_INLINE void Copy( const CopyPass &copyPass, const int fromBlock, const Uint32 fromOffset, const int toBlock, const Uint32 toOffset, const Uint32 size ) const
+            {
+                SDL_GPUBufferLocation source;
+                source.buffer = blocks[fromBlock].buffer;
+                source.offset = fromOffset;
+                SDL_GPUBufferLocation destination;
+                destination.buffer = blocks[toBlock].buffer;
+                destination.offset = toOffset;
+                copyPass.CopyBufferToBuffer( &source, &destination, size, false );
+            }
+
+            // move a used node into another block of the same usage, returns the free node left behind
+            SDL_INLINE int EvacuateNode( const CopyPass &copyPass, const int node, const int source )
+            {
+                const Uint32 requested = nodes[node].requested;
+                const Uint32 align = nodes[node].align;
+
+                int to = -1;
+                for ( int i = 0; i < blocks.Num() && to < 0; i++ )
+                {
+                    if ( i != source && blocks[i].buffer != nullptr && blocks[i].usage == blocks[source].usage )
+                        to = AllocateIn( i, requested, align );
+                }
+                if ( to < 0 )
+                    return -1;
+
+                const Uint32 handle = nodes[node].handle;
+                Copy( copyPass, source, nodes[node].offset, nodes[to].block, nodes[to].offset, nodes[to].size );
+                nodes[to].handle = handle;
+                handles[( int )handle - 1] = to;
+                moved.Append( handle );
+                return FreeNode( node );
+            }
+
+            // move a used node to the start of the free node before it, the two ranges do not overlap
+            // returns -1 and leaves the node in place when there is no memory for the split nodes
+            SDL_INLINE int SlideNode( const CopyPass &copyPass, const int node )
+            {
+                // carving splits off at most two nodes, have room for them before freeing the range
+                if ( !nodes.Reserve( nodes.Num() + 2 ) )
+                    return -1;
+
+                const Uint32 handle = nodes[node].handle;
+                const Uint32 from = nodes[node].offset;
+                const Uint32 size = nodes[node].size;
+                const Uint32 requested = nodes[node].requested;
+                const Uint32 align = nodes[node].align;
+                const int block = nodes[node].block;
+
+                const int merged = FreeNode( node );
+                const int to = Carve( merged, AlignUp( nodes[merged].offset, align ), size, requested, align );
+                if ( to < 0 )
+                {
+                    // out of nodes, put it back where it was
+                    const int back = Carve( merged, from, size, requested, align );
+                    if ( back < 0 )
+                    {
+                        handles[( int )handle - 1] = -1;
+                        return -1;
+                    }
+                    nodes[back].handle = handle;
+                    handles[( int )handle - 1] = back;
+                    return back;
+                }
+
+                Copy( copyPass, block, from, block, nodes[to].offset, size );
+                nodes[to].handle = handle;
+                handles[( int )handle - 1] = to;
+                moved.Append( handle );
+                return to;
+            }
+
+            const Device*   device;
+            Uint32          blockSize;
+            int             freeNodes;
+            Array<Block>    blocks;
+            Array<Node>     nodes;
+            Array<int>      handles;
+            Array<Uint32>   freeHandles;
+            Array<Uint32>   moved;
+        };
+    };
+};
+
+#endif //!__SDL_BUFFER_HEAP_HPP__
@@ -0,0 +1,79 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_BYTES_HPP__
+#define __SDL_BYTES_HPP__
+
+#include <SDL3/SDL_stdinc.h>
+#include "SDL_array.hpp"
+
+namespace SDL
+{
+    // little endian writers for the binary files, an append that fails leaves the array short
+
+    SDL_INLINE void PutU8( Array<Uint8> &out, const Uint8 value ) { out.Append( value ); }
+
+    SDL_INLINE void PutU16( Array<Uint8> &out, const Uint16 value )
+    {
+        PutU8( out, ( Uint8 )value );
+        PutU8( out, ( Uint8 )( value >> 8 ) );
+    }
+
+    SDL_INLINE void PutU32( Array<Uint8> &out, const Uint32 value )
+    {
+        Uint8 *dst = out.AppendUninitialized( 4 );
+        if ( dst == nullptr )
+            return;
+        dst[0] = ( Uint8 )value;
+        dst[1] = ( Uint8 )( value >> 8 );
+        dst[2] = ( Uint8 )( value >> 16 );
+        dst[3] = ( Uint8 )( value >> 24 );
+    }
+
+    SDL_INLINE void PutU64( Array<Uint8> &out, const Uint64 value )
+    {
+        PutU32( out, ( Uint32 )value );
+        PutU32( out, ( Uint32 )( value >> 32 ) );
+    }
+
+    SDL_INLINE void PutF32( Array<Uint8> &out, const float value )
+    {
+        Uint32 bits;
+        SDL_memcpy( &bits, &value, sizeof( bits ) );
+        PutU32( out, bits );
+    }
+
+    SDL_INLINE void PutBytes( Array<Uint8> &out, const void *data, const Uint32 size )
+    {
+        if ( size == 0 )
+            return;
+        Uint8 *dst = out.AppendUninitialized( ( int )size );
+        if ( dst != nullptr )
+            SDL_memcpy( dst, data, size );
+    }
+}
+
+#endif //!__SDL_BYTES_HPP__
@@ -0,0 +1,455 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_COMMAND_RECORDER_HPP__
+#define __SDL_COMMAND_RECORDER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_mutex.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+CommandRecorder
+==================================================================
+    Records the command buffers of a frame on a pool of worker
+    threads and submits them in a fixed order. Each task of the frame
+    records its slice ( a range of draws, the shadow passes, a compute
+    pass, ... ) into its own command buffer with its callback; Execute
+    acquires the command buffers on the calling thread, runs the tasks
+    on the workers and on the calling thread, and submits ( or cancels )
+    each command buffer from the calling thread as soon as it and every
+    command buffer ordered before it are recorded, so a command buffer
+    is only acquired and submitted on the thread calling Execute.
+
+    The order is the order the tasks were added in, except that a task
+    given a dependency is submitted after it ( the GPU runs command
+    buffers in submission order ), so the result does not depend on
+    which thread finished first. Tasks flagged TASK_MAIN_THREAD, those
+    acquiring the swapchain texture, run on the thread calling Execute.
+
+    A callback returning false has its command buffer canceled, the
+    other command buffers are still submitted. Tasks are cleared by
+    Execute, the callbacks must not add tasks.
+
+    Example usage:
+        SDL::GPU::CommandRecorder recorder;
+        recorder.Create( device );
+        ...
+        int shadows = recorder.AddTask( "shadows", RecordShadows, &scene );
+        for ( int i = 0; i < numSlices; i++ )
+            recorder.AddTask( "opaque", RecordSlice, &slices[i] );
+        int present = recorder.AddTask( "present", RecordPresent, &scene, SDL::GPU::CommandRecorder::TASK_MAIN_THREAD );
+        SDL_GPUFence *fence = nullptr;
+        recorder.Execute( &fence );
+        ...
+        static bool SDLCALL RecordSlice( void *userdata, const SDL::GPU::CommandBuffer &commandBuffer )
+        {
+            Slice *slice = static_cast<Slice*>( userdata );
+            SDL::GPU::RenderPass pass;
+            if ( !pass.Begin( commandBuffer, &slice->target, 1, &slice->depth ) )
+                return false;
+            ...
+            pass.End();
+            return true;
+        }
+==================================================================
+*/
+        class CommandRecorder
+        {
+        public:
+            static const int MAX_THREADS = 8;
+
+            enum
+            {
+                TASK_MAIN_THREAD = 1 << 0
+            };
+
+            /// @return false to cancel the command buffer.
+            typedef bool ( SDLCALL *RecordCallback )( void *userdata, const CommandBuffer &commandBuffer );
+
+            struct Stats
+            {
+                int     threads;
+                int     tasks;          // in the last Execute
+                int     failed;
+                double  recordMS;       // summed over every task, all threads
+                double  maxRecordMS;    // slowest task
+                double  executeMS;      // wall time of the last Execute
+            };
+
+            CommandRecorder( void ) : device( nullptr ), quit( false ), queueHead( 0 )
+            {
+                SDL_zero( stats );
+            }
+            ~CommandRecorder( void ) { Destroy(); }
+
+            /// @brief Start the workers.
+            /// @param num_threads worker count, 0 for one less than the logical cores ( at most MAX_THREADS ), the calling thread records too.
+            SDL_INLINE bool Create( const Device &gpu_device, int num_threads = 0 )
+            {
+                if ( device != nullptr )
+                    return SDL_SetError( "CommandRecorder already created" );
+
+                if ( num_threads <= 0 )
+                    num_threads = SDL_GetNumLogicalCPUCores() - 1;
+                num_threads = SDL_clamp( num_threads, 0, MAX_THREADS );
+
+                if ( !mutex.Create() )
+                    return false;
+                if ( !work.Create() || !done.Create() )
+                {
+                    work.Destroy();
+                    mutex.Destroy();
+                    return false;
+                }
+
+                device = &gpu_device;
+                quit = false;
+                for ( int i = 0; i < num_threads; i++ )
+                {
+                    SDL_Thread *thread = SDL_CreateThread( WorkerMain, "SDL_CommandRecorder", this );
+                    if ( thread == nullptr )
+                    {
+                        Destroy();
+                        return false;
+                    }
+                    if ( threads.Append( thread ) == nullptr )
+                    {
+                        // not tracked, stop and join it here before the others
+                        mutex.Lock();
+                        quit = true;
+                        work.Broadcast();
+                        mutex.Unlock();
+                        SDL_WaitThread( thread, nullptr );
+                        Destroy();
+                        return SDL_OutOfMemory();
+                    }
+                }
+                stats.threads = threads.Num() + 1;
+                return true;
+            }
+
+            /// @brief Stop the workers, the tasks not executed are dropped.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                mutex.Lock();
+                quit = true;
+                work.Broadcast();
+                mutex.Unlock();
+                for ( int i = 0; i < threads.Num(); i++ )
+                    SDL_WaitThread( threads[i], nullptr );
+
+                threads.Free();
+                tasks.Free();
+                edges.Free();
+                order.Free();
+                queue.Free();
+                SDL_zero( stats );
+
+                done.Destroy();
+                work.Destroy();
+                mutex.Destroy();
+                device = nullptr;
+            }
+
+            /// @brief Add a task to the next Execute.
+            /// @param name for debugging, not copied.
+            /// @return the task index, or -1 on failure.
+            SDL_INLINE int AddTask( const char *name, RecordCallback callback, void *userdata = nullptr, const Uint32 flags = 0 )
+            {
+                if ( callback == nullptr )
+                {
+                    SDL_SetError( "CommandRecorder: null callback" );
+                    return -1;
+                }
+                Task *task = tasks.AppendUninitialized( 1 );
+                if ( task == nullptr )
+                {
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+                SDL_zerop( task );
+                task->name = name;
+                task->callback = callback;
+                task->userdata = userdata;
+                task->flags = flags;
+                return tasks.Num() - 1;
+            }
+
+            /// @brief Submit task after dependency, whatever the order they were added in.
+            SDL_INLINE bool AddDependency( const int task, const int dependency )
+            {
+                if ( task < 0 || task >= tasks.Num() || dependency < 0 || dependency >= tasks.Num() || task == dependency )
+                    return SDL_SetError( "CommandRecorder: invalid dependency %d -> %d", dependency, task );
+
+                Edge edge;
+                edge.from = dependency;
+                edge.to = task;
+                if ( edges.Append( edge ) == nullptr )
+                    return SDL_OutOfMemory();
+                return true;
+            }
+
+            /// @brief Record every task and submit the command buffers in order, then clear the tasks.
+            /// @param fence if not null, receives the fence of the last command buffer ( the caller releases it ),
+            ///        it signals once every command buffer of the frame is done.
+            /// @return false if a task failed or the order has a cycle ( nothing is recorded then ).
+            SDL_INLINE bool Execute( SDL_GPUFence **fence = nullptr )
+            {
+                if ( fence != nullptr )
+                    *fence = nullptr;
+                if ( device == nullptr )
+                    return SDL_SetError( "CommandRecorder: not created" );
+
+                const Uint64 start = SDL_GetPerformanceCounter();
+                stats.tasks = tasks.Num();
+                stats.failed = 0;
+                stats.recordMS = 0.0;
+                stats.maxRecordMS = 0.0;
+
+                if ( !Order() )
+                {
+                    Clear();
+                    return false;
+                }
+
+                mutex.Lock();
+                queueHead = 0;
+                for ( int i = 0; i < order.Num(); i++ )
+                {
+                    Task &task = tasks[order[i]];
+                    // acquired in submission order, the workers only record into them
+                    task.commandBuffer = SDL_AcquireGPUCommandBuffer( *device );
+                    if ( task.commandBuffer == nullptr )
+                    {
+                        task.done = true;
+                        continue;
+                    }
+                    // a task that can not be queued is recorded here when its turn comes
+                    task.queued = ( task.flags & TASK_MAIN_THREAD ) == 0 && queue.Append( order[i] ) != nullptr;
+                }
+                work.Broadcast();
+
+                // submit in order, recording whatever is next meanwhile
+                SDL_GPUCommandBuffer *held = nullptr;
+                for ( int i = 0; i < order.Num(); i++ )
+                {
+                    const int index = order[i];
+                    while ( !tasks[index].done )
+                    {
+                        int next = -1;
+                        if ( !tasks[index].queued )
+                            next = index;
+                        else if ( queueHead < queue.Num() )
+                            next = queue[queueHead++];
+
+                        if ( next >= 0 )
+                        {
+                            mutex.Unlock();
+                            Record( next );
+                            mutex.Lock();
+                        }
+                        else
+                        {
+                            done.Wait( mutex );
+                        }
+                    }
+
+                    Task &task = tasks[index];
+                    if ( task.commandBuffer == nullptr )
+                        continue;
+                    if ( !task.succeeded )
+                    {
+                        SDL_CancelGPUCommandBuffer( task.commandBuffer );
+                        continue;
+                    }
+                    // one command buffer is held back, the last one may have to give the fence
+                    if ( held != nullptr )
+                        SDL_SubmitGPUCommandBuffer( held );
+                    held = task.commandBuffer;
+                }
+                mutex.Unlock();
+
+                if ( held != nullptr )
+                {
+                    if ( fence != nullptr )
+                        *fence = SDL_SubmitGPUCommandBufferAndAcquireFence( held );
+                    else
+                        SDL_SubmitGPUCommandBuffer( held );
+                }
+
+                for ( int i = 0; i < tasks.Num(); i++ )
+                {
+                    const Task &task = tasks[i];
+                    if ( !task.succeeded )
+                        stats.failed++;
+                    stats.recordMS += task.ms;
+                    stats.maxRecordMS = SDL_max( stats.maxRecordMS, task.ms );
+                }
+                stats.executeMS = ( double )( SDL_GetPerformanceCounter() - start ) * 1000.0 / ( double )SDL_GetPerformanceFrequency();
+
+                const bool succeeded = stats.failed == 0;
+                Clear();
+                return succeeded ? true : SDL_SetError( "CommandRecorder: %d task(s) failed", stats.failed );
+            }
+
+            /// @brief Drop the tasks added since the last Execute.
+            SDL_INLINE void Clear( void )
+            {
+                mutex.Lock();
+                tasks.Clear();
+                edges.Clear();
+                order.Clear();
+                queue.Clear();
+                queueHead = 0;
+                mutex.Unlock();
+            }
+
+            SDL_INLINE Stats GetStats( void ) const { return stats; }
+
+        private:
+            CommandRecorder( const CommandRecorder & );
+            CommandRecorder &operator=( const CommandRecorder & );
+
+            struct Task
+            {
+                const char*             name;
+                RecordCallback          callback;
+                void*                   userdata;
+                Uint32                  flags;
+                SDL_GPUCommandBuffer*   commandBuffer;
+                double                  ms;
+                bool                    queued;
+                bool                    succeeded;
+                bool                    done;
+            };
+
+            struct Edge
+            {
+                int     from;
+                int     to;
+            };
+
+            // stable topological order, the lowest index first among the ready tasks
+            SDL_INLINE bool Order( void )
+            {
+                const int numTasks = tasks.Num();
+                Array<int> pending;
+                if ( !pending.Resize( numTasks ) || !order.Resize( 0 ) )
+                    return SDL_OutOfMemory();
+                for ( int i = 0; i < numTasks; i++ )
+                    pending[i] = 0;
+                for ( int i = 0; i < edges.Num(); i++ )
+                    pending[edges[i].to]++;
+
+                while ( order.Num() < numTasks )
+                {
+                    int pick = -1;
+                    for ( int i = 0; i < numTasks; i++ )
+                    {
+                        if ( pending[i] == 0 )
+                        {
+                            pick = i;
+                            break;
+                        }
+                    }
+                    if ( pick < 0 )
+                        return SDL_SetError( "CommandRecorder: dependency cycle" );
+
+                    pending[pick] = -1;
+                    if ( order.Append( pick ) == nullptr )
+                        return SDL_OutOfMemory();
+                    for ( int i = 0; i < edges.Num(); i++ )
+                    {
+                        if ( edges[i].from == pick )
+                            pending[edges[i].to]--;
+                    }
+                }
+                return true;
+            }
+
+            // called without the lock, the task array does not change during Execute
+            SDL_INLINE void Record( const int index )
+            {
+                Task &task = tasks[index];
+                const Uint64 start = SDL_GetPerformanceCounter();
+                const CommandBuffer commandBuffer( task.commandBuffer );
+                const bool succeeded = task.callback( task.userdata, commandBuffer );
+                const double ms = ( double )( SDL_GetPerformanceCounter() - start ) * 1000.0 / ( double )SDL_GetPerformanceFrequency();
+
+                mutex.Lock();
+                task.succeeded = succeeded;
+                task.ms = ms;
+                task.done = true;
+                done.Broadcast();
+                mutex.Unlock();
+            }
+
+            static int SDLCALL WorkerMain( void *data )
+            {
+                CommandRecorder *recorder = static_cast<CommandRecorder*>( data );
+                recorder->mutex.Lock();
+                for ( ;; )
+                {
+                    while ( !recorder->quit && recorder->queueHead >= recorder->queue.Num() )
+                        recorder->work.Wait( recorder->mutex );
+                    if ( recorder->quit )
+                        break;
+
+                    const int index = recorder->queue[recorder->queueHead++];
+                    recorder->mutex.Unlock();
+                    recorder->Record( index );
+                    recorder->mutex.Lock();
+                }
+                recorder->mutex.Unlock();
+                return 0;
+            }
+
+            const Device*           device;
+            mutable Mutex           mutex;
+            Condition               work;           // broadcast when Execute queues the tasks
+            Condition               done;           // broadcast when a task is recorded
+            Array<SDL_Thread*>      threads;
+            Array<Task>             tasks;
+            Array<Edge>             edges;
+            Array<int>              order;          // submission order
+            Array<int>              queue;          // tasks for any thread, in submission order
+            bool                    quit;
+            int                     queueHead;
+            Stats                   stats;
+        };
+    }
+}
+#endif //!__SDL_COMMAND_RECORDER_HPP__
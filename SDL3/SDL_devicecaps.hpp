@@ -0,0 +1,403 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_DEVICE_CAPS_HPP__
+#define __SDL_DEVICE_CAPS_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_bytes.hpp"
+#include "SDL_hashmap.hpp"
+#include "SDL_mutex.hpp"
+#include "SDL_iostream.hpp"
+#include "SDL_window.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+DeviceCaps
+==================================================================
+    Answers the format, sample count, present mode and swapchain
+    composition queries of a device from memory. Each distinct query
+    goes to the driver once, its answer is kept in a table.
+
+    BestFormat picks, among candidate formats, the supported one
+    taking the least memory per texel ( block compressed formats
+    counted per texel ), the earlier candidate on ties.
+
+    Save writes the format and sample count answers, tagged with the
+    driver name and shader formats of the device, and Load reads them
+    back on the next startup so those queries are not probed again.
+    A table saved by another driver is rejected; a driver or GPU
+    change with the same driver name is not detected, so version the
+    file with the application's own settings. Window answers depend
+    on the display the window is on, they are never saved, and
+    InvalidateWindow forgets them ( e.g. when the window moves to
+    another display ).
+
+    Every method is thread safe.
+
+    Example usage:
+        SDL::GPU::DeviceCaps caps;
+        caps.Create( device );
+        caps.Load( "caps.bin" );
+        ...
+        const SDL_GPUTextureFormat formats[] = { SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM, SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM };
+        SDL_GPUTextureFormat format = caps.BestFormat( formats, 2, SDL_GPU_TEXTURETYPE_2D, SDL_GPU_TEXTUREUSAGE_SAMPLER );
+        ...
+        caps.Save( "caps.bin" );
+==================================================================
+*/
+        class DeviceCaps
+        {
+        public:
+            static const Uint32 FILE_MAGIC = 0x43443353;    // 'S3DC'
+            static const Uint16 FILE_VERSION = 1;
+
+            struct Stats
+            {
+                Uint64  queries;
+                Uint64  driverQueries;  // queries not answered from the table
+                int     entries;
+                int     loaded;         // entries read by the last Load
+            };
+
+            DeviceCaps( void ) : device( nullptr ), shaderFormats( 0 )
+            {
+                SDL_zero( stats );
+            }
+            ~DeviceCaps( void ) { Destroy(); }
+
+            SDL_INLINE bool Create( const Device &gpu_device )
+            {
+                if ( device != nullptr )
+                    return SDL_SetError( "DeviceCaps already created" );
+
+                if ( !mutex.Create() )
+                    return false;
+                device = &gpu_device;
+                shaderFormats = device->GetShaderFormats();
+                const char *name = device->GetDriver();
+                driver.Clear();
+                if ( name != nullptr )
+                    PutBytes( driver, name, ( Uint32 )SDL_strlen( name ) );
+                return true;
+            }
+
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                answers.Free();
+                driver.Free();
+                SDL_zero( stats );
+                mutex.Destroy();
+                device = nullptr;
+            }
+
+            SDL_INLINE bool TextureSupportsFormat( const SDL_GPUTextureFormat format, const SDL_GPUTextureType type, const SDL_GPUTextureUsageFlags usage )
+            {
+                const Uint64 key = MakeKey( QUERY_FORMAT, ( Uint32 )format, ( ( Uint32 )type << 24 ) | ( usage & 0xffffff ) );
+                return Query( key, QUERY_FORMAT, format, type, usage, nullptr, 0 );
+            }
+
+            SDL_INLINE bool TextureSupportsSampleCount( const SDL_GPUTextureFormat format, const SDL_GPUSampleCount sample_count )
+            {
+                const Uint64 key = MakeKey( QUERY_SAMPLE_COUNT, ( Uint32 )format, ( Uint32 )sample_count );
+                return Query( key, QUERY_SAMPLE_COUNT, format, SDL_GPU_TEXTURETYPE_2D, 0, nullptr, ( Uint32 )sample_count );
+            }
+
+            SDL_INLINE bool WindowSupportsPresentMode( const Window &window, const SDL_GPUPresentMode present_mode )
+            {
+                const Uint64 key = MakeWindowKey( QUERY_PRESENT_MODE, window.GetID(), ( Uint32 )present_mode );
+                return Query( key, QUERY_PRESENT_MODE, SDL_GPU_TEXTUREFORMAT_INVALID, SDL_GPU_TEXTURETYPE_2D, 0, window, ( Uint32 )present_mode );
+            }
+
+            SDL_INLINE bool WindowSupportsSwapchainComposition( const Window &window, const SDL_GPUSwapchainComposition composition )
+            {
+                const Uint64 key = MakeWindowKey( QUERY_COMPOSITION, window.GetID(), ( Uint32 )composition );
+                return Query( key, QUERY_COMPOSITION, SDL_GPU_TEXTUREFORMAT_INVALID, SDL_GPU_TEXTURETYPE_2D, 0, window, ( Uint32 )composition );
+            }
+
+            /// @brief Forget the answers for a window, the next queries go to the driver.
+            SDL_INLINE void InvalidateWindow( const Window &window )
+            {
+                const Uint64 id = window.GetID();
+                mutex.Lock();
+                for ( Uint32 i = 0; i < answers.Capacity(); )
+                {
+                    if ( answers.IsUsed( i ) )
+                    {
+                        const Uint64 key = answers.KeyAt( i );
+                        const Uint8 kind = ( Uint8 )( key >> 56 );
+                        if ( ( kind == QUERY_PRESENT_MODE || kind == QUERY_COMPOSITION ) && ( ( key >> 16 ) & 0xffffffff ) == id )
+                        {
+                            // removal shifts a later entry into this slot, look at it again
+                            answers.Remove( key );
+                            continue;
+                        }
+                    }
+                    i++;
+                }
+                mutex.Unlock();
+            }
+
+            /// @brief The supported candidate using the least memory per texel.
+            /// @return SDL_GPU_TEXTUREFORMAT_INVALID if no candidate is supported.
+            SDL_INLINE SDL_GPUTextureFormat BestFormat( const SDL_GPUTextureFormat *candidates, const int count, const SDL_GPUTextureType type, const SDL_GPUTextureUsageFlags usage )
+            {
+                SDL_GPUTextureFormat best = SDL_GPU_TEXTUREFORMAT_INVALID;
+                Uint32 bestSize = 0;
+                for ( int i = 0; i < count; i++ )
+                {
+                    if ( !TextureSupportsFormat( candidates[i], type, usage ) )
+                        continue;
+                    // 120 is a multiple of every block width and height, so block formats are measured exactly
+                    const Uint32 size = SDL_CalculateGPUTextureFormatSize( candidates[i], 120, 120, 1 );
+                    if ( best == SDL_GPU_TEXTUREFORMAT_INVALID || size < bestSize )
+                    {
+                        best = candidates[i];
+                        bestSize = size;
+                    }
+                }
+                return best;
+            }
+
+            /// @brief Write the format and sample count answers.
+            SDL_INLINE bool Save( IO::Stream &stream )
+            {
+                Array<Uint8> out;
+                PutU32( out, FILE_MAGIC );
+                PutU16( out, FILE_VERSION );
+                mutex.Lock();
+                PutU32( out, shaderFormats );
+                PutU32( out, ( Uint32 )driver.Num() );
+                PutBytes( out, driver.Ptr(), ( Uint32 )driver.Num() );
+                const int countOffset = out.Num();
+                PutU32( out, 0 );
+                Uint32 count = 0;
+                for ( Uint32 i = 0; i < answers.Capacity(); i++ )
+                {
+                    if ( !answers.IsUsed( i ) )
+                        continue;
+                    const Uint64 key = answers.KeyAt( i );
+                    const Uint8 kind = ( Uint8 )( key >> 56 );
+                    if ( kind != QUERY_FORMAT && kind != QUERY_SAMPLE_COUNT )
+                        continue;
+                    PutU64( out, key );
+                    PutU8( out, answers.ValueAt( i ) );
+                    count++;
+                }
+                mutex.Unlock();
+
+                if ( out.Num() < countOffset + 4 + ( int )count * 9 )
+                    return SDL_OutOfMemory();
+                Uint8 *countField = out.Ptr() + countOffset;
+                countField[0] = ( Uint8 )count;
+                countField[1] = ( Uint8 )( count >> 8 );
+                countField[2] = ( Uint8 )( count >> 16 );
+                countField[3] = ( Uint8 )( count >> 24 );
+
+                if ( stream.Write( out.Ptr(), ( size_t )out.Num() ) != ( size_t )out.Num() )
+                    return false;
+                return stream.Flush();
+            }
+
+            SDL_INLINE bool Save( const char *path )
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "wb" ) )
+                    return false;
+                const bool ok = Save( stream );
+                return stream.Close() && ok;
+            }
+
+            /// @brief Read answers saved for the same driver, answers already known are kept.
+            SDL_INLINE bool Load( IO::Stream &stream )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "DeviceCaps not created" );
+
+                size_t size = 0;
+                Uint8 *data = static_cast<Uint8*>( stream.LoadFile( &size, false ) );
+                if ( data == nullptr )
+                    return false;
+                const bool ok = Parse( data, size );
+                SDL_free( data );
+                return ok;
+            }
+
+            SDL_INLINE bool Load( const char *path )
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "rb" ) )
+                    return false;
+                const bool ok = Load( stream );
+                stream.Close();
+                return ok;
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                mutex.Lock();
+                Stats result = stats;
+                result.entries = answers.Num();
+                mutex.Unlock();
+                return result;
+            }
+
+        private:
+            DeviceCaps( const DeviceCaps & );
+            DeviceCaps &operator=( const DeviceCaps & );
+
+            // the top byte of a key
+            enum
+            {
+                QUERY_FORMAT = 1,
+                QUERY_SAMPLE_COUNT = 2,
+                QUERY_PRESENT_MODE = 3,
+                QUERY_COMPOSITION = 4
+            };
+
+            static SDL_INLINE Uint64 MakeKey( const Uint8 kind, const Uint32 format, const Uint32 low )
+            {
+                return ( ( Uint64 )kind << 56 ) | ( ( Uint64 )( format & 0xffffff ) << 32 ) | low;
+            }
+
+            static SDL_INLINE Uint64 MakeWindowKey( const Uint8 kind, const SDL_WindowID window, const Uint32 value )
+            {
+                return ( ( Uint64 )kind << 56 ) | ( ( Uint64 )window << 16 ) | ( value & 0xffff );
+            }
+
+            SDL_INLINE bool Query( const Uint64 key, const Uint8 kind, const SDL_GPUTextureFormat format, const SDL_GPUTextureType type,
+                                   const SDL_GPUTextureUsageFlags usage, SDL_Window *window, const Uint32 value )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "DeviceCaps not created" );
+
+                mutex.Lock();
+                stats.queries++;
+                const Uint8 *known = answers.Find( key );
+                if ( known != nullptr )
+                {
+                    const bool answer = *known != 0;
+                    mutex.Unlock();
+                    return answer;
+                }
+                stats.driverQueries++;
+                mutex.Unlock();
+
+                // ask without holding the lock, two threads may ask the same question once each
+                bool answer;
+                switch ( kind )
+                {
+                case QUERY_FORMAT:
+                    answer = device->TextureSupportsFormat( format, type, usage );
+                    break;
+                case QUERY_SAMPLE_COUNT:
+                    answer = SDL_GPUTextureSupportsSampleCount( *device, format, ( SDL_GPUSampleCount )value );
+                    break;
+                case QUERY_PRESENT_MODE:
+                    answer = SDL_WindowSupportsGPUPresentMode( *device, window, ( SDL_GPUPresentMode )value );
+                    break;
+                default:
+                    answer = SDL_WindowSupportsGPUSwapchainComposition( *device, window, ( SDL_GPUSwapchainComposition )value );
+                    break;
+                }
+
+                mutex.Lock();
+                // a failed insertion only costs asking again
+                answers.Insert( key, answer ? 1 : 0 );
+                mutex.Unlock();
+                return answer;
+            }
+
+            SDL_INLINE bool Parse( const Uint8 *data, const size_t size )
+            {
+                // magic, version, shader formats, driver name size
+                if ( size < 14 || GetU32( data ) != FILE_MAGIC )
+                    return SDL_SetError( "Not a device caps file" );
+                if ( ( Uint16 )( data[4] | ( data[5] << 8 ) ) != FILE_VERSION )
+                    return SDL_SetError( "Unsupported device caps version" );
+                const Uint32 formats = GetU32( data + 6 );
+                const Uint32 nameSize = GetU32( data + 10 );
+                if ( nameSize > size - 14 || size - 14 - nameSize < 4 )
+                    return SDL_SetError( "Truncated device caps file" );
+                const Uint8 *name = data + 14;
+                const Uint32 count = GetU32( name + nameSize );
+                const Uint8 *records = name + nameSize + 4;
+                if ( count > ( size - 18 - nameSize ) / 9 )
+                    return SDL_SetError( "Truncated device caps file" );
+
+                mutex.Lock();
+                const bool sameDevice = formats == shaderFormats && nameSize == ( Uint32 )driver.Num() &&
+                                        ( nameSize == 0 || SDL_memcmp( name, driver.Ptr(), nameSize ) == 0 );
+                bool ok = true;
+                int loaded = 0;
+                for ( Uint32 i = 0; sameDevice && i < count; i++ )
+                {
+                    const Uint8 *record = records + i * 9;
+                    const Uint64 key = GetU32( record ) | ( ( Uint64 )GetU32( record + 4 ) << 32 );
+                    const Uint8 kind = ( Uint8 )( key >> 56 );
+                    if ( kind != QUERY_FORMAT && kind != QUERY_SAMPLE_COUNT )
+                        continue;
+                    if ( answers.Find( key ) != nullptr )
+                        continue;
+                    if ( answers.Insert( key, record[8] != 0 ? 1 : 0 ) == nullptr )
+                    {
+                        ok = false;
+                        break;
+                    }
+                    loaded++;
+                }
+                stats.loaded = loaded;
+                mutex.Unlock();
+
+                if ( !sameDevice )
+                    return SDL_SetError( "Device caps file was saved for another driver" );
+                return ok ? true : SDL_OutOfMemory();
+            }
+
+            static SDL_INLINE Uint32 GetU32( const Uint8 *ptr )
+            {
+                return ( Uint32 )ptr[0] | ( ( Uint32 )ptr[1] << 8 ) | ( ( Uint32 )ptr[2] << 16 ) | ( ( Uint32 )ptr[3] << 24 );
+            }
+
+            const Device*       device;
+            mutable Mutex       mutex;
+            SDL_GPUShaderFormat shaderFormats;
+            Array<Uint8>        driver;         // driver name, without terminator
+            HashMap<Uint8>      answers;        // query key -> 0 or 1
+            Stats               stats;
+        };
+    }
+}
+#endif //!__SDL_DEVICE_CAPS_HPP__
@@ -0,0 +1,399 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_DOWNSAMPLER_HPP__
+#define __SDL_DOWNSAMPLER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+Downsampler
+==================================================================
+    Generates the mip chain of a texture with a compute shader, as an
+    alternative to Texture::GenerateMipmaps which blits one level at
+    a time.
+
+    Each workgroup of the shader reduces a 64x64 tile of the source
+    level down to a single texel, keeping the intermediate levels in
+    group shared memory, so one dispatch writes 6 levels. SDL GPU binds
+    at most 8 read-write storage textures to a compute pass, the source
+    level and 6 written levels fit in it, and the 12 levels of a 4096
+    texture take 2 dispatches.
+
+    The reductions are:
+        REDUCTION_BOX       average of the 2x2 texels, for mipmaps and bloom chains
+        REDUCTION_KAISER    4x4 taps of a Kaiser windowed sinc, sharper than the box;
+                            the taps cross the tiles, so it writes 1 level per dispatch
+        REDUCTION_MIN       minimum of the 2x2 texels, for a hierarchical Z buffer
+        REDUCTION_MAX       maximum, for a hierarchical Z buffer with a reversed depth
+
+    Reads past the right and bottom edges of a level are clamped to the
+    edge, as in the blit chain; the min and max pyramids are only
+    conservative for power of two sizes ( an odd last column or row of
+    a level is not part of the texel above it ).
+
+    The shader is GetShaderSource() ( HLSL ), compiled by the
+    application for its backend and given to Create. The texture is
+    bound as a read-write storage texture, so it needs the
+    SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE usage
+    and a float or unorm format supporting it. ReduceReference does
+    one level on the CPU for testing.
+
+    Example usage:
+        SDL::GPU::Downsampler downsampler;
+        downsampler.Create( device, code, codeSize, SDL_GPU_SHADERFORMAT_SPIRV );
+        ...
+        // every frame, outside of any pass
+        downsampler.Generate( commandBuffer, hzb, SDL_GPU_TEXTUREFORMAT_R32_FLOAT, 1024, 512, 11, SDL::GPU::Downsampler::REDUCTION_MAX );
+==================================================================
+*/
+        class Downsampler
+        {
+        public:
+            static const Uint32 THREAD_COUNT = 256;
+            static const Uint32 TILE_SIZE = 64;
+            static const Uint32 LEVELS_PER_DISPATCH = 6;
+            static const Uint32 STORAGE_TEXTURE_SLOTS = LEVELS_PER_DISPATCH + 1;
+
+            enum Reduction
+            {
+                REDUCTION_BOX,
+                REDUCTION_KAISER,
+                REDUCTION_MIN,
+                REDUCTION_MAX
+            };
+
+            struct Stats
+            {
+                Uint64  generates;
+                Uint64  dispatches;
+                Uint64  levels;
+            };
+
+            Downsampler( void ) : device( nullptr ) { SDL_zero( counters ); }
+            ~Downsampler( void ) { Destroy(); }
+
+            /// @brief The compute shader, to compile for the backend of the device.
+            static SDL_INLINE const char* GetShaderSource( void )
+            {
+                return
+                    "RWTexture2D<float4> Level0 : register( u0, space1 );\n"
+                    "RWTexture2D<float4> Level1 : register( u1, space1 );\n"
+                    "RWTexture2D<float4> Level2 : register( u2, space1 );\n"
+                    "RWTexture2D<float4> Level3 : register( u3, space1 );\n"
+                    "RWTexture2D<float4> Level4 : register( u4, space1 );\n"
+                    "RWTexture2D<float4> Level5 : register( u5, space1 );\n"
+                    "RWTexture2D<float4> Level6 : register( u6, space1 );\n"
+                    "cbuffer Params : register( b0, space2 ) { uint2 sourceSize; uint levelCount; uint reduction; };\n"
+                    "groupshared float4 Tile[32][32];\n"
+                    "static const float Kaiser[4] = { 0.054, 0.446, 0.446, 0.054 };\n"
+                    "uint2 LevelSize( uint level ) { return max( sourceSize >> level, 1u ); }\n"
+                    "float4 LoadSource( int2 coord ) { return Level0[clamp( coord, int2( 0, 0 ), int2( sourceSize ) - 1 )]; }\n"
+                    "float4 Reduce( float4 a, float4 b, float4 c, float4 d )\n"
+                    "{\n"
+                    "    if ( reduction == 2 )\n"
+                    "        return min( min( a, b ), min( c, d ) );\n"
+                    "    if ( reduction == 3 )\n"
+                    "        return max( max( a, b ), max( c, d ) );\n"
+                    "    return ( a + b + c + d ) * 0.25;\n"
+                    "}\n"
+                    "void Store( uint level, uint2 coord, float4 value )\n"
+                    "{\n"
+                    "    if ( any( coord >= LevelSize( level ) ) )\n"
+                    "        return;\n"
+                    "    if ( level == 1 ) Level1[coord] = value;\n"
+                    "    else if ( level == 2 ) Level2[coord] = value;\n"
+                    "    else if ( level == 3 ) Level3[coord] = value;\n"
+                    "    else if ( level == 4 ) Level4[coord] = value;\n"
+                    "    else if ( level == 5 ) Level5[coord] = value;\n"
+                    "    else Level6[coord] = value;\n"
+                    "}\n"
+                    "[numthreads( 256, 1, 1 )]\n"
+                    "void main( uint3 group : SV_GroupID, uint index : SV_GroupIndex )\n"
+                    "{\n"
+                    "    uint2 quad = uint2( index % 16, index / 16 ) * 2;\n"
+                    "    for ( uint i = 0; i < 4; i++ )\n"
+                    "    {\n"
+                    "        uint2 local = quad + uint2( i & 1, i >> 1 );\n"
+                    "        uint2 coord = group.xy * 32 + local;\n"
+                    "        int2 source = int2( coord * 2 );\n"
+                    "        float4 value = 0;\n"
+                    "        if ( reduction == 1 )\n"
+                    "        {\n"
+                    "            for ( int y = 0; y < 4; y++ )\n"
+                    "            {\n"
+                    "                for ( int x = 0; x < 4; x++ )\n"
+                    "                    value += Kaiser[x] * Kaiser[y] * LoadSource( source + int2( x - 1, y - 1 ) );\n"
+                    "            }\n"
+                    "        }\n"
+                    "        else\n"
+                    "            value = Reduce( LoadSource( source ), LoadSource( source + int2( 1, 0 ) ), LoadSource( source + int2( 0, 1 ) ), LoadSource( source + int2( 1, 1 ) ) );\n"
+                    "        Store( 1, coord, value );\n"
+                    "        Tile[local.y][local.x] = value;\n"
+                    "    }\n"
+                    "    for ( uint level = 2; level <= levelCount; level++ )\n"
+                    "    {\n"
+                    "        GroupMemoryBarrierWithGroupSync();\n"
+                    "        uint n = 64 >> level;\n"
+                    "        uint2 local = uint2( index % n, index / n );\n"
+                    "        uint2 last = min( LevelSize( level - 1 ) - 1 - group.xy * n * 2, n * 2 - 1 );\n"
+                    "        float4 value = 0;\n"
+                    "        if ( index < n * n )\n"
+                    "        {\n"
+                    "            uint2 a = min( local * 2, last );\n"
+                    "            uint2 b = min( local * 2 + 1, last );\n"
+                    "            value = Reduce( Tile[a.y][a.x], Tile[a.y][b.x], Tile[b.y][a.x], Tile[b.y][b.x] );\n"
+                    "            Store( level, group.xy * n + local, value );\n"
+                    "        }\n"
+                    "        GroupMemoryBarrierWithGroupSync();\n"
+                    "        if ( index < n * n )\n"
+                    "            Tile[local.y][local.x] = value;\n"
+                    "    }\n"
+                    "}\n";
+            }
+
+            /// @brief The resource layout of the shader, code and format are left to the caller.
+            static SDL_INLINE void GetPipelineInfo( SDL_GPUComputePipelineCreateInfo &info )
+            {
+                SDL_zero( info );
+                info.entrypoint = "main";
+                info.num_readwrite_storage_textures = STORAGE_TEXTURE_SLOTS;
+                info.num_uniform_buffers = 1;
+                info.threadcount_x = THREAD_COUNT;
+                info.threadcount_y = 1;
+                info.threadcount_z = 1;
+            }
+
+            /// @param code the compiled GetShaderSource(), in format.
+            SDL_INLINE bool Create( const Device &_device, const Uint8 *code, const size_t code_size, const SDL_GPUShaderFormat format )
+            {
+                Destroy();
+                SDL_GPUComputePipelineCreateInfo info;
+                GetPipelineInfo( info );
+                info.code = code;
+                info.code_size = code_size;
+                info.format = format;
+                if ( !pipeline.Create( _device, &info ) )
+                    return false;
+                device = &_device;
+                SDL_zero( counters );
+                return true;
+            }
+
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+                for ( int i = 0; i < placeholders.Num(); i++ )
+                {
+                    Texture texture( placeholders[i].texture );
+                    texture.Release( *device );
+                }
+                placeholders.Free();
+                pipeline.Release( *device );
+                device = nullptr;
+            }
+
+            /// @brief Record the generation of levels 1 to num_levels - 1 from level 0, outside of any pass.
+            /// @param format the format of texture, width and height the size of its level 0.
+            SDL_INLINE bool Generate( const CommandBuffer &commandBuffer, const Texture &texture, const SDL_GPUTextureFormat format,
+                                      const Uint32 width, const Uint32 height, const Uint32 num_levels, const Reduction reduction, const Uint32 layer = 0 )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "Downsampler: not created" );
+                if ( width == 0 || height == 0 )
+                    return SDL_SetError( "Downsampler: invalid size %ux%u", width, height );
+                if ( num_levels > 32 || ( num_levels > 1 && ( ( width | height ) >> ( num_levels - 1 ) ) == 0 ) )
+                    return SDL_SetError( "Downsampler: %u levels for a %ux%u texture", num_levels, width, height );
+
+                const Uint32 perDispatch = reduction == REDUCTION_KAISER ? 1 : LEVELS_PER_DISPATCH;
+                Uint32 level = 0;
+                while ( level + 1 < num_levels )
+                {
+                    const Uint32 count = SDL_min( perDispatch, num_levels - 1 - level );
+
+                    // the source level, the levels written, then placeholders for the unused slots
+                    SDL_GPUStorageTextureReadWriteBinding bindings[STORAGE_TEXTURE_SLOTS];
+                    SDL_zero( bindings );
+                    for ( Uint32 i = 0; i <= count; i++ )
+                    {
+                        bindings[i].texture = texture;
+                        bindings[i].mip_level = level + i;
+                        bindings[i].layer = layer;
+                    }
+                    if ( count < LEVELS_PER_DISPATCH )
+                    {
+                        SDL_GPUTexture *placeholder = GetPlaceholder( format );
+                        if ( placeholder == nullptr )
+                            return false;
+                        for ( Uint32 i = count + 1; i < STORAGE_TEXTURE_SLOTS; i++ )
+                        {
+                            bindings[i].texture = placeholder;
+                            bindings[i].mip_level = i - count - 1;
+                        }
+                    }
+
+                    ComputePass computePass;
+                    if ( !computePass.Begin( commandBuffer, bindings, STORAGE_TEXTURE_SLOTS, nullptr, 0 ) )
+                        return false;
+                    Params params;
+                    params.sourceSize[0] = SDL_max( width >> level, 1u );
+                    params.sourceSize[1] = SDL_max( height >> level, 1u );
+                    params.levelCount = count;
+                    params.reduction = ( Uint32 )reduction;
+                    pipeline.Bind( computePass );
+                    commandBuffer.PushComputeUniformData( 0, &params, sizeof( params ) );
+                    computePass.DispatchGPUCompute( ( params.sourceSize[0] + TILE_SIZE - 1 ) / TILE_SIZE, ( params.sourceSize[1] + TILE_SIZE - 1 ) / TILE_SIZE, 1 );
+                    computePass.End();
+
+                    counters.dispatches++;
+                    counters.levels += count;
+                    level += count;
+                }
+                counters.generates++;
+                return true;
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                return counters;
+            }
+
+            /// @brief One level of the shader on the CPU, with 4 floats per texel.
+            /// @param destination max( width >> 1, 1 ) x max( height >> 1, 1 ) texels.
+            static SDL_INLINE void ReduceReference( const float *source, const Uint32 width, const Uint32 height, const Reduction reduction, float *destination )
+            {
+                static const float kaiser[4] = { 0.054f, 0.446f, 0.446f, 0.054f };
+                const int w = ( int )SDL_max( width >> 1, 1u );
+                const int h = ( int )SDL_max( height >> 1, 1u );
+                for ( int y = 0; y < h; y++ )
+                {
+                    for ( int x = 0; x < w; x++ )
+                    {
+                        float *out = destination + ( y * w + x ) * 4;
+                        for ( int c = 0; c < 4; c++ )
+                        {
+                            if ( reduction == REDUCTION_KAISER )
+                            {
+                                float sum = 0.0f;
+                                for ( int j = 0; j < 4; j++ )
+                                {
+                                    for ( int i = 0; i < 4; i++ )
+                                        sum += kaiser[i] * kaiser[j] * Texel( source, width, height, x * 2 + i - 1, y * 2 + j - 1, c );
+                                }
+                                out[c] = sum;
+                                continue;
+                            }
+                            const float a = Texel( source, width, height, x * 2, y * 2, c );
+                            const float b = Texel( source, width, height, x * 2 + 1, y * 2, c );
+                            const float d = Texel( source, width, height, x * 2, y * 2 + 1, c );
+                            const float e = Texel( source, width, height, x * 2 + 1, y * 2 + 1, c );
+                            if ( reduction == REDUCTION_MIN )
+                                out[c] = SDL_min( SDL_min( a, b ), SDL_min( d, e ) );
+                            else if ( reduction == REDUCTION_MAX )
+                                out[c] = SDL_max( SDL_max( a, b ), SDL_max( d, e ) );
+                            else
+                                out[c] = ( a + b + d + e ) * 0.25f;
+                        }
+                    }
+                }
+            }
+
+        private:
+            Downsampler( const Downsampler & );
+            Downsampler &operator=( const Downsampler & );
+
+            // the shader's cbuffer Params
+            struct Params
+            {
+                Uint32  sourceSize[2];
+                Uint32  levelCount;
+                Uint32  reduction;
+            };
+
+            // binds the unused slots of the shader, never written
+            struct Placeholder
+            {
+                SDL_GPUTextureFormat    format;
+                SDL_GPUTexture*         texture;
+            };
+
+            static SDL_INLINE float Texel( const float *source, const Uint32 width, const Uint32 height, const int x, const int y, const int c )
+            {
+                const int cx = SDL_clamp( x, 0, ( int )width - 1 );
+                const int cy = SDL_clamp( y, 0, ( int )height - 1 );
+                return source[( cy * ( int )width + cx ) * 4 + c];
+            }
+
+            SDL_INLINE SDL_GPUTexture* GetPlaceholder( const SDL_GPUTextureFormat format )
+            {
+                for ( int i = 0; i < placeholders.Num(); i++ )
+                {
+                    if ( placeholders[i].format == format )
+                        return placeholders[i].texture;
+                }
+
+                // a distinct level for each slot a dispatch can leave unused
+                SDL_GPUTextureCreateInfo info;
+                SDL_zero( info );
+                info.type = SDL_GPU_TEXTURETYPE_2D;
+                info.format = format;
+                info.usage = SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE;
+                info.width = 1u << ( LEVELS_PER_DISPATCH - 2 );
+                info.height = info.width;
+                info.layer_count_or_depth = 1;
+                info.num_levels = LEVELS_PER_DISPATCH - 1;
+                info.sample_count = SDL_GPU_SAMPLECOUNT_1;
+                Texture texture;
+                if ( !texture.Create( *device, &info ) )
+                    return nullptr;
+                Placeholder placeholder;
+                placeholder.format = format;
+                placeholder.texture = texture;
+                if ( !placeholders.Append( placeholder ) )
+                {
+                    texture.Release( *device );
+                    SDL_OutOfMemory();
+                    return nullptr;
+                }
+                return placeholder.texture;
+            }
+
+            const Device*       device;
+            ComputePipeline     pipeline;
+            Array<Placeholder>  placeholders;
+            Stats               counters;
+        };
+    }
+}
+#endif //!__SDL_DOWNSAMPLER_HPP__
@@ -0,0 +1,299 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_DYNAMIC_BUFFER_HPP__
+#define __SDL_DYNAMIC_BUFFER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_framecontext.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+DynamicBuffer
+==================================================================
+    A GPU buffer for data rewritten every frame or so, that decides
+    when to cycle on its own.
+
+    Cycling gives the buffer fresh memory when the frames in flight
+    may still read the old one, so an upload never waits on them,
+    but the old contents are gone. The buffer remembers the last
+    frame of the FrameContext that wrote it or asked for its handle
+    with Use, and the last frame that mapped its transfer buffer;
+    each is still referenced until that frame signals.
+
+    Write replaces the contents, and cycles the buffer and the
+    transfer buffer only while they are referenced. Update rewrites
+    a range of the contents: in place when the buffer is free,
+    otherwise the buffer is cycled and the whole contents uploaded
+    again from the copy kept on the CPU, so nothing waits and nothing
+    is lost. The buffer grows when a Write does not fit.
+
+    Example usage:
+        SDL::GPU::DynamicBuffer lights;
+        lights.Create( device, frames, SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ, sizeof( Light ) * 64 );
+        ...
+        lights.Write( copyPass, visibleLights, sizeof( Light ) * numVisible );
+        copyPass.End();
+        ...
+        SDL_GPUBuffer *buffer = lights.Use();
+        renderPass.BindFragmentStorageBuffers( 0, &buffer, 1 );
+==================================================================
+*/
+        class DynamicBuffer
+        {
+        public:
+            struct Stats
+            {
+                Uint32  capacity;
+                Uint32  size;               // bytes of contents
+                Uint64  writes;             // Write and Update calls
+                Uint64  bytes;              // uploaded
+                Uint64  bufferCycles;       // uploads that cycled the buffer
+                Uint64  transferCycles;     // maps that cycled the transfer buffer
+                Uint64  inPlaceWrites;      // uploads into a buffer no frame in flight reads
+                Uint64  fullUploads;        // Update calls uploading the whole contents
+                Uint32  grows;
+            };
+
+            DynamicBuffer( void ) : device( nullptr ), frames( nullptr ), buffer( nullptr ), transfer( nullptr ), usage( 0 ),
+                                    capacity( 0 ), lastUse( 0 ), lastUpload( 0 ) { SDL_zero( counters ); }
+            ~DynamicBuffer( void ) { Release(); }
+
+            /// @brief Create the buffer and its transfer buffer.
+            /// @param device the device, it must outlive the buffer.
+            /// @param frames the frames in flight, they must outlive the buffer.
+            /// @param buffer_usage how the buffer is read.
+            /// @param size initial capacity in bytes.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool Create( const Device &_device, FrameContext &_frames, const SDL_GPUBufferUsageFlags buffer_usage, const Uint32 size )
+            {
+                Release();
+
+                device = &_device;
+                frames = &_frames;
+                usage = buffer_usage;
+                if ( !CreateBuffers( size > 0 ? size : 256 ) )
+                {
+                    Release();
+                    return false;
+                }
+                SDL_zero( counters );
+                return true;
+            }
+
+            /// @brief Release the buffers, SDL keeps them alive until the frames using them are done.
+            SDL_INLINE void Release( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                ReleaseBuffers();
+                contents.Free();
+                device = nullptr;
+                frames = nullptr;
+                usage = 0;
+                lastUse = 0;
+                lastUpload = 0;
+            }
+
+            /// @brief Replace the contents with size bytes of data and record their upload.
+            SDL_INLINE bool Write( const CopyPass &copyPass, const void *data, const Uint32 size )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "DynamicBuffer: not created" );
+                if ( ( data == nullptr && size > 0 ) || size > 0x7fffffff )
+                    return SDL_SetError( "DynamicBuffer: invalid write of %u bytes", size );
+
+                if ( size > capacity )
+                {
+                    // new buffers, nothing references them yet
+                    Uint32 grown = capacity > 0 ? capacity : 256;
+                    while ( grown < size )
+                        grown = grown < 0x40000000 ? grown * 2 : size;
+                    ReleaseBuffers();
+                    if ( !CreateBuffers( grown ) )
+                    {
+                        contents.Clear();
+                        return false;
+                    }
+                    lastUse = 0;
+                    lastUpload = 0;
+                    counters.grows++;
+                }
+
+                if ( !contents.Resize( ( int )size ) )
+                    return SDL_OutOfMemory();
+                if ( size > 0 )
+                    SDL_memcpy( contents.Ptr(), data, size );
+                counters.writes++;
+                if ( size == 0 )
+                    return true;
+
+                return Upload( copyPass, 0, size, IsReferenced( lastUse ) );
+            }
+
+            /// @brief Rewrite size bytes of the contents at offset and record their upload.
+            SDL_INLINE bool Update( const CopyPass &copyPass, const Uint32 offset, const void *data, const Uint32 size )
+            {
+                if ( device == nullptr || buffer == nullptr )
+                    return SDL_SetError( "DynamicBuffer: not created" );
+                if ( data == nullptr || size == 0 || offset > ( Uint32 )contents.Num() || size > ( Uint32 )contents.Num() - offset )
+                    return SDL_SetError( "DynamicBuffer: invalid update of %u bytes at %u, the contents are %d bytes", size, offset, contents.Num() );
+
+                SDL_memcpy( contents.Ptr() + offset, data, size );
+                counters.writes++;
+
+                if ( !IsReferenced( lastUse ) )
+                    return Upload( copyPass, offset, size, false );
+
+                // cycling drops the old contents, upload all of them into the new memory
+                counters.fullUploads++;
+                return Upload( copyPass, 0, ( Uint32 )contents.Num(), true );
+            }
+
+            /// @brief The buffer, counted as read by the frame being recorded.
+            SDL_INLINE SDL_GPUBuffer* Use( void )
+            {
+                if ( frames != nullptr )
+                    lastUse = frames->GetFrame();
+                return buffer;
+            }
+
+            /// @brief The buffer, without counting a use; the next Write may overwrite it in place.
+            SDL_INLINE SDL_GPUBuffer* GetBuffer( void ) const { return buffer; }
+
+            /// @brief The contents as last written, kept on the CPU.
+            SDL_INLINE const void* GetContents( void ) const { return contents.Ptr(); }
+
+            SDL_INLINE Uint32 GetSize( void ) const { return ( Uint32 )contents.Num(); }
+            SDL_INLINE Uint32 GetCapacity( void ) const { return capacity; }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats = counters;
+                stats.capacity = capacity;
+                stats.size = ( Uint32 )contents.Num();
+                return stats;
+            }
+
+        private:
+            DynamicBuffer( const DynamicBuffer & );
+            DynamicBuffer &operator=( const DynamicBuffer & );
+
+            // a frame that has not signaled may still read what it was given
+            SDL_INLINE bool IsReferenced( const Uint64 frame ) const
+            {
+                return frame != 0 && !frames->IsFrameComplete( frame );
+            }
+
+            SDL_INLINE bool Upload( const CopyPass &copyPass, const Uint32 offset, const Uint32 size, const bool cycle )
+            {
+                const bool cycleTransfer = IsReferenced( lastUpload );
+                TransferBuffer staging( transfer );
+                Uint8 *mapped = static_cast<Uint8*>( staging.Map( *device, cycleTransfer ) );
+                if ( mapped == nullptr )
+                    return false;
+                SDL_memcpy( mapped, contents.Ptr() + offset, size );
+                staging.Unmap( *device );
+
+                SDL_GPUTransferBufferLocation source;
+                source.transfer_buffer = transfer;
+                source.offset = 0;
+                SDL_GPUBufferRegion destination;
+                destination.buffer = buffer;
+                destination.offset = offset;
+                destination.size = size;
+                copyPass.UploadToBuffer( &source, &destination, cycle );
+
+                lastUpload = lastUse = frames->GetFrame();
+                counters.bytes += size;
+                if ( cycle )
+                    counters.bufferCycles++;
+                else
+                    counters.inPlaceWrites++;
+                if ( cycleTransfer )
+                    counters.transferCycles++;
+                return true;
+            }
+
+            SDL_INLINE bool CreateBuffers( const Uint32 size )
+            {
+                SDL_GPUBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = usage;
+                info.size = size;
+                Buffer gpuBuffer;
+                if ( !gpuBuffer.Create( *device, &info ) )
+                    return false;
+
+                SDL_GPUTransferBufferCreateInfo transferInfo;
+                SDL_zero( transferInfo );
+                transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                transferInfo.size = size;
+                TransferBuffer staging;
+                if ( !staging.Create( *device, &transferInfo ) )
+                {
+                    gpuBuffer.Release( *device );
+                    return false;
+                }
+
+                buffer = gpuBuffer;
+                transfer = staging;
+                capacity = size;
+                return true;
+            }
+
+            SDL_INLINE void ReleaseBuffers( void )
+            {
+                Buffer gpuBuffer( buffer );
+                gpuBuffer.Release( *device );
+                TransferBuffer staging( transfer );
+                staging.Release( *device );
+                buffer = nullptr;
+                transfer = nullptr;
+                capacity = 0;
+            }
+
+            const Device*           device;
+            FrameContext*           frames;
+            SDL_GPUBuffer*          buffer;
+            SDL_GPUTransferBuffer*  transfer;
+            SDL_GPUBufferUsageFlags usage;
+            Uint32                  capacity;
+            Array<Uint8>            contents;       // what the buffer holds, for uploads after a cycle
+            Uint64                  lastUse;        // last frame that wrote or used the buffer, 0 for none
+            Uint64                  lastUpload;     // last frame that mapped the transfer buffer
+            Stats                   counters;
+        };
+    }
+}
+#endif //!__SDL_DYNAMIC_BUFFER_HPP__
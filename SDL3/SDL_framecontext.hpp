@@ -0,0 +1,383 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_FRAME_CONTEXT_HPP__
+#define __SDL_FRAME_CONTEXT_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+FrameContext
+==================================================================
+    Keeps a fixed number of frames in flight and defers resource
+    releases until the GPU is done with them, so nothing has to wait
+    for the device to go idle before freeing.
+
+    Every frame slot keeps the fence of its command buffer and a
+    queue of pending releases. Releases made while recording go to
+    the current frame and run once its fence signals; BeginFrame
+    only blocks when the slot it reuses is still in flight, which
+    caps the CPU at the number of frames in flight ahead of the GPU.
+    Slots and their queues are reused, so a steady state frame does
+    not allocate.
+
+    Example usage:
+        SDL::GPU::FrameContext frames;
+        frames.Create( device, 2 );
+        ...
+        SDL::GPU::CommandBuffer commandBuffer;
+        if ( frames.BeginFrame( commandBuffer ) )
+        {
+            ...
+            frames.Release( oldVertexBuffer );    // still drawn by the frames in flight
+            frames.EndFrame( commandBuffer );
+        }
+        ...
+        frames.Destroy();
+==================================================================
+*/
+        class FrameContext
+        {
+        public:
+            static const int MAX_FRAMES_IN_FLIGHT = 4;
+
+            typedef void ( SDLCALL *ReleaseCallback )( void *userdata );
+
+            struct Stats
+            {
+                int     framesInFlight;
+                int     pendingReleases;    // queued, not run yet
+                Uint64  releases;           // run so far
+                Uint32  waits;              // BeginFrame calls that blocked on a fence
+                double  waitMS;
+            };
+
+            FrameContext( void ) : device( nullptr ), numFrames( 0 ), frame( 1 ), completedFrame( 0 ), recording( false ), releases( 0 ), waits( 0 ), waitMS( 0.0 ) {}
+            ~FrameContext( void ) { Destroy(); }
+
+            /// @param device the device, it must outlive the frame context.
+            /// @param frames_in_flight how many submitted frames may be pending, 1 to MAX_FRAMES_IN_FLIGHT.
+            SDL_INLINE bool Create( const Device &_device, const int frames_in_flight = 2 )
+            {
+                Destroy();
+
+                if ( frames_in_flight < 1 || frames_in_flight > MAX_FRAMES_IN_FLIGHT )
+                    return SDL_SetError( "FrameContext: invalid frames in flight %d", frames_in_flight );
+
+                device = &_device;
+                numFrames = frames_in_flight;
+                return true;
+            }
+
+            /// @brief Wait for every frame and run all the pending releases.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                WaitIdle();
+                RunReleases( current );
+                for ( int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++ )
+                    slots[i].releases.Free();
+                current.Free();
+
+                device = nullptr;
+                numFrames = 0;
+                frame = 1;
+                completedFrame = 0;
+                recording = false;
+                releases = 0;
+                waits = 0;
+                waitMS = 0.0;
+            }
+
+            /// @brief Acquire the command buffer of the next frame, after retiring the frame that used its slot.
+            SDL_INLINE bool BeginFrame( CommandBuffer &commandBuffer )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "FrameContext: not created" );
+                if ( recording )
+                    return SDL_SetError( "FrameContext: EndFrame was not called" );
+
+                Poll();
+                Slot &slot = slots[frame % numFrames];
+                if ( slot.fence != nullptr )
+                {
+                    const Uint64 start = SDL_GetPerformanceCounter();
+                    Fence fence( slot.fence );
+                    fence.WaitForFence( *device, true );
+                    waitMS += ( double )( SDL_GetPerformanceCounter() - start ) * 1000.0 / ( double )SDL_GetPerformanceFrequency();
+                    waits++;
+                    Retire( slot );
+                }
+
+                if ( !commandBuffer.Acquire( *device ) )
+                    return false;
+                recording = true;
+                return true;
+            }
+
+            /// @brief Submit the frame, the releases made during it wait for its fence.
+            SDL_INLINE bool EndFrame( const CommandBuffer &commandBuffer )
+            {
+                if ( !recording )
+                    return SDL_SetError( "FrameContext: BeginFrame was not called" );
+
+                recording = false;
+                SDL_GPUFence *fence = commandBuffer.SubmitAndAcquireFence();
+                if ( fence == nullptr )
+                {
+                    // the releases stay queued for the next frame
+                    return false;
+                }
+
+                Slot &slot = slots[frame % numFrames];
+                slot.fence = fence;
+                slot.frame = frame;
+                for ( int i = 0; i < current.Num(); i++ )
+                    slot.releases.Append( current[i] );
+                current.Clear();
+                frame++;
+                return true;
+            }
+
+            /// @brief Retire the frames whose fence signaled, without blocking.
+            SDL_INLINE void Poll( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < numFrames; i++ )
+                {
+                    Fence fence( slots[i].fence );
+                    if ( slots[i].fence != nullptr && fence.Query( *device ) )
+                        Retire( slots[i] );
+                }
+            }
+
+            /// @brief Wait for every submitted frame, the releases of the frame being recorded stay queued.
+            SDL_INLINE void WaitIdle( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                SDL_GPUFence *fences[MAX_FRAMES_IN_FLIGHT];
+                Uint32 count = 0;
+                for ( int i = 0; i < numFrames; i++ )
+                {
+                    if ( slots[i].fence != nullptr )
+                        fences[count++] = slots[i].fence;
+                }
+                if ( count > 0 )
+                    SDL_WaitForGPUFences( *device, true, fences, count );
+                for ( int i = 0; i < numFrames; i++ )
+                {
+                    if ( slots[i].fence != nullptr )
+                        Retire( slots[i] );
+                }
+            }
+
+            /// @brief Release once the GPU is done with the frames that may use it, the wrapper is left as is.
+            SDL_INLINE void Release( const Buffer &buffer ) { Queue( TYPE_BUFFER, buffer.GetHandle() ); }
+            SDL_INLINE void Release( const Texture &texture ) { Queue( TYPE_TEXTURE, texture.GetHandle() ); }
+            SDL_INLINE void Release( const Sampler &sampler ) { Queue( TYPE_SAMPLER, sampler.GetHandle() ); }
+            SDL_INLINE void Release( const TransferBuffer &buffer ) { Queue( TYPE_TRANSFER_BUFFER, buffer.GetHandle() ); }
+            SDL_INLINE void Release( const Shader &shader ) { Queue( TYPE_SHADER, shader.GetHandle() ); }
+            SDL_INLINE void Release( const GraphicsPipeline &pipeline ) { Queue( TYPE_GRAPHICS_PIPELINE, pipeline.GetHandle() ); }
+            SDL_INLINE void Release( const ComputePipeline &pipeline ) { Queue( TYPE_COMPUTE_PIPELINE, pipeline.GetHandle() ); }
+
+            /// @brief Run a callback once the frames submitted so far ( and the one being recorded ) are done.
+            SDL_INLINE void Defer( ReleaseCallback callback, void *userdata )
+            {
+                if ( callback == nullptr )
+                    return;
+                Pending pending;
+                pending.type = TYPE_CALLBACK;
+                pending.object = userdata;
+                pending.callback = callback;
+                Append( pending );
+            }
+
+            /// @brief Number of the frame being recorded ( or the next one ), the first frame is 1.
+            SDL_INLINE Uint64 GetFrame( void ) const { return frame; }
+
+            /// @brief Every frame up to this number is known to be done on the GPU.
+            SDL_INLINE Uint64 GetCompletedFrame( void ) const { return completedFrame; }
+
+            /// @brief True if the GPU finished the given frame, polls the fences in flight.
+            SDL_INLINE bool IsFrameComplete( const Uint64 frame_number )
+            {
+                if ( frame_number <= completedFrame )
+                    return true;
+                Poll();
+                return frame_number <= completedFrame;
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats;
+                stats.framesInFlight = 0;
+                stats.pendingReleases = current.Num();
+                for ( int i = 0; i < numFrames; i++ )
+                {
+                    if ( slots[i].fence != nullptr )
+                        stats.framesInFlight++;
+                    stats.pendingReleases += slots[i].releases.Num();
+                }
+                stats.releases = releases;
+                stats.waits = waits;
+                stats.waitMS = waitMS;
+                return stats;
+            }
+
+        private:
+            FrameContext( const FrameContext & );
+            FrameContext &operator=( const FrameContext & );
+
+            enum
+            {
+                TYPE_BUFFER,
+                TYPE_TEXTURE,
+                TYPE_SAMPLER,
+                TYPE_TRANSFER_BUFFER,
+                TYPE_SHADER,
+                TYPE_GRAPHICS_PIPELINE,
+                TYPE_COMPUTE_PIPELINE,
+                TYPE_CALLBACK
+            };
+
+            struct Pending
+            {
+                int             type;
+                void*           object;
+                ReleaseCallback callback;
+            };
+
+            struct Slot
+            {
+                Slot( void ) : fence( nullptr ), frame( 0 ) {}
+
+                SDL_GPUFence*   fence;
+                Uint64          frame;
+                Array<Pending>  releases;
+            };
+
+            SDL_INLINE void Queue( const int type, void *object )
+            {
+                if ( object == nullptr )
+                    return;
+                Pending pending;
+                pending.type = type;
+                pending.object = object;
+                pending.callback = nullptr;
+                Append( pending );
+            }
+
+            SDL_INLINE void Append( const Pending &pending )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "FrameContext: not created" );
+                    return;
+                }
+                // without memory to defer it, release now, after waiting for the GPU
+                if ( current.Append( pending ) == nullptr )
+                {
+                    WaitIdle();
+                    RunRelease( pending );
+                }
+            }
+
+            SDL_INLINE void Retire( Slot &slot )
+            {
+                Fence fence( slot.fence );
+                fence.Release( *device );
+                slot.fence = nullptr;
+                if ( slot.frame > completedFrame )
+                    completedFrame = slot.frame;
+                RunReleases( slot.releases );
+            }
+
+            SDL_INLINE void RunReleases( Array<Pending> &queue )
+            {
+                for ( int i = 0; i < queue.Num(); i++ )
+                    RunRelease( queue[i] );
+                queue.Clear();
+            }
+
+            SDL_INLINE void RunRelease( const Pending &pending )
+            {
+                switch ( pending.type )
+                {
+                case TYPE_BUFFER:
+                    SDL_ReleaseGPUBuffer( *device, static_cast<SDL_GPUBuffer*>( pending.object ) );
+                    break;
+                case TYPE_TEXTURE:
+                    SDL_ReleaseGPUTexture( *device, static_cast<SDL_GPUTexture*>( pending.object ) );
+                    break;
+                case TYPE_SAMPLER:
+                    SDL_ReleaseGPUSampler( *device, static_cast<SDL_GPUSampler*>( pending.object ) );
+                    break;
+                case TYPE_TRANSFER_BUFFER:
+                    SDL_ReleaseGPUTransferBuffer( *device, static_cast<SDL_GPUTransferBuffer*>( pending.object ) );
+                    break;
+                case TYPE_SHADER:
+                    SDL_ReleaseGPUShader( *device, static_cast<SDL_GPUShader*>( pending.object ) );
+                    break;
+                case TYPE_GRAPHICS_PIPELINE:
+                    SDL_ReleaseGPUGraphicsPipeline( *device, static_cast<SDL_GPUGraphicsPipeline*>( pending.object ) );
+                    break;
+                case TYPE_COMPUTE_PIPELINE:
+                    SDL_ReleaseGPUComputePipeline( *device, static_cast<SDL_GPUComputePipeline*>( pending.object ) );
+                    break;
+                case TYPE_CALLBACK:
+                    pending.callback( pending.object );
+                    break;
+                }
+                releases++;
+            }
+
+            const Device*   device;
+            int             numFrames;
+            Uint64          frame;
+            Uint64          completedFrame;
+            bool            recording;
+            Slot            slots[MAX_FRAMES_IN_FLIGHT];
+            Array<Pending>  current;        // releases made during the frame being recorded
+            Uint64          releases;
+            Uint32          waits;
+            double          waitMS;
+        };
+    }
+}
+#endif //!__SDL_FRAME_CONTEXT_HPP__
@@ -0,0 +1,377 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_FRAME_PACER_HPP__
+#define __SDL_FRAME_PACER_HPP__
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+#include <SDL3/SDL_video.h>
+#include "SDL_window.hpp"
+
+namespace SDL
+{
+/*
+==================================================================
+FramePacer
+==================================================================
+    Measures the phases of every frame on a vsync'd swapchain and
+    delays the start of the next frame so it is presented just before
+    the vblank, instead of sampling input right after the previous
+    present and then waiting a whole interval inside Present.
+
+    The display interval is seeded from the refresh rate of the window
+    display, then measured: the first CALIBRATION_FRAMES frames run
+    unpaced and the shortest time between two presents is taken as the
+    interval. After that it is refined from the time between presents,
+    and a calibration runs again whenever several deltas in a row are
+    not a whole number of intervals ( mode change, wrong seed ). The
+    CPU time of a frame
+    is estimated from the 90th percentile of the last WORK_WINDOW frames,
+    the frame starts at next vblank - work estimate - safety margin.
+
+    Present must block on the vblank for the estimate to work, use
+    Renderer::SetVSync( 1 ), or WaitForSwapchain with the GPU API and
+    Device::SetAllowedFramesInFlight( 1 ) to keep the queue short.
+
+    Input to present latency, present jitter ( distance from a whole
+    number of intervals ) and CPU work time are kept in histograms.
+
+    Example usage:
+        SDL::FramePacer pacer;
+        pacer.Init( window );
+        renderer.SetVSync( 1 );
+        while ( running )
+        {
+            pacer.WaitForFrameStart();
+            PollEvents();
+            Update();
+            Draw();
+            pacer.MarkSubmit();
+            renderer.Present();
+            pacer.MarkPresented();
+        }
+        pacer.LogSummary();
+==================================================================
+*/
+    class FramePacer
+    {
+    public:
+        static const int WORK_WINDOW = 32;
+        static const int CALIBRATION_FRAMES = 8;
+        static const int MAX_REJECTS = 4;
+
+        // fixed width buckets in milliseconds, the last bucket counts everything past the range
+        class Histogram
+        {
+        public:
+            static const int BUCKETS = 64;
+
+            Histogram( const double _bucketMS ) : bucketMS( _bucketMS ) { Clear(); }
+
+            SDL_INLINE void Clear( void )
+            {
+                SDL_zeroa( counts );
+                num = 0;
+                sumMS = 0.0;
+                maxMS = 0.0;
+            }
+
+            SDL_INLINE void Add( const double ms )
+            {
+                const double value = ms > 0.0 ? ms : 0.0;
+                const int bucket = ( int )( value / bucketMS );
+                counts[bucket < BUCKETS ? bucket : BUCKETS]++;
+                num++;
+                sumMS += value;
+                if ( value > maxMS )
+                    maxMS = value;
+            }
+
+            /// @brief Upper edge of the bucket holding the p-th percentile, p in [0, 1].
+            SDL_INLINE double Percentile( const double p ) const
+            {
+                if ( num == 0 )
+                    return 0.0;
+
+                const Uint64 rank = ( Uint64 )( p * ( double )( num - 1 ) ) + 1;
+                Uint64 seen = 0;
+                for ( int i = 0; i < BUCKETS; i++ )
+                {
+                    seen += counts[i];
+                    if ( seen >= rank )
+                        return ( i + 1 ) * bucketMS;
+                }
+                return maxMS;
+            }
+
+            SDL_INLINE double   Mean( void ) const { return num ? sumMS / ( double )num : 0.0; }
+            SDL_INLINE double   Max( void ) const { return maxMS; }
+            SDL_INLINE Uint64   Num( void ) const { return num; }
+            SDL_INLINE double   BucketMS( void ) const { return bucketMS; }
+            SDL_INLINE Uint32   Count( const int bucket ) const { return counts[bucket]; }
+
+        private:
+            double  bucketMS;
+            Uint32  counts[BUCKETS + 1];
+            Uint64  num;
+            double  sumMS;
+            double  maxMS;
+        };
+
+        FramePacer( void ) :
+            latency( 0.5 ),
+            jitter( 0.1 ),
+            work( 0.5 ),
+            intervalNS( 16666667 ),
+            marginNS( 1000000 ),
+            frameStart( 0 ),
+            inputTime( 0 ),
+            submitTime( 0 ),
+            lastPresent( 0 ),
+            lastDelayNS( 0 ),
+            missed( 0 ),
+            workCount( 0 ),
+            calibrationMin( 0 ),
+            calibrating( CALIBRATION_FRAMES ),
+            rejects( 0 ),
+            enabled( true )
+        {
+            SDL_zeroa( workNS );
+        }
+
+        ~FramePacer( void ) {}
+
+        /// @brief Seed the display interval from the refresh rate of the display showing window.
+        /// @return false if the refresh rate is unknown, 60 Hz is assumed.
+        SDL_INLINE bool Init( const Window &window )
+        {
+            const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode( SDL_GetDisplayForWindow( window ) );
+            if ( mode == nullptr || mode->refresh_rate <= 0.0f )
+            {
+                Init( 60.0f );
+                return false;
+            }
+
+            Init( mode->refresh_rate );
+            return true;
+        }
+
+        SDL_INLINE void Init( const float refreshHz )
+        {
+            intervalNS = ( Uint64 )( 1e9 / ( double )( refreshHz > 0.0f ? refreshHz : 60.0f ) );
+            Reset();
+        }
+
+        /// @brief Clear the histograms and the phase and work estimates, keeps the interval.
+        SDL_INLINE void Reset( void )
+        {
+            latency.Clear();
+            jitter.Clear();
+            work.Clear();
+            SDL_zeroa( workNS );
+            workCount = 0;
+            frameStart = 0;
+            inputTime = 0;
+            submitTime = 0;
+            lastPresent = 0;
+            lastDelayNS = 0;
+            missed = 0;
+            StartCalibration();
+        }
+
+        /// @brief Time kept between the estimated end of the CPU work and the vblank, 1 ms by default.
+        SDL_INLINE void SetSafetyMargin( const double ms ) { marginNS = ( Uint64 )( SDL_max( ms, 0.0 ) * 1e6 ); }
+
+        /// @brief Disable to only measure, WaitForFrameStart then never sleeps.
+        SDL_INLINE void SetEnabled( const bool enable ) { enabled = enable; }
+
+        /// @brief Sleep until the frame should start, then mark the start of the frame and of input sampling.
+        SDL_INLINE void WaitForFrameStart( void )
+        {
+            Uint64 now = SDL_GetTicksNS();
+            lastDelayNS = 0;
+
+            if ( enabled && calibrating == 0 && lastPresent != 0 && workCount > 0 )
+            {
+                Uint64 vblank = lastPresent + intervalNS;
+                while ( vblank <= now )
+                    vblank += intervalNS;
+
+                const Uint64 lead = WorkEstimateNS() + marginNS;
+                if ( vblank > now + lead )
+                {
+                    lastDelayNS = vblank - lead - now;
+                    SDL_DelayPrecise( lastDelayNS );
+                    now = SDL_GetTicksNS();
+                }
+            }
+
+            frameStart = now;
+            inputTime = now;
+        }
+
+        /// @brief Mark the moment input was sampled, when it is not right at the frame start.
+        SDL_INLINE void MarkInput( void ) { inputTime = SDL_GetTicksNS(); }
+
+        /// @brief Mark the end of the CPU work, just before Present or the command buffer submit.
+        SDL_INLINE void MarkSubmit( void ) { submitTime = SDL_GetTicksNS(); }
+
+        /// @brief Mark the return of the vsync'd Present, the closest thing to the vblank we can observe.
+        SDL_INLINE void MarkPresented( void )
+        {
+            const Uint64 now = SDL_GetTicksNS();
+
+            if ( frameStart != 0 && submitTime >= frameStart )
+            {
+                workNS[workCount % WORK_WINDOW] = submitTime - frameStart;
+                workCount++;
+                work.Add( NSToMS( submitTime - frameStart ) );
+            }
+
+            if ( inputTime != 0 )
+                latency.Add( NSToMS( now - inputTime ) );
+
+            if ( lastPresent != 0 && calibrating > 0 )
+            {
+                // unpaced frames present on consecutive vblanks whenever the work fits in one interval
+                const Uint64 delta = now - lastPresent;
+                if ( calibrationMin == 0 || delta < calibrationMin )
+                    calibrationMin = delta;
+
+                if ( --calibrating == 0 && calibrationMin >= MIN_INTERVAL_NS && calibrationMin <= MAX_INTERVAL_NS )
+                    intervalNS = calibrationMin;
+            }
+            else if ( lastPresent != 0 )
+            {
+                // deltas of a whole number of intervals refine the estimate, anything else is a hitch
+                const double delta = ( double )( now - lastPresent );
+                const double interval = ( double )intervalNS;
+                const double intervals = SDL_floor( delta / interval + 0.5 );
+                if ( intervals >= 1.0 && intervals <= 4.0 )
+                {
+                    const double residual = delta - intervals * interval;
+                    if ( SDL_fabs( residual ) < interval * 0.2 )
+                    {
+                        intervalNS = ( Uint64 )( interval + ( delta / intervals - interval ) * 0.05 );
+                        jitter.Add( NSToMS( ( Uint64 )SDL_fabs( residual ) ) );
+                        missed += ( Uint64 )intervals - 1;
+                        rejects = 0;
+                    }
+                    else
+                        rejects++;
+                }
+                else
+                    rejects++;
+
+                if ( rejects >= MAX_REJECTS )
+                    StartCalibration();
+            }
+
+            lastPresent = now;
+            submitTime = 0;
+        }
+
+        SDL_INLINE double   GetIntervalMS( void ) const { return NSToMS( intervalNS ); }
+        SDL_INLINE double   GetRefreshRate( void ) const { return 1e9 / ( double )intervalNS; }
+        SDL_INLINE double   GetLastDelayMS( void ) const { return NSToMS( lastDelayNS ); }
+        SDL_INLINE double   GetWorkEstimateMS( void ) const { return NSToMS( WorkEstimateNS() ); }
+        SDL_INLINE Uint64   GetMissedIntervals( void ) const { return missed; }
+        SDL_INLINE bool     IsCalibrating( void ) const { return calibrating > 0; }
+
+        SDL_INLINE const Histogram& GetLatency( void ) const { return latency; }
+        SDL_INLINE const Histogram& GetJitter( void ) const { return jitter; }
+        SDL_INLINE const Histogram& GetWork( void ) const { return work; }
+
+        SDL_INLINE void LogSummary( void ) const
+        {
+            SDL_Log( "FramePacer: %.2f Hz ( %.3f ms ), work estimate %.2f ms, missed intervals %" SDL_PRIu64,
+                GetRefreshRate(), GetIntervalMS(), GetWorkEstimateMS(), missed );
+            LogHistogram( "latency", latency );
+            LogHistogram( "jitter", jitter );
+            LogHistogram( "work", work );
+        }
+
+    private:
+        // accepted calibration range, 20 to 400 Hz
+        static const Uint64 MIN_INTERVAL_NS = 2500000;
+        static const Uint64 MAX_INTERVAL_NS = 50000000;
+
+        SDL_INLINE void StartCalibration( void )
+        {
+            calibrating = CALIBRATION_FRAMES;
+            calibrationMin = 0;
+            rejects = 0;
+        }
+
+        static SDL_INLINE double NSToMS( const Uint64 ns ) { return ( double )ns / 1e6; }
+
+        static SDL_INLINE void LogHistogram( const char *name, const Histogram &histogram )
+        {
+            SDL_Log( "  %-8s n %" SDL_PRIu64 "  mean %.2f  p50 %.2f  p90 %.2f  p99 %.2f  max %.2f ms",
+                name, histogram.Num(), histogram.Mean(), histogram.Percentile( 0.5 ), histogram.Percentile( 0.9 ), histogram.Percentile( 0.99 ), histogram.Max() );
+        }
+
+        SDL_INLINE Uint64 WorkEstimateNS( void ) const
+        {
+            const int num = workCount < WORK_WINDOW ? ( int )workCount : WORK_WINDOW;
+            if ( num == 0 )
+                return 0;
+
+            // insertion sort of a copy, the window is small
+            Uint64 sorted[WORK_WINDOW];
+            for ( int i = 0; i < num; i++ )
+            {
+                const Uint64 value = workNS[i];
+                int j = i;
+                for ( ; j > 0 && sorted[j - 1] > value; j-- )
+                    sorted[j] = sorted[j - 1];
+                sorted[j] = value;
+            }
+            return sorted[( num * 9 ) / 10];
+        }
+
+        Histogram   latency;
+        Histogram   jitter;
+        Histogram   work;
+        Uint64      intervalNS;
+        Uint64      marginNS;
+        Uint64      frameStart;
+        Uint64      inputTime;
+        Uint64      submitTime;
+        Uint64      lastPresent;
+        Uint64      lastDelayNS;
+        Uint64      missed;
+        Uint64      workNS[WORK_WINDOW];
+        Uint64      workCount;
+        Uint64      calibrationMin;
+        int         calibrating;
+        int         rejects;
+        bool        enabled;
+    };
+};
+
+#endif //!__SDL_FRAME_PACER_HPP__
@@ -77,6 +77,7 @@ SDLGPUDevice
                     SDL_DestroyGPUDevice( device );
                     device = nullptr;
                 }
+                return true;
             }
 
             SDL_INLINE bool WindowSupportsSwapchainComposition( const Window &window, const SDL_GPUSwapchainComposition swapchain_composition ) const
@@ -202,6 +203,16 @@ SDLGPUFence
                 }
             }
 
+            SDL_INLINE operator SDL_GPUFence*( void ) const
+            {
+                return fence;
+            }
+
+            SDL_INLINE SDL_GPUFence* GetHandle( void ) const
+            {
+                return fence;
+            }
+
         private:
             SDL_GPUFence* fence;
         };
@@ -688,7 +699,7 @@ SDLGPURenderPass
                 SDL_DrawGPUIndexedPrimitives(  renderPass, num_indices, num_instances, first_index, vertex_offset, first_instance );
             }
 
-            SDL_INLINE void DrawGPUPrimitives( Uint32 num_vertices, Uint32 num_instances, Uint32 first_vertex, Uint32 first_instance )
+            SDL_INLINE void DrawGPUPrimitives( Uint32 num_vertices, Uint32 num_instances, Uint32 first_vertex, Uint32 first_instance ) const
             {
                 SDL_DrawGPUPrimitives(  renderPass, num_vertices, num_instances, first_vertex, first_instance );
             }
@@ -725,9 +736,9 @@ SDLGPUCopyPass
     class CopyPass
     { 
     public: 
-        CopyPass( void );
+        CopyPass( void ) : copyPass( nullptr ) {}
         CopyPass( SDL_GPUCopyPass *copyPass ) : copyPass( copyPass ) {};
-        CopyPass( CopyPass &copyPass) : copyPass( copyPass.copyPass ) {}
+        CopyPass( const CopyPass &copyPass) : copyPass( copyPass.copyPass ) {}
         ~CopyPass( void ){};
 
         SDL_INLINE bool Begin( CommandBuffer command_buffer )
@@ -0,0 +1,640 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_GPU_PROFILER_HPP__
+#define __SDL_GPU_PROFILER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_timer.h>
+#include "SDL_array.hpp"
+#include "SDL_hashmap.hpp"
+#include "SDL_iostream.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+Profiler
+==================================================================
+    Splits the time of a GPU frame into recording, submission and
+    execution.
+
+    Scopes wrap the passes of a command buffer in a debug group, so
+    capture tools still see them, and time their recording on the
+    CPU. Submit times the submit call and keeps the fence of the
+    command buffer; Poll notes when each fence is seen signaled. SDL
+    GPU has no timestamp queries, so execution is measured per
+    command buffer, from submission ( or the end of the previous one )
+    to its fence, and is as precise as Poll is frequent.
+
+    Frames are aggregated once all their command buffers are done.
+    While capturing, scopes, submissions and frames are kept for
+    ExportChromeTrace, which writes them on their own process and
+    can share the time base of the render instrumentation trace.
+
+    One command buffer is recorded at a time, its scopes are closed
+    before Submit. Scope names are string literals that outlive the
+    profiler.
+
+    Example usage:
+        SDL::GPU::Profiler profiler;
+        profiler.Create( device );
+        ...
+        profiler.BeginFrame();
+        {
+            SDL::GPU::ProfileScope scope( profiler, commandBuffer, "shadows" );
+            ...
+        }
+        profiler.Submit( commandBuffer );
+        profiler.EndFrame();
+        profiler.Poll();
+        ...
+        profiler.StartCapture( 1 << 16 );
+        ... // frames
+        profiler.StopCapture();
+        profiler.ExportChromeTrace( "gpu.json", SDL::Instrument::Recorder::Get().GetCaptureStart() );
+==================================================================
+*/
+        class Profiler
+        {
+        public:
+            static const int HISTORY_SIZE = 256;
+
+            // one entry per scope name
+            struct ScopeStats
+            {
+                const char* name;
+                Uint64      totalCount;
+                Uint64      totalTicks;
+                Uint32      frameCount;
+                Uint64      frameTicks;
+                Uint32      lastFrameCount;
+                Uint64      lastFrameTicks;
+            };
+
+            struct FrameStats
+            {
+                Uint64  index;
+                Uint64  start;          // BeginFrame
+                Uint64  end;            // EndFrame
+                Uint64  recordTicks;    // in outermost scopes
+                Uint64  submitTicks;    // in the submit calls
+                Uint64  gpuTicks;       // executing its command buffers
+                Uint64  complete;       // when its last fence was seen signaled, 0 without submissions
+                Uint32  scopes;
+                Uint32  submits;
+            };
+
+            // one timed scope, only kept while capturing
+            struct ScopeEvent
+            {
+                Uint32  id;
+                Uint32  depth;
+                Uint64  submit;         // number of the submission it belongs to
+                Uint64  start;
+                Uint64  end;
+            };
+
+            // one command buffer, kept while capturing once it is done
+            struct SubmitEvent
+            {
+                Uint64  number;
+                Uint64  frame;
+                Uint64  start;          // submit call
+                Uint64  end;
+                Uint64  gpuStart;       // end of the submit or of the previous command buffer
+                Uint64  complete;
+            };
+
+            Profiler( void ) : device( nullptr ), frequency( SDL_GetPerformanceFrequency() ), frameIndex( 0 ), finishedFrames( 0 ), submitNumber( 0 ),
+                               lastComplete( 0 ), currentDone( 0 ), inFrame( false ), captureStart( 0 ), maxEvents( 0 ), dropped( 0 ), capturing( false )
+            {
+                SDL_zero( current );
+                SDL_zeroa( history );
+            }
+            ~Profiler( void ) { Destroy(); }
+
+            /// @param device the device, it must outlive the profiler.
+            SDL_INLINE bool Create( const Device &_device )
+            {
+                Destroy();
+                device = &_device;
+                return true;
+            }
+
+            /// @brief Wait for the command buffers in flight and drop everything recorded.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                WaitIdle();
+                scopes.Free();
+                names.Free();
+                open.Free();
+                pending.Free();
+                frames.Free();
+                scopeEvents.Free();
+                submitEvents.Free();
+                capturedFrames.Free();
+                SDL_zero( current );
+                SDL_zeroa( history );
+                device = nullptr;
+                frameIndex = 0;
+                finishedFrames = 0;
+                submitNumber = 0;
+                lastComplete = 0;
+                currentDone = 0;
+                inFrame = false;
+                maxEvents = 0;
+                dropped = 0;
+                capturing = false;
+            }
+
+            SDL_INLINE bool BeginFrame( void )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "Profiler: not created" );
+                if ( inFrame )
+                    return SDL_SetError( "Profiler: EndFrame was not called" );
+
+                SDL_zero( current );
+                currentDone = 0;
+                current.index = frameIndex;
+                current.start = SDL_GetPerformanceCounter();
+                inFrame = true;
+                return true;
+            }
+
+            /// @brief Open a scope and push a debug group of the same name.
+            /// @return false if the scope could not be opened, EndScope must not be called then.
+            SDL_INLINE bool BeginScope( const CommandBuffer &commandBuffer, const char *name )
+            {
+                OpenScope scope;
+                scope.id = Register( name );
+                scope.start = SDL_GetPerformanceCounter();
+                if ( open.Append( scope ) == nullptr )
+                    return SDL_OutOfMemory();
+                commandBuffer.PushDebugGroup( name );
+                return true;
+            }
+
+            SDL_INLINE void EndScope( const CommandBuffer &commandBuffer )
+            {
+                if ( open.Empty() )
+                {
+                    SDL_SetError( "Profiler: no scope to end" );
+                    return;
+                }
+                commandBuffer.PopDebugGroup();
+
+                const OpenScope scope = open.Last();
+                open.Resize( open.Num() - 1 );
+                if ( scope.id == INVALID_ID )
+                    return;
+
+                const Uint64 end = SDL_GetPerformanceCounter();
+                const Uint64 ticks = end - scope.start;
+                ScopeStats &stats = scopes[scope.id];
+                stats.totalCount++;
+                stats.totalTicks += ticks;
+                stats.frameCount++;
+                stats.frameTicks += ticks;
+                current.scopes++;
+                if ( open.Empty() )
+                    current.recordTicks += ticks;
+
+                if ( !capturing )
+                    return;
+                if ( scopeEvents.Num() >= maxEvents )
+                {
+                    dropped++;
+                    return;
+                }
+                ScopeEvent ev = { scope.id, ( Uint32 )open.Num(), submitNumber + 1, scope.start, end };
+                scopeEvents.Append( ev );
+            }
+
+            /// @brief Submit the command buffer and keep its fence to time its execution.
+            /// @return false if it could not be timed, outside a frame or with scopes open it is submitted untimed.
+            SDL_INLINE bool Submit( const CommandBuffer &commandBuffer )
+            {
+                if ( !inFrame || !open.Empty() )
+                {
+                    // the caller can not get the command buffer back, do not leak it
+                    commandBuffer.Submit();
+                    if ( !inFrame )
+                        return SDL_SetError( "Profiler: BeginFrame was not called" );
+                    return SDL_SetError( "Profiler: %d scopes are still open", open.Num() );
+                }
+
+                PendingSubmit submit;
+                submit.event.number = ++submitNumber;
+                submit.event.frame = current.index;
+                submit.event.start = SDL_GetPerformanceCounter();
+                submit.fence = commandBuffer.SubmitAndAcquireFence();
+                submit.event.end = SDL_GetPerformanceCounter();
+                submit.event.gpuStart = 0;
+                submit.event.complete = 0;
+                current.submitTicks += submit.event.end - submit.event.start;
+                if ( submit.fence == nullptr )
+                    return false;
+
+                if ( pending.Append( submit ) == nullptr )
+                {
+                    Fence fence( submit.fence );
+                    fence.Release( *device );
+                    return SDL_OutOfMemory();
+                }
+                current.submits++;
+                return true;
+            }
+
+            /// @brief Close the frame, it is aggregated once its command buffers are done.
+            SDL_INLINE bool EndFrame( void )
+            {
+                if ( !inFrame )
+                    return SDL_SetError( "Profiler: BeginFrame was not called" );
+                if ( !open.Empty() )
+                    return SDL_SetError( "Profiler: %d scopes are still open", open.Num() );
+
+                current.end = SDL_GetPerformanceCounter();
+                inFrame = false;
+                frameIndex++;
+
+                for ( int i = 0; i < scopes.Num(); i++ )
+                {
+                    scopes[i].lastFrameCount = scopes[i].frameCount;
+                    scopes[i].lastFrameTicks = scopes[i].frameTicks;
+                    scopes[i].frameCount = 0;
+                    scopes[i].frameTicks = 0;
+                }
+
+                PendingFrame frame;
+                frame.stats = current;
+                frame.outstanding = current.submits - currentDone;
+                currentDone = 0;
+                if ( frame.outstanding == 0 )
+                    Finish( frame.stats );
+                else if ( frames.Append( frame ) == nullptr )
+                    return SDL_OutOfMemory();
+                Poll();
+                return true;
+            }
+
+            /// @brief Note the command buffers whose fence signaled, without blocking.
+            SDL_INLINE void Poll( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                // in submission order, so the execution of a command buffer starts after the previous one
+                int done = 0;
+                const Uint64 now = SDL_GetPerformanceCounter();
+                while ( done < pending.Num() )
+                {
+                    Fence fence( pending[done].fence );
+                    if ( !fence.Query( *device ) )
+                        break;
+                    Complete( pending[done], now );
+                    done++;
+                }
+                RemovePending( done );
+            }
+
+            /// @brief Wait for the command buffers in flight.
+            SDL_INLINE void WaitIdle( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < pending.Num(); i++ )
+                {
+                    Fence fence( pending[i].fence );
+                    fence.WaitForFence( *device, true );
+                    Complete( pending[i], SDL_GetPerformanceCounter() );
+                }
+                RemovePending( pending.Num() );
+            }
+
+            /// @brief Start keeping scopes, submissions and frames for export.
+            /// @param max_events scopes after this count are dropped, not recorded
+            SDL_INLINE void StartCapture( const int max_events )
+            {
+                scopeEvents.Clear();
+                submitEvents.Clear();
+                capturedFrames.Clear();
+                scopeEvents.Reserve( max_events < 4096 ? max_events : 4096 );
+                maxEvents = max_events;
+                dropped = 0;
+                captureStart = SDL_GetPerformanceCounter();
+                capturing = true;
+            }
+
+            SDL_INLINE void StopCapture( void ) { capturing = false; }
+
+            SDL_INLINE bool                 IsCapturing( void ) const { return capturing; }
+            SDL_INLINE Uint64               GetDroppedEvents( void ) const { return dropped; }
+            SDL_INLINE Uint64               GetFrequency( void ) const { return frequency; }
+            SDL_INLINE int                  NumScopes( void ) const { return scopes.Num(); }
+            SDL_INLINE const ScopeStats&    GetScope( const int id ) const { return scopes[id]; }
+            SDL_INLINE int                  NumPendingSubmits( void ) const { return pending.Num(); }
+
+            /// @brief Number of frames done on the GPU and aggregated.
+            SDL_INLINE Uint64               NumFrames( void ) const { return finishedFrames; }
+
+            /// @brief Get a frame done on the GPU.
+            /// @param frames_ago 0 is the last finished frame, up to HISTORY_SIZE - 1
+            SDL_INLINE const FrameStats&    GetFrame( const int frames_ago ) const
+            {
+                return history[( finishedFrames - 1 - frames_ago ) % HISTORY_SIZE];
+            }
+
+            SDL_INLINE double               TicksToMS( const Uint64 ticks ) const
+            {
+                return ( double )ticks * 1000.0 / ( double )frequency;
+            }
+
+            /// @brief Write the captured frames, scopes and command buffers as Chrome trace JSON.
+            /// @param base_ticks performance counter of time 0, 0 for the capture start; pass the capture start of another trace to line them up.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool ExportChromeTrace( IO::Stream &stream, const Uint64 base_ticks = 0 ) const
+            {
+                const Uint64 base = base_ticks != 0 ? base_ticks : captureStart;
+                const double toUS = 1000000.0 / ( double )frequency;
+                bool ok = stream.printf( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                                         "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}" ) > 0;
+                for ( int i = 0; ok && i < TRACK_COUNT; i++ )
+                    ok = stream.printf( ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", i, TrackNames()[i] ) > 0;
+
+                for ( int i = 0; ok && i < capturedFrames.Num(); i++ )
+                {
+                    const FrameStats &frame = capturedFrames[i];
+                    ok = stream.printf( ",\n{\"name\":\"frame %" SDL_PRIu64 "\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                                        "\"args\":{\"record_ms\":%.3f,\"submit_ms\":%.3f,\"gpu_ms\":%.3f}}",
+                        frame.index, Relative( frame.start, base ) * toUS, ( double )( frame.end - frame.start ) * toUS, TRACK_FRAMES,
+                        TicksToMS( frame.recordTicks ), TicksToMS( frame.submitTicks ), TicksToMS( frame.gpuTicks ) ) > 0;
+                }
+
+                for ( int i = 0; ok && i < scopeEvents.Num(); i++ )
+                {
+                    const ScopeEvent &ev = scopeEvents[i];
+                    ok = stream.printf( ",\n{\"name\":\"" ) > 0 && WriteJSONString( stream, scopes[ev.id].name );
+                    ok = ok && stream.printf( "\",\"cat\":\"record\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"submit\":%" SDL_PRIu64 "}}",
+                        Relative( ev.start, base ) * toUS, ( double )( ev.end - ev.start ) * toUS, TRACK_RECORD, ev.submit ) > 0;
+                }
+
+                for ( int i = 0; ok && i < submitEvents.Num(); i++ )
+                {
+                    const SubmitEvent &ev = submitEvents[i];
+                    ok = stream.printf( ",\n{\"name\":\"submit %" SDL_PRIu64 "\",\"cat\":\"submit\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"frame\":%" SDL_PRIu64 "}}",
+                        ev.number, Relative( ev.start, base ) * toUS, ( double )( ev.end - ev.start ) * toUS, TRACK_SUBMIT, ev.frame ) > 0;
+                    ok = ok && stream.printf( ",\n{\"name\":\"command buffer %" SDL_PRIu64 "\",\"cat\":\"gpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                                              "\"args\":{\"frame\":%" SDL_PRIu64 ",\"latency_ms\":%.3f}}",
+                        ev.number, Relative( ev.gpuStart, base ) * toUS, ( double )( ev.complete - ev.gpuStart ) * toUS, TRACK_GPU, ev.frame,
+                        TicksToMS( ev.complete - ev.end ) ) > 0;
+                }
+
+                ok = ok && stream.printf( "\n]}\n" ) > 0;
+                if ( !ok )
+                    return SDL_SetError( "Profiler: failed to write the chrome trace" );
+                return true;
+            }
+
+            SDL_INLINE bool ExportChromeTrace( const char *path, const Uint64 base_ticks = 0 ) const
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "w" ) )
+                    return false;
+                const bool ok = ExportChromeTrace( stream, base_ticks );
+                return stream.Close() && ok;
+            }
+
+        private:
+            Profiler( const Profiler & );
+            Profiler &operator=( const Profiler & );
+
+            static const Uint32 INVALID_ID = 0xffffffff;
+
+            enum
+            {
+                TRACK_FRAMES,
+                TRACK_RECORD,
+                TRACK_SUBMIT,
+                TRACK_GPU,
+                TRACK_COUNT
+            };
+
+            struct OpenScope
+            {
+                Uint32  id;
+                Uint64  start;
+            };
+
+            struct PendingSubmit
+            {
+                SDL_GPUFence*   fence;
+                SubmitEvent     event;
+            };
+
+            struct PendingFrame
+            {
+                FrameStats  stats;
+                Uint32      outstanding;    // command buffers not done yet
+            };
+
+            static SDL_INLINE const char* const* TrackNames( void )
+            {
+                static const char* const names[TRACK_COUNT] = { "frames", "recording", "submission", "execution" };
+                return names;
+            }
+
+            static SDL_INLINE double Relative( const Uint64 ticks, const Uint64 base )
+            {
+                return ticks > base ? ( double )( ticks - base ) : 0.0;
+            }
+
+            // scopes are keyed by the address of their name
+            // the contents of a JSON string, quotes, backslashes and control characters escaped
+            static SDL_INLINE bool WriteJSONString( IO::Stream &stream, const char *text )
+            {
+                const char *run = text;
+                for ( const char *c = text; ; c++ )
+                {
+                    const unsigned char ch = ( unsigned char )*c;
+                    if ( ch != '\0' && ch != '"' && ch != '\\' && ch >= 0x20 )
+                        continue;
+                    const size_t length = ( size_t )( c - run );
+                    if ( length > 0 && stream.Write( run, length ) != length )
+                        return false;
+                    if ( ch == '\0' )
+                        return true;
+                    const bool ok = ch == '"' || ch == '\\' ? stream.printf( "\\%c", ch ) > 0 : stream.printf( "\\u%04x", ch ) > 0;
+                    if ( !ok )
+                        return false;
+                    run = c + 1;
+                }
+            }
+
+            SDL_INLINE Uint32 Register( const char *name )
+            {
+                const Uint64 key = ( Uint64 )( uintptr_t )name;
+                const Uint32 *found = names.Find( key );
+                if ( found != nullptr )
+                    return *found;
+
+                ScopeStats stats;
+                SDL_zero( stats );
+                stats.name = name != nullptr ? name : "";
+                const Uint32 id = ( Uint32 )scopes.Num();
+                if ( scopes.Append( stats ) == nullptr )
+                    return INVALID_ID;
+                if ( names.Insert( key, id ) == nullptr )
+                {
+                    scopes.Resize( ( int )id );
+                    return INVALID_ID;
+                }
+                return id;
+            }
+
+            SDL_INLINE void Complete( PendingSubmit &submit, const Uint64 now )
+            {
+                Fence fence( submit.fence );
+                fence.Release( *device );
+                submit.fence = nullptr;
+
+                // the queue runs the command buffers one after the other
+                SubmitEvent &ev = submit.event;
+                ev.gpuStart = lastComplete > ev.end ? lastComplete : ev.end;
+                ev.complete = now > ev.gpuStart ? now : ev.gpuStart;
+                lastComplete = ev.complete;
+                if ( capturing )
+                    submitEvents.Append( ev );
+
+                if ( inFrame && ev.frame == current.index )
+                {
+                    // submitted earlier in the frame being recorded
+                    current.gpuTicks += ev.complete - ev.gpuStart;
+                    current.complete = ev.complete;
+                    currentDone++;
+                    return;
+                }
+
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    PendingFrame &frame = frames[i];
+                    if ( frame.stats.index != ev.frame )
+                        continue;
+                    frame.stats.gpuTicks += ev.complete - ev.gpuStart;
+                    frame.stats.complete = ev.complete;
+                    if ( --frame.outstanding == 0 )
+                    {
+                        Finish( frame.stats );
+                        frames.RemoveIndex( i );
+                    }
+                    return;
+                }
+            }
+
+            SDL_INLINE void RemovePending( const int count )
+            {
+                if ( count == 0 )
+                    return;
+                for ( int i = count; i < pending.Num(); i++ )
+                    pending[i - count] = pending[i];
+                pending.Resize( pending.Num() - count );
+            }
+
+            SDL_INLINE void Finish( const FrameStats &frame )
+            {
+                history[finishedFrames % HISTORY_SIZE] = frame;
+                finishedFrames++;
+                if ( capturing )
+                    capturedFrames.Append( frame );
+            }
+
+            const Device*           device;
+            Uint64                  frequency;
+            Uint64                  frameIndex;
+            Uint64                  finishedFrames;
+            Uint64                  submitNumber;
+            Uint64                  lastComplete;       // when the last command buffer was seen done
+            Uint32                  currentDone;        // command buffers of the current frame already done
+            bool                    inFrame;
+            Uint64                  captureStart;
+            int                     maxEvents;
+            Uint64                  dropped;
+            bool                    capturing;
+            Array<ScopeStats>       scopes;
+            HashMap<Uint32>         names;
+            Array<OpenScope>        open;
+            Array<PendingSubmit>    pending;
+            Array<PendingFrame>     frames;
+            Array<ScopeEvent>       scopeEvents;
+            Array<SubmitEvent>      submitEvents;
+            Array<FrameStats>       capturedFrames;
+            FrameStats              current;
+            FrameStats              history[HISTORY_SIZE];
+        };
+
+/*
+==================================================================
+ProfileScope
+==================================================================
+    Times the enclosing block of command buffer recording as a
+    Profiler scope.
+==================================================================
+*/
+        class ProfileScope
+        {
+        public:
+            ProfileScope( Profiler &_profiler, const CommandBuffer &_commandBuffer, const char *name ) :
+                profiler( _profiler ),
+                commandBuffer( _commandBuffer ),
+                begun( _profiler.BeginScope( _commandBuffer, name ) )
+            {
+            }
+
+            ~ProfileScope( void )
+            {
+                if ( begun )
+                    profiler.EndScope( commandBuffer );
+            }
+
+        private:
+            ProfileScope( const ProfileScope & );
+            ProfileScope &operator=( const ProfileScope & );
+
+            Profiler&       profiler;
+            CommandBuffer   commandBuffer;
+            bool            begun;
+        };
+    }
+}
+#endif //!__SDL_GPU_PROFILER_HPP__
@@ -0,0 +1,71 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_HALF_HPP__
+#define __SDL_HALF_HPP__
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace SDL
+{
+    /// @brief value >> shift, rounded to nearest even.
+    SDL_INLINE Uint32 RoundShiftEven( const Uint32 value, const Uint32 shift )
+    {
+        const Uint32 result = value >> shift;
+        const Uint32 rest = value & ( ( 1u << shift ) - 1 );
+        const Uint32 halfway = 1u << ( shift - 1 );
+        return ( rest > halfway || ( rest == halfway && ( result & 1 ) ) ) ? result + 1 : result;
+    }
+
+    /// @brief IEEE half float, rounded to nearest even, for HALF2 / HALF4 vertex data.
+    SDL_INLINE Uint16 FloatToHalf( const float value )
+    {
+        Uint32 bits;
+        SDL_memcpy( &bits, &value, sizeof( bits ) );
+        const Uint16 sign = ( Uint16 )( ( bits >> 16 ) & 0x8000 );
+        const Uint32 biased = ( bits >> 23 ) & 0xff;
+        Uint32 mantissa = bits & 0x7fffff;
+        if ( biased == 0xff )
+            return ( Uint16 )( sign | 0x7c00 | ( mantissa != 0 ? 0x200 : 0 ) );
+
+        const int exponent = ( int )biased - 127 + 15;
+        if ( exponent >= 31 )
+            return ( Uint16 )( sign | 0x7c00 );
+        if ( exponent <= 0 )
+        {
+            // subnormal half
+            if ( exponent < -10 )
+                return sign;
+            mantissa |= 0x800000;
+            const Uint32 shift = ( Uint32 )( 14 - exponent );
+            return ( Uint16 )( sign | RoundShiftEven( mantissa, shift ) );
+        }
+        // a carry out of the mantissa correctly bumps the exponent
+        return ( Uint16 )( sign | ( ( ( Uint32 )exponent << 10 ) + RoundShiftEven( mantissa, 13 ) ) );
+    }
+}
+
+#endif //!__SDL_HALF_HPP__
@@ -0,0 +1,229 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_HASHMAP_HPP__
+#define __SDL_HASHMAP_HPP__
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace SDL
+{
+    /// @brief 64 bit FNV-1a, chain calls by passing the previous result as seed.
+    SDL_INLINE Uint64 HashBytes( const void *data, const size_t size, Uint64 seed = 0xcbf29ce484222325ull )
+    {
+        const Uint8 *bytes = static_cast<const Uint8*>( data );
+        for ( size_t i = 0; i < size; i++ )
+        {
+            seed ^= bytes[i];
+            seed *= 0x100000001b3ull;
+        }
+        return seed;
+    }
+
+    /// @brief Hash a nul terminated string, a null string hashes like a empty one.
+    SDL_INLINE Uint64 HashString( const char *str, Uint64 seed = 0xcbf29ce484222325ull )
+    {
+        return str != nullptr ? HashBytes( str, SDL_strlen( str ) + 1, seed ) : HashBytes( "", 1, seed );
+    }
+
+    template<typename t_>
+    SDL_INLINE Uint64 HashValue( const t_ &value, Uint64 seed = 0xcbf29ce484222325ull )
+    {
+        return HashBytes( &value, sizeof( t_ ), seed );
+    }
+
+/*
+==================================================================
+HashMap
+==================================================================
+    Open addressing hash map from a 64 bit key to a plain data value,
+    backed by SDL_malloc. Use it for pointers ( cast to uintptr_t ) or
+    for keys that are already hashes. Values are copied with
+    SDL_memcpy, so only use trivially copyable types.
+
+    Example usage:
+        SDL::HashMap<Uint32> ids;
+        ids.Insert( ( uintptr_t )texture, 1 );
+        Uint32 *id = ids.Find( ( uintptr_t )texture );
+==================================================================
+*/
+    template<typename t_>
+    class HashMap
+    {
+    public:
+        HashMap( void ) : slots( nullptr ), capacity( 0 ), num( 0 ) {}
+        ~HashMap( void ) { Free(); }
+
+        SDL_INLINE void Free( void )
+        {
+            SDL_free( slots );
+            slots = nullptr;
+            capacity = 0;
+            num = 0;
+        }
+
+        SDL_INLINE void Clear( void )
+        {
+            for ( Uint32 i = 0; i < capacity; i++ )
+                slots[i].used = false;
+            num = 0;
+        }
+
+        SDL_INLINE t_* Find( const Uint64 key )
+        {
+            if ( num == 0 )
+                return nullptr;
+
+            for ( Uint32 i = Mix( key ) & ( capacity - 1 ); slots[i].used; i = ( i + 1 ) & ( capacity - 1 ) )
+            {
+                if ( slots[i].key == key )
+                    return &slots[i].value;
+            }
+            return nullptr;
+        }
+
+        SDL_INLINE const t_* Find( const Uint64 key ) const
+        {
+            return const_cast<HashMap*>( this )->Find( key );
+        }
+
+        /// @brief Insert or replace the value of a key.
+        /// @return a pointer to the stored value, or nullptr if the allocation failed
+        SDL_INLINE t_* Insert( const Uint64 key, const t_ &value )
+        {
+            // keep the load under 3/4
+            if ( ( num + 1 ) * 4 > capacity * 3 && !Rehash( capacity ? capacity * 2 : 16 ) )
+                return nullptr;
+
+            Uint32 i = Mix( key ) & ( capacity - 1 );
+            for ( ; slots[i].used; i = ( i + 1 ) & ( capacity - 1 ) )
+            {
+                if ( slots[i].key == key )
+                    break;
+            }
+
+            if ( !slots[i].used )
+                num++;
+
+            slots[i].used = true;
+            slots[i].key = key;
+            SDL_memcpy( &slots[i].value, &value, sizeof( t_ ) );
+            return &slots[i].value;
+        }
+
+        /// @return true if the key was in the map
+        SDL_INLINE bool Remove( const Uint64 key )
+        {
+            if ( num == 0 )
+                return false;
+
+            Uint32 i = Mix( key ) & ( capacity - 1 );
+            for ( ; slots[i].used; i = ( i + 1 ) & ( capacity - 1 ) )
+            {
+                if ( slots[i].key == key )
+                    break;
+            }
+
+            if ( !slots[i].used )
+                return false;
+
+            // backward shift deletion, keeps the probe chains intact without tombstones
+            Uint32 hole = i;
+            for ( Uint32 j = ( i + 1 ) & ( capacity - 1 ); slots[j].used; j = ( j + 1 ) & ( capacity - 1 ) )
+            {
+                const Uint32 home = Mix( slots[j].key ) & ( capacity - 1 );
+                const bool movable = ( hole <= j ) ? ( home <= hole || home > j ) : ( home <= hole && home > j );
+                if ( movable )
+                {
+                    SDL_memcpy( &slots[hole], &slots[j], sizeof( Slot ) );
+                    hole = j;
+                }
+            }
+
+            slots[hole].used = false;
+            num--;
+            return true;
+        }
+
+        SDL_INLINE int      Num( void ) const { return ( int )num; }
+
+        // iteration over the raw slots: for ( i = 0; i < Capacity(); i++ ) if ( IsUsed( i ) ) ...
+        SDL_INLINE Uint32   Capacity( void ) const { return capacity; }
+        SDL_INLINE bool     IsUsed( const Uint32 index ) const { return slots[index].used; }
+        SDL_INLINE Uint64   KeyAt( const Uint32 index ) const { return slots[index].key; }
+        SDL_INLINE t_&      ValueAt( const Uint32 index ) { return slots[index].value; }
+
+    private:
+        struct Slot
+        {
+            Uint64  key;
+            t_      value;
+            bool    used;
+        };
+
+        HashMap( const HashMap &ref );
+        HashMap& operator=( const HashMap &ref );
+
+        static SDL_INLINE Uint32 Mix( Uint64 key )
+        {
+            // splitmix64 finalizer, spreads pointer and counter keys
+            key ^= key >> 30;
+            key *= 0xbf58476d1ce4e5b9ull;
+            key ^= key >> 27;
+            key *= 0x94d049bb133111ebull;
+            key ^= key >> 31;
+            return ( Uint32 )key;
+        }
+
+        SDL_INLINE bool Rehash( const Uint32 newCapacity )
+        {
+            Slot *newSlots = static_cast<Slot*>( SDL_calloc( newCapacity, sizeof( Slot ) ) );
+            if ( newSlots == nullptr )
+                return false;
+
+            Slot *oldSlots = slots;
+            const Uint32 oldCapacity = capacity;
+            slots = newSlots;
+            capacity = newCapacity;
+            num = 0;
+
+            for ( Uint32 i = 0; i < oldCapacity; i++ )
+            {
+                if ( oldSlots[i].used )
+                    Insert( oldSlots[i].key, oldSlots[i].value );
+            }
+
+            SDL_free( oldSlots );
+            return true;
+        }
+
+        Slot*   slots;
+        Uint32  capacity;
+        Uint32  num;
+    };
+};
+
+#endif //!__SDL_HASHMAP_HPP__
@@ -0,0 +1,484 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_INSTANCE_CULLER_HPP__
+#define __SDL_INSTANCE_CULLER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+InstanceCuller
+==================================================================
+    Frustum culls instances on the GPU and writes the indirect draws
+    that render the visible ones, so building the draw list of 100k
+    instances costs no CPU time per frame.
+
+    The instance bounds ( a sphere and the index of the mesh drawn )
+    are uploaded once. Each mesh owns a range of the visible buffer,
+    as large as the number of its instances, and one indexed indirect
+    draw whose first_instance is the start of that range. Cull resets
+    the instance counts of the draws with a GPU copy, then a compute
+    shader tests every instance against the frustum, bumps the count of
+    its mesh's draw and writes the instance index at that slot of the
+    mesh's range.
+
+    SDL GPU has no draw count read from a buffer, so Draw issues one
+    draw per mesh; the draws of the meshes with no visible instance
+    have 0 instances. The visible and drawn mesh counts are written to
+    the counter buffer, to be read back for statistics.
+
+    The shader is GetShaderSource() ( HLSL ), compiled by the
+    application for its backend ( e.g. with SDL_shadercross ) and given
+    to Create. The vertex shader reads the instance index from the
+    visible buffer bound as an instance rate vertex buffer ( the
+    first_instance of each draw offsets it, SV_InstanceID does not ).
+    CullReference runs the same algorithm on the CPU for testing.
+
+    Example usage:
+        SDL::GPU::InstanceCuller culler;
+        culler.Create( device, cullCode, cullCodeSize, SDL_GPU_SHADERFORMAT_SPIRV );
+        culler.Upload( copyPass, instances, numInstances, meshes, numMeshes );
+        ...
+        // every frame
+        SDL::GPU::InstanceCuller::Frustum frustum;
+        SDL::GPU::InstanceCuller::ExtractFrustum( viewProjection, frustum );
+        culler.Cull( commandBuffer, frustum );
+        ...
+        SDL_GPUBufferBinding instanceIds = { culler.GetVisibleBuffer(), 0 };
+        renderPass.BindVertexBuffers( 1, &instanceIds, 1 );
+        culler.Draw( renderPass );
+==================================================================
+*/
+        class InstanceCuller
+        {
+        public:
+            static const Uint32 THREAD_COUNT = 64;
+
+            // 32 bytes, the layout of the shader's Instance
+            struct Instance
+            {
+                float   center[3];
+                float   radius;
+                Uint32  mesh;
+                Uint32  padding[3];
+            };
+
+            struct Mesh
+            {
+                Uint32  numIndices;
+                Uint32  firstIndex;
+                Sint32  vertexOffset;
+            };
+
+            // plane i is ( a, b, c, d ), a point is inside when a * x + b * y + c * z + d >= 0 for all six
+            struct Frustum
+            {
+                float   planes[6][4];
+            };
+
+            enum
+            {
+                COUNTER_VISIBLE_INSTANCES,
+                COUNTER_VISIBLE_MESHES,
+                COUNTER_COUNT
+            };
+
+            InstanceCuller( void ) : device( nullptr ), numInstances( 0 ), numMeshes( 0 ) {}
+            ~InstanceCuller( void ) { Destroy(); }
+
+            /// @brief The compute shader, to compile for the backend of the device.
+            static SDL_INLINE const char* GetShaderSource( void )
+            {
+                return
+                    "struct Instance { float4 sphere; uint mesh; uint3 padding; };\n"
+                    "struct DrawCommand { uint numIndices; uint numInstances; uint firstIndex; int vertexOffset; uint firstInstance; };\n"
+                    "StructuredBuffer<Instance> Instances : register( t0, space0 );\n"
+                    "RWStructuredBuffer<DrawCommand> Draws : register( u0, space1 );\n"
+                    "RWStructuredBuffer<uint> Visible : register( u1, space1 );\n"
+                    "RWStructuredBuffer<uint> Counters : register( u2, space1 );\n"
+                    "cbuffer Params : register( b0, space2 ) { float4 planes[6]; uint instanceCount; uint3 unused; };\n"
+                    "[numthreads( 64, 1, 1 )]\n"
+                    "void main( uint3 id : SV_DispatchThreadID )\n"
+                    "{\n"
+                    "    if ( id.x >= instanceCount )\n"
+                    "        return;\n"
+                    "    Instance instance = Instances[id.x];\n"
+                    "    for ( uint i = 0; i < 6; i++ )\n"
+                    "    {\n"
+                    "        if ( dot( planes[i].xyz, instance.sphere.xyz ) + planes[i].w < -instance.sphere.w )\n"
+                    "            return;\n"
+                    "    }\n"
+                    "    uint slot;\n"
+                    "    InterlockedAdd( Draws[instance.mesh].numInstances, 1, slot );\n"
+                    "    Visible[Draws[instance.mesh].firstInstance + slot] = id.x;\n"
+                    "    InterlockedAdd( Counters[0], 1 );\n"
+                    "    if ( slot == 0 )\n"
+                    "        InterlockedAdd( Counters[1], 1 );\n"
+                    "}\n";
+            }
+
+            /// @brief The resource layout of the shader, code and format are left to the caller.
+            static SDL_INLINE void GetPipelineInfo( SDL_GPUComputePipelineCreateInfo &info )
+            {
+                SDL_zero( info );
+                info.entrypoint = "main";
+                info.num_readonly_storage_buffers = 1;
+                info.num_readwrite_storage_buffers = 3;
+                info.num_uniform_buffers = 1;
+                info.threadcount_x = THREAD_COUNT;
+                info.threadcount_y = 1;
+                info.threadcount_z = 1;
+            }
+
+            /// @param code the compiled GetShaderSource(), in format.
+            SDL_INLINE bool Create( const Device &_device, const Uint8 *code, const size_t code_size, const SDL_GPUShaderFormat format )
+            {
+                Destroy();
+                SDL_GPUComputePipelineCreateInfo info;
+                GetPipelineInfo( info );
+                info.code = code;
+                info.code_size = code_size;
+                info.format = format;
+                if ( !pipeline.Create( _device, &info ) )
+                    return false;
+                device = &_device;
+                return true;
+            }
+
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+                ReleaseBuffers();
+                pipeline.Release( *device );
+                device = nullptr;
+            }
+
+            /// @brief Create the buffers and record the upload of the instances and of the draws.
+            /// @param instances the mesh of each must be below num_meshes.
+            SDL_INLINE bool Upload( const CopyPass &copyPass, const Instance *instances, const Uint32 num_instances, const Mesh *meshes, const Uint32 num_meshes )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "InstanceCuller: not created" );
+                if ( num_instances == 0 || num_meshes == 0 )
+                    return SDL_SetError( "InstanceCuller: nothing to cull" );
+
+                // the range of each mesh in the visible buffer
+                Array<SDL_GPUIndexedIndirectDrawCommand> draws;
+                if ( !draws.Resize( ( int )num_meshes ) )
+                    return SDL_OutOfMemory();
+                for ( Uint32 i = 0; i < num_meshes; i++ )
+                {
+                    SDL_GPUIndexedIndirectDrawCommand &draw = draws[( int )i];
+                    draw.num_indices = meshes[i].numIndices;
+                    draw.num_instances = 0;
+                    draw.first_index = meshes[i].firstIndex;
+                    draw.vertex_offset = meshes[i].vertexOffset;
+                    draw.first_instance = 0;
+                }
+                for ( Uint32 i = 0; i < num_instances; i++ )
+                {
+                    if ( instances[i].mesh >= num_meshes )
+                        return SDL_SetError( "InstanceCuller: instance %u uses mesh %u of %u", i, instances[i].mesh, num_meshes );
+                    draws[( int )instances[i].mesh].num_instances++;
+                }
+                Uint32 first = 0;
+                for ( Uint32 i = 0; i < num_meshes; i++ )
+                {
+                    SDL_GPUIndexedIndirectDrawCommand &draw = draws[( int )i];
+                    draw.first_instance = first;
+                    first += draw.num_instances;
+                    draw.num_instances = 0;
+                }
+
+                ReleaseBuffers();
+                const Uint32 instanceBytes = num_instances * ( Uint32 )sizeof( Instance );
+                const Uint32 drawBytes = num_meshes * ( Uint32 )sizeof( SDL_GPUIndexedIndirectDrawCommand );
+                const Uint32 counterBytes = COUNTER_COUNT * ( Uint32 )sizeof( Uint32 );
+                if ( !CreateBuffer( instanceBuffer, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, instanceBytes ) ||
+                     !CreateBuffer( resetBuffer, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, drawBytes + counterBytes ) ||
+                     !CreateBuffer( drawBuffer, SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, drawBytes ) ||
+                     !CreateBuffer( visibleBuffer, SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, num_instances * ( Uint32 )sizeof( Uint32 ) ) ||
+                     !CreateBuffer( counterBuffer, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, counterBytes ) )
+                {
+                    ReleaseBuffers();
+                    return false;
+                }
+
+                // instances, then the draws with no instance and zeroed counters, copied over the live ones by every Cull
+                SDL_GPUTransferBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                info.size = instanceBytes + drawBytes + counterBytes;
+                TransferBuffer staging;
+                if ( !staging.Create( *device, &info ) )
+                {
+                    ReleaseBuffers();
+                    return false;
+                }
+                Uint8 *data = static_cast<Uint8*>( staging.Map( *device, false ) );
+                if ( data == nullptr )
+                {
+                    staging.Release( *device );
+                    ReleaseBuffers();
+                    return false;
+                }
+                SDL_memcpy( data, instances, instanceBytes );
+                SDL_memcpy( data + instanceBytes, draws.Ptr(), drawBytes );
+                SDL_memset( data + instanceBytes + drawBytes, 0, counterBytes );
+                staging.Unmap( *device );
+
+                SDL_GPUTransferBufferLocation source;
+                source.transfer_buffer = staging;
+                source.offset = 0;
+                SDL_GPUBufferRegion destination;
+                destination.buffer = instanceBuffer;
+                destination.offset = 0;
+                destination.size = instanceBytes;
+                copyPass.UploadToBuffer( &source, &destination, false );
+                source.offset = instanceBytes;
+                destination.buffer = resetBuffer;
+                destination.size = drawBytes + counterBytes;
+                copyPass.UploadToBuffer( &source, &destination, false );
+                // released once the upload is done
+                staging.Release( *device );
+
+                numInstances = num_instances;
+                numMeshes = num_meshes;
+                return true;
+            }
+
+            /// @brief Record the upload of new bounds for a range of instances, their meshes must not change.
+            SDL_INLINE bool UpdateInstances( const CopyPass &copyPass, const Uint32 first, const Instance *instances, const Uint32 count )
+            {
+                if ( first + count > numInstances || count == 0 )
+                    return SDL_SetError( "InstanceCuller: invalid instance range" );
+
+                const Uint32 bytes = count * ( Uint32 )sizeof( Instance );
+                SDL_GPUTransferBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                info.size = bytes;
+                TransferBuffer staging;
+                if ( !staging.Create( *device, &info ) )
+                    return false;
+                void *data = staging.Map( *device, false );
+                if ( data == nullptr )
+                {
+                    staging.Release( *device );
+                    return false;
+                }
+                SDL_memcpy( data, instances, bytes );
+                staging.Unmap( *device );
+
+                SDL_GPUTransferBufferLocation source;
+                source.transfer_buffer = staging;
+                source.offset = 0;
+                SDL_GPUBufferRegion destination;
+                destination.buffer = instanceBuffer;
+                destination.offset = first * ( Uint32 )sizeof( Instance );
+                destination.size = bytes;
+                copyPass.UploadToBuffer( &source, &destination, false );
+                staging.Release( *device );
+                return true;
+            }
+
+            /// @brief Record the reset of the draws and the culling dispatch, outside of any pass.
+            SDL_INLINE bool Cull( const CommandBuffer &commandBuffer, const Frustum &frustum )
+            {
+                if ( numInstances == 0 )
+                    return SDL_SetError( "InstanceCuller: nothing uploaded" );
+
+                const Uint32 drawBytes = numMeshes * ( Uint32 )sizeof( SDL_GPUIndexedIndirectDrawCommand );
+                CopyPass copyPass;
+                if ( !copyPass.Begin( commandBuffer ) )
+                    return false;
+                SDL_GPUBufferLocation source;
+                SDL_GPUBufferLocation destination;
+                source.buffer = resetBuffer;
+                source.offset = 0;
+                destination.buffer = drawBuffer;
+                destination.offset = 0;
+                // cycled, the draws of the previous frame may still be read
+                copyPass.CopyBufferToBuffer( &source, &destination, drawBytes, true );
+                source.offset = drawBytes;
+                destination.buffer = counterBuffer;
+                copyPass.CopyBufferToBuffer( &source, &destination, COUNTER_COUNT * ( Uint32 )sizeof( Uint32 ), true );
+                copyPass.End();
+
+                SDL_GPUStorageBufferReadWriteBinding writes[3];
+                SDL_zero( writes );
+                writes[0].buffer = drawBuffer;
+                writes[1].buffer = visibleBuffer;
+                writes[1].cycle = true;
+                writes[2].buffer = counterBuffer;
+                ComputePass computePass;
+                if ( !computePass.Begin( commandBuffer, nullptr, 0, writes, 3 ) )
+                    return false;
+
+                Params params;
+                SDL_memcpy( params.planes, frustum.planes, sizeof( params.planes ) );
+                params.instanceCount = numInstances;
+                params.unused[0] = params.unused[1] = params.unused[2] = 0;
+                commandBuffer.PushComputeUniformData( 0, &params, sizeof( params ) );
+
+                SDL_GPUBuffer *reads[1] = { instanceBuffer };
+                pipeline.Bind( computePass );
+                computePass.BindComputeStorageBuffers( 0, reads, 1 );
+                computePass.DispatchGPUCompute( ( numInstances + THREAD_COUNT - 1 ) / THREAD_COUNT, 1, 1 );
+                computePass.End();
+                return true;
+            }
+
+            /// @brief Issue the draws written by the last Cull, with the pipeline, vertex and index buffers bound.
+            SDL_INLINE void Draw( const RenderPass &renderPass ) const
+            {
+                if ( numMeshes > 0 )
+                    renderPass.DrawGPUIndexedPrimitivesIndirect( drawBuffer, 0, numMeshes );
+            }
+
+            SDL_INLINE SDL_GPUBuffer* GetDrawBuffer( void ) const { return drawBuffer; }
+            SDL_INLINE SDL_GPUBuffer* GetVisibleBuffer( void ) const { return visibleBuffer; }
+            SDL_INLINE SDL_GPUBuffer* GetCounterBuffer( void ) const { return counterBuffer; }
+            SDL_INLINE Uint32 GetNumInstances( void ) const { return numInstances; }
+            SDL_INLINE Uint32 GetNumMeshes( void ) const { return numMeshes; }
+
+            /// @brief The frustum of a column major view projection matrix ( clip = m * v ), with a 0 to 1 depth range.
+            static SDL_INLINE void ExtractFrustum( const float m[16], Frustum &frustum )
+            {
+                // rows of the matrix
+                float row[4][4];
+                for ( int r = 0; r < 4; r++ )
+                {
+                    for ( int c = 0; c < 4; c++ )
+                        row[r][c] = m[c * 4 + r];
+                }
+                for ( int c = 0; c < 4; c++ )
+                {
+                    frustum.planes[0][c] = row[3][c] + row[0][c];   // left
+                    frustum.planes[1][c] = row[3][c] - row[0][c];   // right
+                    frustum.planes[2][c] = row[3][c] + row[1][c];   // bottom
+                    frustum.planes[3][c] = row[3][c] - row[1][c];   // top
+                    frustum.planes[4][c] = row[2][c];               // near
+                    frustum.planes[5][c] = row[3][c] - row[2][c];   // far
+                }
+                for ( int i = 0; i < 6; i++ )
+                {
+                    float *plane = frustum.planes[i];
+                    const float length = SDL_sqrtf( plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2] );
+                    if ( length > 0.0f )
+                    {
+                        for ( int c = 0; c < 4; c++ )
+                            plane[c] /= length;
+                    }
+                }
+            }
+
+            /// @brief The shader on the CPU, instances are written in index order within each mesh's range.
+            /// @param draws num_meshes draws, as Upload builds them, their instance counts are overwritten.
+            /// @param visible num_instances entries.
+            static SDL_INLINE void CullReference( const Instance *instances, const Uint32 num_instances, const Frustum &frustum,
+                                                  SDL_GPUIndexedIndirectDrawCommand *draws, const Uint32 num_meshes, Uint32 *visible, Uint32 counters[COUNTER_COUNT] )
+            {
+                for ( Uint32 i = 0; i < num_meshes; i++ )
+                    draws[i].num_instances = 0;
+                counters[COUNTER_VISIBLE_INSTANCES] = 0;
+                counters[COUNTER_VISIBLE_MESHES] = 0;
+
+                for ( Uint32 i = 0; i < num_instances; i++ )
+                {
+                    const Instance &instance = instances[i];
+                    bool inside = true;
+                    for ( int p = 0; p < 6 && inside; p++ )
+                    {
+                        const float *plane = frustum.planes[p];
+                        const float distance = plane[0] * instance.center[0] + plane[1] * instance.center[1] + plane[2] * instance.center[2] + plane[3];
+                        inside = distance >= -instance.radius;
+                    }
+                    if ( !inside )
+                        continue;
+
+                    SDL_GPUIndexedIndirectDrawCommand &draw = draws[instance.mesh];
+                    const Uint32 slot = draw.num_instances++;
+                    visible[draw.first_instance + slot] = i;
+                    counters[COUNTER_VISIBLE_INSTANCES]++;
+                    if ( slot == 0 )
+                        counters[COUNTER_VISIBLE_MESHES]++;
+                }
+            }
+
+        private:
+            InstanceCuller( const InstanceCuller & );
+            InstanceCuller &operator=( const InstanceCuller & );
+
+            // the shader's cbuffer Params
+            struct Params
+            {
+                float   planes[6][4];
+                Uint32  instanceCount;
+                Uint32  unused[3];
+            };
+
+            SDL_INLINE bool CreateBuffer( Buffer &buffer, const SDL_GPUBufferUsageFlags usage, const Uint32 size )
+            {
+                SDL_GPUBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = usage;
+                info.size = size;
+                return buffer.Create( *device, &info );
+            }
+
+            SDL_INLINE void ReleaseBuffers( void )
+            {
+                instanceBuffer.Release( *device );
+                resetBuffer.Release( *device );
+                drawBuffer.Release( *device );
+                visibleBuffer.Release( *device );
+                counterBuffer.Release( *device );
+                numInstances = 0;
+                numMeshes = 0;
+            }
+
+            const Device*       device;
+            ComputePipeline     pipeline;
+            Buffer              instanceBuffer;
+            Buffer              resetBuffer;        // the draws with no instance and zeroed counters
+            Buffer              drawBuffer;
+            Buffer              visibleBuffer;
+            Buffer              counterBuffer;
+            Uint32              numInstances;
+            Uint32              numMeshes;
+        };
+    }
+}
+#endif //!__SDL_INSTANCE_CULLER_HPP__
@@ -0,0 +1,488 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_INSTRUMENT_HPP__
+#define __SDL_INSTRUMENT_HPP__
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include "SDL_array.hpp"
+#include "SDL_iostream.hpp"
+
+/*
+==================================================================
+Render instrumentation
+==================================================================
+    Opt-in per-call instrumentation for SDL::Renderer and SDL::Texture.
+    Define SDL3PP_INSTRUMENT_RENDER before including SDL_render.hpp
+    ( or in the compiler command line ) to enable it. When it is not
+    defined the macros below expand to nothing and the wrappers are
+    the plain inline calls.
+
+    Every wrapped call is counted and timed with
+    SDL_GetPerformanceCounter. Counters are aggregated per frame, a
+    frame ends when Renderer::Present returns. Use SDL3PP_RENDER_ZONE
+    to mark call sites in your own code, the zones nest the wrapped
+    calls in the exported trace.
+
+    The recorder is not thread safe, record from the render thread only.
+
+    Example usage:
+        void DrawHUD( SDL::Renderer &renderer )
+        {
+            SDL3PP_RENDER_ZONE( "DrawHUD" );
+            renderer.RenderFillRects( rects, count );
+        }
+
+        SDL::Instrument::Recorder::Get().StartCapture( 1 << 20 );
+        ... // frames
+        SDL::Instrument::Recorder::Get().StopCapture();
+        SDL::Instrument::Recorder::Get().ExportChromeTrace( "render.json" );
+==================================================================
+*/
+#define SDL3PP_CONCAT_( a, b ) a##b
+#define SDL3PP_CONCAT( a, b ) SDL3PP_CONCAT_( a, b )
+
+#ifdef SDL3PP_INSTRUMENT_RENDER
+#define SDL3PP_RENDER_CALL( name, category ) \
+    static const Uint32 sdl3pp_call_id = ::SDL::Instrument::Recorder::Get().Register( name, ::SDL::Instrument::CALL_##category ); \
+    ::SDL::Instrument::CallScope sdl3pp_call_scope( sdl3pp_call_id, false )
+#define SDL3PP_RENDER_PRESENT( name ) \
+    static const Uint32 sdl3pp_call_id = ::SDL::Instrument::Recorder::Get().Register( name, ::SDL::Instrument::CALL_PRESENT ); \
+    ::SDL::Instrument::CallScope sdl3pp_call_scope( sdl3pp_call_id, true )
+#define SDL3PP_RENDER_ZONE( name ) \
+    static const Uint32 SDL3PP_CONCAT( sdl3pp_zone_id, __LINE__ ) = ::SDL::Instrument::Recorder::Get().Register( name, ::SDL::Instrument::CALL_ZONE ); \
+    ::SDL::Instrument::CallScope SDL3PP_CONCAT( sdl3pp_zone_scope, __LINE__ )( SDL3PP_CONCAT( sdl3pp_zone_id, __LINE__ ), false )
+#else
+#define SDL3PP_RENDER_CALL( name, category )
+#define SDL3PP_RENDER_PRESENT( name )
+#define SDL3PP_RENDER_ZONE( name )
+#endif //SDL3PP_INSTRUMENT_RENDER
+
+namespace SDL
+{
+    namespace Instrument
+    {
+        enum CallCategory
+        {
+            CALL_DRAW = 0,
+            CALL_STATE,
+            CALL_UPLOAD,
+            CALL_RESOURCE,
+            CALL_QUERY,
+            CALL_PRESENT,
+            CALL_ZONE,
+            CALL_CATEGORY_COUNT
+        };
+
+        static const char* const CallCategoryNames[CALL_CATEGORY_COUNT] =
+        {
+            "draw", "state", "upload", "resource", "query", "present", "zone"
+        };
+
+        // one entry per instrumented call site
+        struct CallStats
+        {
+            const char*     name;
+            CallCategory    category;
+            Uint64          totalCount;
+            Uint64          totalTicks;
+            Uint32          frameCount;
+            Uint64          frameTicks;
+            Uint32          lastFrameCount;
+            Uint64          lastFrameTicks;
+        };
+
+        // one timed call, only kept while capturing
+        struct Event
+        {
+            Uint32  id;
+            Uint32  depth;
+            Uint64  start;
+            Uint64  end;
+        };
+
+        struct FrameStats
+        {
+            Uint64  index;
+            Uint64  start;
+            Uint64  end;
+            Uint32  calls[CALL_CATEGORY_COUNT];
+            Uint64  ticks[CALL_CATEGORY_COUNT];
+        };
+
+/*
+==================================================================
+Recorder
+==================================================================
+*/
+        class Recorder
+        {
+        public:
+            static const int    HISTORY_SIZE = 256;
+            static const Uint32 BINARY_MAGIC = SDL_FOURCC( 'S', '3', 'P', 'I' );
+            static const Uint16 BINARY_VERSION = 1;
+
+            static SDL_INLINE Recorder& Get( void )
+            {
+                static Recorder recorder;
+                return recorder;
+            }
+
+            /// @brief Register a call site, called once per site by the macros.
+            /// @param name a string literal that outlives the recorder
+            /// @return the id used to record the call
+            SDL_INLINE Uint32 Register( const char *name, const CallCategory category )
+            {
+                CallStats stats;
+                SDL_zero( stats );
+                stats.name = name;
+                stats.category = category;
+                calls.Append( stats );
+                return ( Uint32 )calls.Num() - 1;
+            }
+
+            SDL_INLINE void Record( const Uint32 id, const Uint64 start, const Uint64 end, const Uint32 callDepth )
+            {
+                CallStats &stats = calls[id];
+                const Uint64 ticks = end - start;
+                stats.frameCount++;
+                stats.frameTicks += ticks;
+                stats.totalCount++;
+                stats.totalTicks += ticks;
+
+                current.calls[stats.category]++;
+                current.ticks[stats.category] += ticks;
+
+                if ( !capturing )
+                    return;
+
+                if ( events.Num() >= maxEvents )
+                {
+                    dropped++;
+                    return;
+                }
+
+                Event ev = { id, callDepth, start, end };
+                events.Append( ev );
+            }
+
+            /// @brief Close the current frame, called when Renderer::Present returns.
+            SDL_INLINE void EndFrame( const Uint64 now )
+            {
+                current.index = frameIndex++;
+                current.start = frameStart;
+                current.end = now;
+                history[current.index % HISTORY_SIZE] = current;
+                if ( capturing )
+                    capturedFrames.Append( current );
+
+                for ( int i = 0; i < calls.Num(); i++ )
+                {
+                    calls[i].lastFrameCount = calls[i].frameCount;
+                    calls[i].lastFrameTicks = calls[i].frameTicks;
+                    calls[i].frameCount = 0;
+                    calls[i].frameTicks = 0;
+                }
+
+                SDL_zero( current );
+                frameStart = now;
+            }
+
+            /// @brief Start keeping every timed call for export.
+            /// @param max_events events after this count are dropped, not recorded
+            SDL_INLINE void StartCapture( const int max_events )
+            {
+                events.Clear();
+                capturedFrames.Clear();
+                events.Reserve( max_events < 4096 ? max_events : 4096 );
+                maxEvents = max_events;
+                dropped = 0;
+                captureStart = SDL_GetPerformanceCounter();
+                capturing = true;
+            }
+
+            SDL_INLINE void StopCapture( void ) { capturing = false; }
+
+            /// @brief Drop all counters, history and captured events.
+            SDL_INLINE void Reset( void )
+            {
+                for ( int i = 0; i < calls.Num(); i++ )
+                {
+                    const char *name = calls[i].name;
+                    const CallCategory category = calls[i].category;
+                    SDL_zero( calls[i] );
+                    calls[i].name = name;
+                    calls[i].category = category;
+                }
+
+                events.Free();
+                capturedFrames.Free();
+                SDL_zero( current );
+                SDL_zeroa( history );
+                frameIndex = 0;
+                frameStart = SDL_GetPerformanceCounter();
+                dropped = 0;
+                capturing = false;
+            }
+
+            SDL_INLINE bool                 IsCapturing( void ) const { return capturing; }
+            SDL_INLINE Uint64               GetDroppedEvents( void ) const { return dropped; }
+            SDL_INLINE Uint64               GetFrequency( void ) const { return frequency; }
+            SDL_INLINE int                  NumCalls( void ) const { return calls.Num(); }
+            SDL_INLINE const CallStats&     GetCall( const int id ) const { return calls[id]; }
+            SDL_INLINE const FrameStats&    GetCurrentFrame( void ) const { return current; }
+            SDL_INLINE Uint64               NumFrames( void ) const { return frameIndex; }
+            SDL_INLINE Uint64               GetCaptureStart( void ) const { return captureStart; }
+
+            /// @brief Get a finished frame.
+            /// @param frames_ago 0 is the last presented frame, up to HISTORY_SIZE - 1
+            SDL_INLINE const FrameStats&    GetFrame( const int frames_ago ) const
+            {
+                return history[( frameIndex - 1 - frames_ago ) % HISTORY_SIZE];
+            }
+
+            SDL_INLINE double               TicksToMS( const Uint64 ticks ) const
+            {
+                return ( double )ticks * 1000.0 / ( double )frequency;
+            }
+
+            /// @brief Write the captured events as Chrome trace JSON ( chrome://tracing, Perfetto ).
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool ExportChromeTrace( IO::Stream &stream ) const
+            {
+                const double toUS = 1000000.0 / ( double )frequency;
+                bool ok = stream.printf( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" ) > 0;
+                bool first = true;
+
+                for ( int i = 0; ok && i < capturedFrames.Num(); i++ )
+                {
+                    const FrameStats &frame = capturedFrames[i];
+                    const double ts = RelativeTicks( frame.start ) * toUS;
+                    ok = stream.printf( "%s{\"name\":\"frame %" SDL_PRIu64 "\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}",
+                        first ? "" : ",\n", frame.index, ts, ( double )( frame.end - frame.start ) * toUS ) > 0;
+                    first = false;
+
+                    ok = ok && stream.printf( ",\n{\"name\":\"calls\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"args\":{", ts ) > 0;
+                    for ( int c = 0; ok && c < CALL_ZONE; c++ )
+                        ok = stream.printf( "%s\"%s\":%u", c ? "," : "", CallCategoryNames[c], frame.calls[c] ) > 0;
+                    ok = ok && stream.printf( "}}" ) > 0;
+                }
+
+                for ( int i = 0; ok && i < events.Num(); i++ )
+                {
+                    const Event &ev = events[i];
+                    const CallStats &stats = calls[ev.id];
+                    ok = stream.printf( "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":1}",
+                        first ? "" : ",\n", stats.name, CallCategoryNames[stats.category],
+                        RelativeTicks( ev.start ) * toUS, ( double )( ev.end - ev.start ) * toUS ) > 0;
+                    first = false;
+                }
+
+                ok = ok && stream.printf( "\n]}\n" ) > 0;
+                if ( !ok )
+                    return SDL_SetError( "Instrument: failed to write the chrome trace" );
+                return true;
+            }
+
+            SDL_INLINE bool ExportChromeTrace( const char *path ) const
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "w" ) )
+                    return false;
+                const bool ok = ExportChromeTrace( stream );
+                return stream.Close() && ok;
+            }
+
+            /*
+                Binary log layout, all integers little endian, "var" is a
+                LEB128 varint and "zig" a zigzag encoded varint:
+                    u32 magic 'S3PI', u16 version, u64 ticks per second
+                    var call count, per call: u8 category, var name length, name bytes
+                    var event count, per event: var id, var depth,
+                        zig start delta from the previous event start, var duration
+                    var frame count, per frame: var index, zig start delta
+                        from the previous frame start, var duration,
+                        CALL_CATEGORY_COUNT x ( var calls, var ticks )
+                Times are in ticks relative to the capture start.
+            */
+            /// @brief Write the captured events as a compact binary log.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool ExportBinary( IO::Stream &stream ) const
+            {
+                Array<Uint8> buffer;
+                buffer.Reserve( 64 + events.Num() * 8 + capturedFrames.Num() * 32 );
+
+                WriteVar( buffer, ( Uint64 )calls.Num() );
+                for ( int i = 0; i < calls.Num(); i++ )
+                {
+                    const size_t len = SDL_strlen( calls[i].name );
+                    buffer.Append( ( Uint8 )calls[i].category );
+                    WriteVar( buffer, len );
+                    Uint8 *dst = buffer.AppendUninitialized( ( int )len );
+                    if ( dst != nullptr )
+                        SDL_memcpy( dst, calls[i].name, len );
+                }
+
+                Uint64 previous = captureStart;
+                WriteVar( buffer, ( Uint64 )events.Num() );
+                for ( int i = 0; i < events.Num(); i++ )
+                {
+                    const Event &ev = events[i];
+                    WriteVar( buffer, ev.id );
+                    WriteVar( buffer, ev.depth );
+                    WriteZig( buffer, ( Sint64 )( ev.start - previous ) );
+                    WriteVar( buffer, ev.end - ev.start );
+                    previous = ev.start;
+                }
+
+                previous = captureStart;
+                WriteVar( buffer, ( Uint64 )capturedFrames.Num() );
+                for ( int i = 0; i < capturedFrames.Num(); i++ )
+                {
+                    const FrameStats &frame = capturedFrames[i];
+                    WriteVar( buffer, frame.index );
+                    WriteZig( buffer, ( Sint64 )( frame.start - previous ) );
+                    WriteVar( buffer, frame.end - frame.start );
+                    for ( int c = 0; c < CALL_CATEGORY_COUNT; c++ )
+                    {
+                        WriteVar( buffer, frame.calls[c] );
+                        WriteVar( buffer, frame.ticks[c] );
+                    }
+                    previous = frame.start;
+                }
+
+                if ( !stream.WriteU32LE( BINARY_MAGIC ) || !stream.WriteU16LE( BINARY_VERSION ) || !stream.WriteU64LE( frequency ) )
+                    return false;
+
+                return stream.Write( buffer.Ptr(), buffer.Size() ) == buffer.Size();
+            }
+
+            SDL_INLINE bool ExportBinary( const char *path ) const
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "wb" ) )
+                    return false;
+                const bool ok = ExportBinary( stream );
+                return stream.Close() && ok;
+            }
+
+            // current nesting level of the call scopes
+            Uint32  depth;
+
+        private:
+            Recorder( void ) :
+                depth( 0 ),
+                frequency( SDL_GetPerformanceFrequency() ),
+                frameIndex( 0 ),
+                frameStart( SDL_GetPerformanceCounter() ),
+                captureStart( 0 ),
+                maxEvents( 0 ),
+                dropped( 0 ),
+                capturing( false )
+            {
+                SDL_zero( current );
+                SDL_zeroa( history );
+            }
+
+            ~Recorder( void ) {}
+
+            SDL_INLINE double RelativeTicks( const Uint64 ticks ) const
+            {
+                return ticks > captureStart ? ( double )( ticks - captureStart ) : 0.0;
+            }
+
+            static SDL_INLINE void WriteVar( Array<Uint8> &buffer, Uint64 value )
+            {
+                while ( value >= 0x80 )
+                {
+                    buffer.Append( ( Uint8 )( value | 0x80 ) );
+                    value >>= 7;
+                }
+                buffer.Append( ( Uint8 )value );
+            }
+
+            static SDL_INLINE void WriteZig( Array<Uint8> &buffer, const Sint64 value )
+            {
+                WriteVar( buffer, ( ( Uint64 )value << 1 ) ^ ( Uint64 )( value >> 63 ) );
+            }
+
+            Uint64              frequency;
+            Uint64              frameIndex;
+            Uint64              frameStart;
+            Uint64              captureStart;
+            int                 maxEvents;
+            Uint64              dropped;
+            bool                capturing;
+            Array<CallStats>    calls;
+            Array<Event>        events;
+            Array<FrameStats>   capturedFrames;
+            FrameStats          current;
+            FrameStats          history[HISTORY_SIZE];
+        };
+
+/*
+==================================================================
+CallScope
+==================================================================
+    Times the enclosing block and records it in the Recorder. Used by
+    the SDL3PP_RENDER_* macros, the present scope also ends the frame.
+==================================================================
+*/
+        class CallScope
+        {
+        public:
+            CallScope( const Uint32 call_id, const bool end_frame ) :
+                recorder( Recorder::Get() ),
+                id( call_id ),
+                endFrame( end_frame ),
+                start( SDL_GetPerformanceCounter() )
+            {
+                recorder.depth++;
+            }
+
+            ~CallScope( void )
+            {
+                const Uint64 end = SDL_GetPerformanceCounter();
+                recorder.depth--;
+                recorder.Record( id, start, end, recorder.depth );
+                if ( endFrame )
+                    recorder.EndFrame( end );
+            }
+
+        private:
+            CallScope( const CallScope &ref );
+            CallScope& operator=( const CallScope &ref );
+
+            Recorder&   recorder;
+            Uint32      id;
+            bool        endFrame;
+            Uint64      start;
+        };
+    };
+};
+
+#endif //!__SDL_INSTRUMENT_HPP__
@@ -0,0 +1,707 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_MESH_OPTIMIZER_HPP__
+#define __SDL_MESH_OPTIMIZER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_half.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+MeshOptimizer
+==================================================================
+    Prepares imported meshes for upload: triangle order for the post
+    transform vertex cache and for overdraw, vertex order for fetch
+    locality, and attributes packed into 16 bit formats.
+
+    OptimizeVertexCache reorders the triangles with Tipsify ( Sander,
+    Nehab and Barczak 2007 ): it fans around the vertices still in a
+    simulated FIFO cache and jumps to a recent dead end when none is
+    left, in linear time. OptimizeOverdraw then splits that order
+    into clusters where the cache restarts, splits them further while
+    the vertex cache efficiency stays within a threshold, and draws
+    the clusters facing away from the mesh center first, as they are
+    the likely occluders. OptimizeVertexFetch renumbers the vertices
+    in the order the indices first use them, so the vertex fetch
+    walks the buffer forward, and drops unused vertices.
+
+    AnalyzeVertexCache simulates a FIFO cache and reports ACMR ( the
+    vertices transformed per triangle, 0.5 at best, 3 at worst ) and
+    ATVR ( per vertex, 1 at best ). The optimizations keep the ACMR
+    before and after in the stats.
+
+    QuantizeVertices packs float attributes into half floats or 16 bit
+    normalized integers and fills the SDL_GPUVertexAttribute of each.
+    Normalized formats take values in 0..1 ( or -1..1 ), positions
+    are mapped to that range by the caller.
+
+    Index buffers are Uint16 or Uint32 lists of triangles. Scratch
+    memory is kept between calls, so one optimizer processes many
+    meshes without reallocating. Not thread safe, use one per thread.
+
+    Example usage:
+        SDL::GPU::MeshOptimizer optimizer;
+        optimizer.OptimizeVertexCache( indices, indices, numIndices, numVertices );
+        optimizer.OptimizeOverdraw( indices, indices, numIndices, &vertices[0].x, numVertices, sizeof( Vertex ) );
+        numVertices = optimizer.OptimizeVertexFetch( fetched, indices, numIndices, vertices, numVertices, sizeof( Vertex ) );
+        SDL_Log( "ACMR %.3f -> %.3f", optimizer.GetStats().acmrBefore, optimizer.GetStats().acmrAfter );
+        ...
+        SDL::GPU::MeshOptimizer::QuantizeAttribute attributes[] =
+        {
+            { 0, offsetof( Vertex, x ), 3, SDL::GPU::MeshOptimizer::QUANTIZE_HALF },
+            { 1, offsetof( Vertex, nx ), 3, SDL::GPU::MeshOptimizer::QUANTIZE_SNORM16 },
+            { 2, offsetof( Vertex, u ), 2, SDL::GPU::MeshOptimizer::QUANTIZE_UNORM16 }
+        };
+        SDL_GPUVertexAttribute vertexAttributes[3];
+        const Uint32 pitch = SDL::GPU::MeshOptimizer::QuantizeVertices( packed, fetched, numVertices, sizeof( Vertex ), attributes, 3, vertexAttributes, 0 );
+==================================================================
+*/
+        class MeshOptimizer
+        {
+        public:
+            static const Uint32 DEFAULT_CACHE_SIZE = 16;
+            static const Uint32 INVALID_INDEX = 0xffffffff;
+
+            enum Quantize
+            {
+                QUANTIZE_FLOAT,         // copied as is
+                QUANTIZE_HALF,
+                QUANTIZE_UNORM16,       // 0..1
+                QUANTIZE_SNORM16        // -1..1
+            };
+
+            struct QuantizeAttribute
+            {
+                Uint32      location;
+                Uint32      offset;         // of the floats in the source vertex
+                Uint32      components;     // 1 to 4, 16 bit formats are padded to 2 or 4
+                Quantize    quantize;
+            };
+
+            struct CacheStats
+            {
+                float   acmr;           // vertices transformed per triangle
+                float   atvr;           // vertices transformed per vertex used
+                Uint32  transforms;
+            };
+
+            struct Stats
+            {
+                float   acmrBefore;
+                float   acmrAfter;
+                Uint32  clusters;       // of the last OptimizeOverdraw
+                Uint32  verticesBefore; // of the last OptimizeVertexFetch
+                Uint32  verticesAfter;
+            };
+
+            MeshOptimizer( void ) { SDL_zero( stats ); }
+            ~MeshOptimizer( void ) {}
+
+            /// @brief Reorder the triangles for a FIFO post transform cache of cache_size vertices.
+            /// @param destination receives index_count indices, it can be indices.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            template<typename t_>
+            SDL_INLINE bool OptimizeVertexCache( t_ *destination, const t_ *indices, const Uint32 index_count, const Uint32 vertex_count, const Uint32 cache_size = DEFAULT_CACHE_SIZE )
+            {
+                if ( !Load( indices, index_count, vertex_count ) )
+                    return false;
+                if ( cache_size < 3 )
+                    return SDL_SetError( "MeshOptimizer: cache size %u is too small", cache_size );
+
+                stats.acmrBefore = Analyze( work.Ptr(), index_count, vertex_count, cache_size ).acmr;
+                if ( !Tipsify( index_count, vertex_count, cache_size ) )
+                    return false;
+                stats.acmrAfter = Analyze( result.Ptr(), index_count, vertex_count, cache_size ).acmr;
+                Store( destination, index_count );
+                return true;
+            }
+
+            /// @brief Reorder clusters of triangles of a vertex cache optimized list to reduce overdraw.
+            /// @param positions the first float of the x, y, z position of vertex 0.
+            /// @param stride bytes from one position to the next.
+            /// @param threshold how much worse the ACMR of a cluster may get by splitting it.
+            template<typename t_>
+            SDL_INLINE bool OptimizeOverdraw( t_ *destination, const t_ *indices, const Uint32 index_count, const float *positions, const Uint32 vertex_count, const Uint32 stride,
+                                              const float threshold = 1.05f, const Uint32 cache_size = DEFAULT_CACHE_SIZE )
+            {
+                if ( !Load( indices, index_count, vertex_count ) )
+                    return false;
+                if ( positions == nullptr || stride < sizeof( float ) * 3 || ( stride % sizeof( float ) ) != 0 )
+                    return SDL_SetError( "MeshOptimizer: invalid positions" );
+                if ( cache_size < 3 )
+                    return SDL_SetError( "MeshOptimizer: cache size %u is too small", cache_size );
+
+                stats.acmrBefore = Analyze( work.Ptr(), index_count, vertex_count, cache_size ).acmr;
+                if ( !SortClusters( index_count, positions, stride / ( Uint32 )sizeof( float ), vertex_count, threshold, cache_size ) )
+                    return false;
+                stats.acmrAfter = Analyze( result.Ptr(), index_count, vertex_count, cache_size ).acmr;
+                Store( destination, index_count );
+                return true;
+            }
+
+            /// @brief Number the vertices in order of first use, unused vertices get INVALID_INDEX.
+            /// @param remap receives vertex_count entries, old vertex to new vertex.
+            /// @return the number of vertices used.
+            template<typename t_>
+            static SDL_INLINE Uint32 BuildFetchRemap( Uint32 *remap, const t_ *indices, const Uint32 index_count, const Uint32 vertex_count )
+            {
+                SDL_memset( remap, 0xff, sizeof( Uint32 ) * vertex_count );
+                Uint32 next = 0;
+                for ( Uint32 i = 0; i < index_count; i++ )
+                {
+                    const Uint32 v = indices[i];
+                    if ( v < vertex_count && remap[v] == INVALID_INDEX )
+                        remap[v] = next++;
+                }
+                return next;
+            }
+
+            /// @brief Apply a remap to an index list, destination can be indices.
+            template<typename t_>
+            static SDL_INLINE void RemapIndices( t_ *destination, const t_ *indices, const Uint32 index_count, const Uint32 *remap )
+            {
+                for ( Uint32 i = 0; i < index_count; i++ )
+                    destination[i] = ( t_ )remap[indices[i]];
+            }
+
+            /// @brief Apply a remap to a vertex stream, destination must not overlap vertices.
+            static SDL_INLINE void RemapVertices( void *destination, const void *vertices, const Uint32 vertex_count, const Uint32 vertex_size, const Uint32 *remap )
+            {
+                Uint8 *dst = static_cast<Uint8*>( destination );
+                const Uint8 *src = static_cast<const Uint8*>( vertices );
+                for ( Uint32 v = 0; v < vertex_count; v++ )
+                {
+                    if ( remap[v] != INVALID_INDEX )
+                        SDL_memcpy( dst + ( size_t )remap[v] * vertex_size, src + ( size_t )v * vertex_size, vertex_size );
+                }
+            }
+
+            /// @brief Reorder the vertices in order of first use and rewrite the indices in place.
+            /// @param destination receives the used vertices, it must not overlap vertices.
+            /// @return the number of vertices written, 0 on failure; GetRemap() gives the table for other streams.
+            template<typename t_>
+            SDL_INLINE Uint32 OptimizeVertexFetch( void *destination, t_ *indices, const Uint32 index_count, const void *vertices, const Uint32 vertex_count, const Uint32 vertex_size )
+            {
+                if ( destination == nullptr || vertices == nullptr || vertex_size == 0 || !Validate( indices, index_count, vertex_count ) )
+                    return 0;
+                if ( !remap.Resize( ( int )vertex_count ) )
+                {
+                    SDL_OutOfMemory();
+                    return 0;
+                }
+
+                const Uint32 used = BuildFetchRemap( remap.Ptr(), indices, index_count, vertex_count );
+                RemapIndices( indices, indices, index_count, remap.Ptr() );
+                RemapVertices( destination, vertices, vertex_count, vertex_size, remap.Ptr() );
+                stats.verticesBefore = vertex_count;
+                stats.verticesAfter = used;
+                return used;
+            }
+
+            /// @brief Simulate a FIFO post transform cache over an index list.
+            template<typename t_>
+            SDL_INLINE CacheStats AnalyzeVertexCache( const t_ *indices, const Uint32 index_count, const Uint32 vertex_count, const Uint32 cache_size = DEFAULT_CACHE_SIZE )
+            {
+                CacheStats cache;
+                SDL_zero( cache );
+                if ( Load( indices, index_count, vertex_count ) )
+                    cache = Analyze( work.Ptr(), index_count, vertex_count, cache_size );
+                return cache;
+            }
+
+            /// @brief Pack float attributes into 16 bit formats, 4 byte aligned.
+            /// @param destination receives vertex_count vertices of the returned pitch.
+            /// @param out_attributes receives num_attributes attribute descriptions on buffer_slot.
+            /// @return the pitch of the packed vertices, 0 on failure.
+            static SDL_INLINE Uint32 QuantizeVertices( void *destination, const void *vertices, const Uint32 vertex_count, const Uint32 stride,
+                                                       const QuantizeAttribute *attributes, const Uint32 num_attributes, SDL_GPUVertexAttribute *out_attributes, const Uint32 buffer_slot )
+            {
+                Uint32 pitch = 0;
+                for ( Uint32 a = 0; a < num_attributes; a++ )
+                {
+                    const QuantizeAttribute &attribute = attributes[a];
+                    if ( attribute.components < 1 || attribute.components > 4 || attribute.offset + attribute.components * sizeof( float ) > stride )
+                    {
+                        SDL_SetError( "MeshOptimizer: invalid attribute %u", a );
+                        return 0;
+                    }
+                    out_attributes[a].location = attribute.location;
+                    out_attributes[a].buffer_slot = buffer_slot;
+                    out_attributes[a].format = GetFormat( attribute );
+                    out_attributes[a].offset = pitch;
+                    pitch += GetSize( attribute );
+                }
+
+                Uint8 *dst = static_cast<Uint8*>( destination );
+                const Uint8 *src = static_cast<const Uint8*>( vertices );
+                for ( Uint32 v = 0; v < vertex_count; v++, src += stride )
+                {
+                    for ( Uint32 a = 0; a < num_attributes; a++ )
+                    {
+                        const QuantizeAttribute &attribute = attributes[a];
+                        float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                        SDL_memcpy( value, src + attribute.offset, attribute.components * sizeof( float ) );
+
+                        if ( attribute.quantize == QUANTIZE_FLOAT )
+                        {
+                            SDL_memcpy( dst, value, attribute.components * sizeof( float ) );
+                            dst += attribute.components * sizeof( float );
+                            continue;
+                        }
+
+                        Uint16 packed[4];
+                        const Uint32 count = attribute.components <= 2 ? 2 : 4;
+                        for ( Uint32 c = 0; c < count; c++ )
+                        {
+                            if ( attribute.quantize == QUANTIZE_HALF )
+                                packed[c] = FloatToHalf( value[c] );
+                            else if ( attribute.quantize == QUANTIZE_UNORM16 )
+                                packed[c] = QuantizeUnorm16( value[c] );
+                            else
+                                packed[c] = ( Uint16 )QuantizeSnorm16( value[c] );
+                        }
+                        SDL_memcpy( dst, packed, count * sizeof( Uint16 ) );
+                        dst += count * sizeof( Uint16 );
+                    }
+                }
+                return pitch;
+            }
+
+            static SDL_INLINE Uint16 QuantizeUnorm16( const float value )
+            {
+                const float clamped = value < 0.0f ? 0.0f : ( value > 1.0f ? 1.0f : value );
+                return ( Uint16 )( clamped * 65535.0f + 0.5f );
+            }
+
+            static SDL_INLINE Sint16 QuantizeSnorm16( const float value )
+            {
+                const float clamped = value < -1.0f ? -1.0f : ( value > 1.0f ? 1.0f : value );
+                const float scaled = clamped * 32767.0f;
+                return ( Sint16 )( scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f );
+            }
+
+            SDL_INLINE const Uint32* GetRemap( void ) const { return remap.Ptr(); }
+
+            SDL_INLINE Stats GetStats( void ) const { return stats; }
+
+        private:
+            MeshOptimizer( const MeshOptimizer & );
+            MeshOptimizer &operator=( const MeshOptimizer & );
+
+            struct Cluster
+            {
+                Uint32  first;      // first triangle
+                Uint32  count;
+                float   sortKey;
+            };
+
+            template<typename t_>
+            static SDL_INLINE bool Validate( const t_ *indices, const Uint32 index_count, const Uint32 vertex_count )
+            {
+                if ( ( indices == nullptr && index_count > 0 ) || ( index_count % 3 ) != 0 || index_count > 0x7fffffff || vertex_count > 0x7fffffff )
+                    return SDL_SetError( "MeshOptimizer: invalid index list of %u indices", index_count );
+                for ( Uint32 i = 0; i < index_count; i++ )
+                {
+                    if ( ( Uint32 )indices[i] >= vertex_count )
+                        return SDL_SetError( "MeshOptimizer: index %u is out of %u vertices", ( Uint32 )indices[i], vertex_count );
+                }
+                return true;
+            }
+
+            // copy the indices to work, so the destination may be the source
+            template<typename t_>
+            SDL_INLINE bool Load( const t_ *indices, const Uint32 index_count, const Uint32 vertex_count )
+            {
+                if ( !Validate( indices, index_count, vertex_count ) )
+                    return false;
+                if ( !work.Resize( ( int )index_count ) || !result.Resize( ( int )index_count ) )
+                    return SDL_OutOfMemory();
+                for ( Uint32 i = 0; i < index_count; i++ )
+                    work[( int )i] = indices[i];
+                return true;
+            }
+
+            template<typename t_>
+            SDL_INLINE void Store( t_ *destination, const Uint32 index_count ) const
+            {
+                for ( Uint32 i = 0; i < index_count; i++ )
+                    destination[i] = ( t_ )result[( int )i];
+            }
+
+            SDL_INLINE CacheStats Analyze( const Uint32 *indices, const Uint32 index_count, const Uint32 vertex_count, const Uint32 cache_size )
+            {
+                CacheStats cache;
+                SDL_zero( cache );
+                if ( index_count == 0 || !cacheTime.Resize( ( int )vertex_count ) )
+                    return cache;
+
+                // a vertex is cached while fewer than cache_size misses followed its own
+                SDL_memset( cacheTime.Ptr(), 0, cacheTime.Size() );
+                Uint32 time = cache_size + 1;
+                Uint32 used = 0;
+                for ( Uint32 i = 0; i < index_count; i++ )
+                {
+                    Uint32 &stamp = cacheTime[( int )indices[i]];
+                    if ( stamp == 0 )
+                        used++;
+                    if ( time - stamp > cache_size )
+                    {
+                        stamp = time++;
+                        cache.transforms++;
+                    }
+                }
+                cache.acmr = ( float )cache.transforms / ( float )( index_count / 3 );
+                cache.atvr = ( float )cache.transforms / ( float )used;
+                return cache;
+            }
+
+            // triangles of each vertex, as a counting sort of the index list
+            SDL_INLINE bool BuildAdjacency( const Uint32 index_count, const Uint32 vertex_count )
+            {
+                if ( !offsets.Resize( ( int )vertex_count + 1 ) || !adjacency.Resize( ( int )index_count ) || !live.Resize( ( int )vertex_count ) )
+                    return SDL_OutOfMemory();
+
+                SDL_memset( live.Ptr(), 0, live.Size() );
+                for ( Uint32 i = 0; i < index_count; i++ )
+                    live[( int )work[( int )i]]++;
+                Uint32 sum = 0;
+                for ( Uint32 v = 0; v < vertex_count; v++ )
+                {
+                    offsets[( int )v] = sum;
+                    sum += live[( int )v];
+                }
+                offsets[( int )vertex_count] = sum;
+                for ( Uint32 i = 0; i < index_count; i++ )
+                {
+                    const Uint32 v = work[( int )i];
+                    adjacency[( int )offsets[( int )v]++] = i / 3;
+                }
+                for ( Uint32 v = 0; v < vertex_count; v++ )
+                    offsets[( int )v] -= live[( int )v];
+                return true;
+            }
+
+            SDL_INLINE bool Tipsify( const Uint32 index_count, const Uint32 vertex_count, const Uint32 cache_size )
+            {
+                const Uint32 numTriangles = index_count / 3;
+                if ( numTriangles == 0 )
+                    return true;
+                if ( !BuildAdjacency( index_count, vertex_count ) || !cacheTime.Resize( ( int )vertex_count ) || !emitted.Resize( ( int )numTriangles )
+                    || !deadEnd.Reserve( ( int )index_count ) || !candidates.Reserve( 64 ) )
+                    return SDL_OutOfMemory();
+
+                SDL_memset( cacheTime.Ptr(), 0, cacheTime.Size() );
+                SDL_memset( emitted.Ptr(), 0, emitted.Size() );
+                deadEnd.Clear();
+
+                Uint32 time = cache_size + 1;
+                Uint32 cursor = 0;
+                Uint32 out = 0;
+                Uint32 fan = NextLive( cursor, vertex_count );
+                while ( fan != INVALID_INDEX )
+                {
+                    candidates.Clear();
+                    for ( Uint32 a = offsets[( int )fan]; a < offsets[( int )fan + 1]; a++ )
+                    {
+                        const Uint32 t = adjacency[( int )a];
+                        if ( emitted[( int )t] )
+                            continue;
+                        emitted[( int )t] = 1;
+                        for ( Uint32 c = 0; c < 3; c++ )
+                        {
+                            const Uint32 v = work[( int )( t * 3 + c )];
+                            result[( int )out++] = v;
+                            deadEnd.Append( v );
+                            candidates.Append( v );
+                            live[( int )v]--;
+                            if ( time - cacheTime[( int )v] > cache_size )
+                                cacheTime[( int )v] = time++;
+                        }
+                    }
+
+                    // the candidate that stays in the cache after its remaining triangles, and entered it first
+                    fan = INVALID_INDEX;
+                    Uint32 best = 0;
+                    for ( int i = 0; i < candidates.Num(); i++ )
+                    {
+                        const Uint32 v = candidates[i];
+                        if ( live[( int )v] == 0 )
+                            continue;
+                        Uint32 priority = 0;
+                        if ( time - cacheTime[( int )v] + 2 * live[( int )v] <= cache_size )
+                            priority = time - cacheTime[( int )v];
+                        if ( fan == INVALID_INDEX || priority > best )
+                        {
+                            fan = v;
+                            best = priority;
+                        }
+                    }
+
+                    // dead end: the most recent vertex with triangles left, then the next one in order
+                    while ( fan == INVALID_INDEX && deadEnd.Num() > 0 )
+                    {
+                        const Uint32 v = deadEnd.Last();
+                        deadEnd.Resize( deadEnd.Num() - 1 );
+                        if ( live[( int )v] > 0 )
+                            fan = v;
+                    }
+                    if ( fan == INVALID_INDEX )
+                        fan = NextLive( cursor, vertex_count );
+                }
+                return true;
+            }
+
+            SDL_INLINE Uint32 NextLive( Uint32 &cursor, const Uint32 vertex_count ) const
+            {
+                while ( cursor < vertex_count )
+                {
+                    if ( live[( int )cursor] > 0 )
+                        return cursor;
+                    cursor++;
+                }
+                return INVALID_INDEX;
+            }
+
+            SDL_INLINE bool SortClusters( const Uint32 index_count, const float *positions, const Uint32 stride, const Uint32 vertex_count, const float threshold, const Uint32 cache_size )
+            {
+                const Uint32 numTriangles = index_count / 3;
+                clusters.Clear();
+                stats.clusters = 0;
+                if ( numTriangles == 0 )
+                    return true;
+                if ( !cacheTime.Resize( ( int )vertex_count ) )
+                    return SDL_OutOfMemory();
+
+                // hard boundaries where the cache restarts: a triangle missing all its vertices
+                hard.Clear();
+                SDL_memset( cacheTime.Ptr(), 0, cacheTime.Size() );
+                Uint32 time = cache_size + 1;
+                Uint32 start = 0;
+                for ( Uint32 t = 0; t < numTriangles; t++ )
+                {
+                    const Uint32 misses = Transform( &work[( int )( t * 3 )], time, cache_size );
+                    if ( misses == 3 && t > start )
+                    {
+                        if ( !AppendCluster( hard, start, t - start ) )
+                            return false;
+                        start = t;
+                    }
+                }
+                if ( !AppendCluster( hard, start, numTriangles - start ) )
+                    return false;
+                for ( int i = 0; i < hard.Num(); i++ )
+                {
+                    if ( !SplitCluster( hard[i].first, hard[i].count, threshold, time, cache_size ) )
+                        return false;
+                }
+
+                float center[3] = { 0.0f, 0.0f, 0.0f };
+                float area = 0.0f;
+                for ( Uint32 t = 0; t < numTriangles; t++ )
+                    AccumulateTriangle( &work[( int )( t * 3 )], positions, stride, center, nullptr, area );
+                if ( area > 0.0f )
+                {
+                    for ( int c = 0; c < 3; c++ )
+                        center[c] /= area;
+                }
+
+                for ( int i = 0; i < clusters.Num(); i++ )
+                {
+                    Cluster &cluster = clusters[i];
+                    float centroid[3] = { 0.0f, 0.0f, 0.0f };
+                    float normal[3] = { 0.0f, 0.0f, 0.0f };
+                    float clusterArea = 0.0f;
+                    for ( Uint32 t = cluster.first; t < cluster.first + cluster.count; t++ )
+                        AccumulateTriangle( &work[( int )( t * 3 )], positions, stride, centroid, normal, clusterArea );
+
+                    cluster.sortKey = 0.0f;
+                    const float length = SDL_sqrtf( normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] );
+                    if ( clusterArea > 0.0f && length > 0.0f )
+                    {
+                        for ( int c = 0; c < 3; c++ )
+                            cluster.sortKey += ( centroid[c] / clusterArea - center[c] ) * normal[c] / length;
+                    }
+                }
+                SDL_qsort( clusters.Ptr(), ( size_t )clusters.Num(), sizeof( Cluster ), CompareCluster );
+
+                Uint32 out = 0;
+                for ( int i = 0; i < clusters.Num(); i++ )
+                {
+                    const Cluster &cluster = clusters[i];
+                    SDL_memcpy( &result[( int )out], &work[( int )( cluster.first * 3 )], sizeof( Uint32 ) * cluster.count * 3 );
+                    out += cluster.count * 3;
+                }
+                stats.clusters = ( Uint32 )clusters.Num();
+                return true;
+            }
+
+            // cache misses of one triangle
+            SDL_INLINE Uint32 Transform( const Uint32 *triangle, Uint32 &time, const Uint32 cache_size )
+            {
+                Uint32 misses = 0;
+                for ( int c = 0; c < 3; c++ )
+                {
+                    Uint32 &stamp = cacheTime[( int )triangle[c]];
+                    if ( time - stamp > cache_size )
+                    {
+                        stamp = time++;
+                        misses++;
+                    }
+                }
+                return misses;
+            }
+
+            // empty the simulated cache: every earlier stamp is a miss once time moves past the cache size,
+            // the stamps are only cleared when time could wrap onto them
+            SDL_INLINE void ColdCache( Uint32 &time, const Uint32 cache_size )
+            {
+                if ( time >= 0x7fffffffu )
+                {
+                    SDL_memset( cacheTime.Ptr(), 0, cacheTime.Size() );
+                    time = 0;
+                }
+                time += cache_size + 1;
+            }
+
+            // soft boundaries: cut as soon as the running ACMR is within threshold of the whole cluster's
+            SDL_INLINE bool SplitCluster( const Uint32 first, const Uint32 count, const float threshold, Uint32 &time, const Uint32 cache_size )
+            {
+                ColdCache( time, cache_size );
+                Uint32 misses = 0;
+                for ( Uint32 t = first; t < first + count; t++ )
+                    misses += Transform( &work[( int )( t * 3 )], time, cache_size );
+                const float limit = threshold * ( float )misses / ( float )count;
+
+                ColdCache( time, cache_size );
+                Uint32 start = first;
+                misses = 0;
+                for ( Uint32 t = first; t + 1 < first + count; t++ )
+                {
+                    misses += Transform( &work[( int )( t * 3 )], time, cache_size );
+                    const Uint32 triangles = t + 1 - start;
+                    if ( ( float )misses <= limit * ( float )triangles )
+                    {
+                        if ( !AppendCluster( clusters, start, triangles ) )
+                            return false;
+                        // the next cluster may be drawn apart, it starts with a cold cache
+                        start = t + 1;
+                        misses = 0;
+                        ColdCache( time, cache_size );
+                    }
+                }
+                return AppendCluster( clusters, start, first + count - start );
+            }
+
+            static SDL_INLINE bool AppendCluster( Array<Cluster> &list, const Uint32 first, const Uint32 count )
+            {
+                Cluster cluster;
+                cluster.first = first;
+                cluster.count = count;
+                cluster.sortKey = 0.0f;
+                if ( list.Append( cluster ) == nullptr )
+                    return SDL_OutOfMemory();
+                return true;
+            }
+
+            // adds the area weighted centroid and, if normal is given, the area weighted normal
+            static SDL_INLINE void AccumulateTriangle( const Uint32 *triangle, const float *positions, const Uint32 stride, float centroid[3], float normal[3], float &area )
+            {
+                const float *p0 = positions + ( size_t )triangle[0] * stride;
+                const float *p1 = positions + ( size_t )triangle[1] * stride;
+                const float *p2 = positions + ( size_t )triangle[2] * stride;
+                const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                const float weight = SDL_sqrtf( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] ) * 0.5f;
+                for ( int c = 0; c < 3; c++ )
+                {
+                    centroid[c] += ( p0[c] + p1[c] + p2[c] ) * ( weight / 3.0f );
+                    if ( normal != nullptr )
+                        normal[c] += n[c];
+                }
+                area += weight;
+            }
+
+            // outward facing clusters first, then in their original order
+            static int SDLCALL CompareCluster( const void *a, const void *b )
+            {
+                const Cluster *ca = static_cast<const Cluster*>( a );
+                const Cluster *cb = static_cast<const Cluster*>( b );
+                if ( ca->sortKey != cb->sortKey )
+                    return ca->sortKey > cb->sortKey ? -1 : 1;
+                return ca->first < cb->first ? -1 : ( ca->first > cb->first ? 1 : 0 );
+            }
+
+            static SDL_INLINE SDL_GPUVertexElementFormat GetFormat( const QuantizeAttribute &attribute )
+            {
+                static const SDL_GPUVertexElementFormat floats[4] =
+                {
+                    SDL_GPU_VERTEXELEMENTFORMAT_FLOAT, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4
+                };
+                const bool wide = attribute.components > 2;
+                switch ( attribute.quantize )
+                {
+                case QUANTIZE_HALF:
+                    return wide ? SDL_GPU_VERTEXELEMENTFORMAT_HALF4 : SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+                case QUANTIZE_UNORM16:
+                    return wide ? SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM : SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM;
+                case QUANTIZE_SNORM16:
+                    return wide ? SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM : SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM;
+                default:
+                    return floats[attribute.components - 1];
+                }
+            }
+
+            static SDL_INLINE Uint32 GetSize( const QuantizeAttribute &attribute )
+            {
+                if ( attribute.quantize == QUANTIZE_FLOAT )
+                    return attribute.components * ( Uint32 )sizeof( float );
+                return attribute.components > 2 ? 8 : 4;
+            }
+
+            Array<Uint32>   work;           // copy of the input indices
+            Array<Uint32>   result;
+            Array<Uint32>   offsets;        // first triangle of each vertex in adjacency
+            Array<Uint32>   adjacency;
+            Array<Uint32>   live;           // triangles of each vertex not emitted yet
+            Array<Uint32>   cacheTime;      // when each vertex last entered the cache
+            Array<Uint8>    emitted;
+            Array<Uint32>   deadEnd;
+            Array<Uint32>   candidates;
+            Array<Cluster>  hard;
+            Array<Cluster>  clusters;
+            Array<Uint32>   remap;
+            Stats           stats;
+        };
+    }
+}
+#endif //!__SDL_MESH_OPTIMIZER_HPP__
@@ -0,0 +1,1107 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_PIPELINE_CACHE_HPP__
+#define __SDL_PIPELINE_CACHE_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_bytes.hpp"
+#include "SDL_hashmap.hpp"
+#include "SDL_mutex.hpp"
+#include "SDL_thread.hpp"
+#include "SDL_iostream.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+PipelineCache
+==================================================================
+    Deduplicates graphics and compute pipelines. The whole create info
+    is flattened into a key ( every state field, the vertex layout and
+    the color targets, padding and properties are left out ) and
+    hashed, so two requests for the same state get the same pipeline.
+    Pipelines are reference counted: every Acquire must be matched by
+    a Release, the pipeline is released with the last reference.
+
+    Shaders are identified by the id given to RegisterShader ( or the
+    hash of their create info ). Pipelines whose shaders are all
+    registered are written to the manifest by SaveManifest; on the
+    next run LoadManifest and Prewarm create them ahead of time, on
+    the calling thread or on a background thread with StartPrewarm.
+    Prewarmed pipelines keep a reference owned by the cache until Trim
+    or Destroy. Pipelines using unregistered shaders are still shared,
+    keyed by the shader pointer, but never persisted. Properties are
+    only used when a pipeline is first created.
+
+    Every method is thread safe. A pipeline requested while another
+    thread creates it waits for that creation instead of compiling it
+    twice.
+
+    Example usage:
+        SDL::GPU::PipelineCache cache;
+        cache.Create( device );
+        cache.RegisterShader( vertexShader, vertexShaderInfo );
+        cache.RegisterShader( fragmentShader, fragmentShaderInfo );
+        cache.LoadManifest( "pipelines.bin" );
+        cache.StartPrewarm();
+        ...
+        SDL::GPU::GraphicsPipeline pipeline = cache.AcquireGraphicsPipeline( pipelineInfo );
+        ...
+        cache.Release( pipeline );
+        cache.SaveManifest( "pipelines.bin" );
+        cache.Destroy();
+==================================================================
+*/
+        class PipelineCache
+        {
+        public:
+            static const Uint32 MANIFEST_MAGIC = 0x4D503353; // 'S3PM'
+            static const Uint16 MANIFEST_VERSION = 1;
+
+            struct Stats
+            {
+                int     pipelines;          // alive pipelines
+                int     references;         // outstanding references, prewarm references included
+                int     hits;
+                int     misses;
+                int     waits;              // acquires that waited for another thread's creation
+                int     failures;
+                int     prewarmed;
+                int     prewarmSkipped;     // manifest entries whose shaders are not registered
+                int     prewarmPending;
+                double  createMS;           // total time spent creating pipelines
+                double  maxCreateMS;
+            };
+
+            PipelineCache( void ) : device( nullptr ), nextRecord( 0 ), prewarmJoinable( false ), prewarmRunning( false ), stopPrewarm( false )
+            {
+                SDL_zero( stats );
+            }
+            ~PipelineCache( void ) { Destroy(); }
+
+            SDL_INLINE bool Create( const Device &gpu_device )
+            {
+                if ( device != nullptr )
+                    return SDL_SetError( "PipelineCache already created" );
+
+                if ( !mutex.Create() )
+                    return false;
+                if ( !ready.Create() || !prewarmMutex.Create() )
+                {
+                    ready.Destroy();
+                    mutex.Destroy();
+                    return false;
+                }
+                device = &gpu_device;
+                return true;
+            }
+
+            /// @brief Stop prewarming and release every pipeline, even referenced ones.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                StopPrewarm();
+                for ( int i = 0; i < entries.Num(); i++ )
+                    DestroyPipeline( entries[i] );
+
+                entries.Free();
+                keys.Free();
+                byKey.Free();
+                byPipeline.Free();
+                shaderIds.Free();
+                shadersById.Free();
+                manifest.Free();
+                records.Free();
+                nextRecord = 0;
+                SDL_zero( stats );
+
+                prewarmMutex.Destroy();
+                ready.Destroy();
+                mutex.Destroy();
+                device = nullptr;
+            }
+
+            /// @brief Hash of the parts of a shader create info that affect the compiled shader.
+            static SDL_INLINE Uint64 HashShader( const SDL_GPUShaderCreateInfo &info )
+            {
+                Uint64 hash = HashBytes( info.code, info.code_size );
+                hash = HashString( info.entrypoint, hash );
+                const Uint32 fields[] = { ( Uint32 )info.format, ( Uint32 )info.stage, info.num_samplers,
+                    info.num_storage_textures, info.num_storage_buffers, info.num_uniform_buffers };
+                return HashBytes( fields, sizeof( fields ), hash );
+            }
+
+            /// @brief Give a shader a stable identity, pipelines using it can be persisted.
+            SDL_INLINE bool RegisterShader( SDL_GPUShader *shader, const Uint64 id )
+            {
+                if ( shader == nullptr )
+                    return SDL_SetError( "Invalid shader" );
+
+                mutex.Lock();
+                Uint64 *previous = shaderIds.Find( ( uintptr_t )shader );
+                if ( previous != nullptr )
+                    shadersById.Remove( *previous );
+                bool ok = shaderIds.Insert( ( uintptr_t )shader, id ) != nullptr &&
+                          shadersById.Insert( id, shader ) != nullptr;
+                mutex.Unlock();
+                return ok;
+            }
+
+            /// @brief Register a shader under the hash of the create info it was made from.
+            SDL_INLINE Uint64 RegisterShader( SDL_GPUShader *shader, const SDL_GPUShaderCreateInfo &info )
+            {
+                const Uint64 id = HashShader( info );
+                return RegisterShader( shader, id ) ? id : 0;
+            }
+
+            /// @brief Forget a shader before releasing it, pipelines already created are not affected.
+            SDL_INLINE void UnregisterShader( SDL_GPUShader *shader )
+            {
+                mutex.Lock();
+                Uint64 *id = shaderIds.Find( ( uintptr_t )shader );
+                if ( id != nullptr )
+                {
+                    SDL_GPUShader **registered = shadersById.Find( *id );
+                    if ( registered != nullptr && *registered == shader )
+                        shadersById.Remove( *id );
+                    shaderIds.Remove( ( uintptr_t )shader );
+                }
+                mutex.Unlock();
+            }
+
+            /// @brief Get ( or create ) the pipeline for a create info and add a reference to it.
+            /// @return the pipeline, or a null pipeline if creation failed.
+            SDL_INLINE GraphicsPipeline AcquireGraphicsPipeline( const SDL_GPUGraphicsPipelineCreateInfo &info )
+            {
+                Array<Uint8> key;
+                bool persistable = true;
+                if ( !BuildKey( info, key, persistable ) )
+                    return GraphicsPipeline();
+                return GraphicsPipeline( static_cast<SDL_GPUGraphicsPipeline*>( AcquireEntry( KIND_GRAPHICS, &info, key, persistable, nullptr, 0, false ) ) );
+            }
+
+            /// @brief Get ( or create ) the compute pipeline for a create info and add a reference to it.
+            SDL_INLINE ComputePipeline AcquireComputePipeline( const SDL_GPUComputePipelineCreateInfo &info )
+            {
+                Array<Uint8> key;
+                if ( !BuildKey( info, key ) )
+                    return ComputePipeline();
+                return ComputePipeline( static_cast<SDL_GPUComputePipeline*>( AcquireEntry( KIND_COMPUTE, &info, key, true, info.code, ( Uint32 )info.code_size, false ) ) );
+            }
+
+            SDL_INLINE void Release( SDL_GPUGraphicsPipeline *pipeline ) { ReleasePointer( pipeline ); }
+            SDL_INLINE void Release( SDL_GPUComputePipeline *pipeline ) { ReleasePointer( pipeline ); }
+
+            /// @brief Drop the references held by prewarming, pipelines nobody acquired are released.
+            SDL_INLINE void Trim( void )
+            {
+                mutex.Lock();
+                for ( int i = 0; i < entries.Num(); i++ )
+                {
+                    Entry &entry = entries[i];
+                    if ( !entry.pinned )
+                        continue;
+                    entry.pinned = false;
+                    stats.references--;
+                    if ( --entry.refs == 0 )
+                        DestroyPipeline( entry );
+                }
+                mutex.Unlock();
+            }
+
+            /// @brief Write the persistable pipelines seen so far ( and the ones still waiting for prewarm ).
+            SDL_INLINE bool SaveManifest( IO::Stream &stream )
+            {
+                Array<Uint8> out;
+                int count = 0;
+                PutU32( out, MANIFEST_MAGIC );
+                PutU16( out, MANIFEST_VERSION );
+                PutU32( out, 0 );
+
+                mutex.Lock();
+                for ( int i = 0; i < entries.Num(); i++ )
+                {
+                    const Entry &entry = entries[i];
+                    if ( !entry.persistable )
+                        continue;
+                    PutRecord( out, entry.kind, keys.Ptr() + entry.keyOffset, entry.keySize, keys.Ptr() + entry.codeOffset, entry.codeSize );
+                    count++;
+                }
+                for ( int i = nextRecord; i < records.Num(); i++ )
+                {
+                    const Record &record = records[i];
+                    if ( FindEntry( manifest.Ptr() + record.keyOffset, record.keySize ) >= 0 )
+                        continue;
+                    PutRecord( out, record.kind, manifest.Ptr() + record.keyOffset, record.keySize, manifest.Ptr() + record.codeOffset, record.codeSize );
+                    count++;
+                }
+                mutex.Unlock();
+
+                if ( out.Num() < 10 )
+                    return SDL_OutOfMemory();
+                Uint8 *countField = out.Ptr() + 6;
+                countField[0] = ( Uint8 )count;
+                countField[1] = ( Uint8 )( count >> 8 );
+                countField[2] = ( Uint8 )( count >> 16 );
+                countField[3] = ( Uint8 )( count >> 24 );
+
+                if ( stream.Write( out.Ptr(), ( size_t )out.Num() ) != ( size_t )out.Num() )
+                    return false;
+                return stream.Flush();
+            }
+
+            SDL_INLINE bool SaveManifest( const char *path )
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "wb" ) )
+                    return false;
+                const bool ok = SaveManifest( stream );
+                return stream.Close() && ok;
+            }
+
+            /// @brief Read a manifest, its pipelines are created by Prewarm.
+            SDL_INLINE bool LoadManifest( IO::Stream &stream )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "PipelineCache not created" );
+
+                mutex.Lock();
+                const bool busy = prewarmRunning;
+                mutex.Unlock();
+                if ( busy )
+                    return SDL_SetError( "PipelineCache is prewarming" );
+
+                size_t size = 0;
+                Uint8 *data = static_cast<Uint8*>( stream.LoadFile( &size, false ) );
+                if ( data == nullptr )
+                    return false;
+
+                Array<Uint8> loaded;
+                Array<Record> parsed;
+                bool ok = ParseManifest( data, size, loaded, parsed );
+                SDL_free( data );
+                if ( !ok )
+                    return false;
+
+                mutex.Lock();
+                manifest.Free();
+                records.Free();
+                // Array is not copyable, move the contents over by hand
+                ok = manifest.Resize( loaded.Num() ) && records.Resize( parsed.Num() );
+                if ( ok )
+                {
+                    if ( loaded.Num() > 0 )
+                        SDL_memcpy( manifest.Ptr(), loaded.Ptr(), loaded.Size() );
+                    if ( parsed.Num() > 0 )
+                        SDL_memcpy( records.Ptr(), parsed.Ptr(), parsed.Size() );
+                }
+                nextRecord = 0;
+                stats.prewarmPending = ok ? records.Num() : 0;
+                mutex.Unlock();
+                return ok ? true : SDL_OutOfMemory();
+            }
+
+            SDL_INLINE bool LoadManifest( const char *path )
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "rb" ) )
+                    return false;
+                const bool ok = LoadManifest( stream );
+                stream.Close();
+                return ok;
+            }
+
+            /// @brief Create pipelines from the loaded manifest.
+            /// @param max_count stop after this many creations, -1 for all of them.
+            /// @return the number of pipelines created.
+            SDL_INLINE int Prewarm( const int max_count = -1 )
+            {
+                int created = 0;
+                while ( max_count < 0 || created < max_count )
+                {
+                    Array<Uint8> key;
+                    Array<Uint8> code;
+                    Array<SDL_GPUVertexBufferDescription> vertexBuffers;
+                    Array<SDL_GPUVertexAttribute> vertexAttributes;
+                    Array<SDL_GPUColorTargetDescription> colorTargets;
+                    SDL_GPUGraphicsPipelineCreateInfo graphicsInfo;
+                    SDL_GPUComputePipelineCreateInfo computeInfo;
+                    char entrypoint[MAX_ENTRYPOINT + 1];
+
+                    mutex.Lock();
+                    if ( stopPrewarm || nextRecord >= records.Num() )
+                    {
+                        mutex.Unlock();
+                        break;
+                    }
+                    const Record record = records[nextRecord++];
+                    stats.prewarmPending--;
+                    // copy the key and code out, the manifest may be reloaded once the lock is dropped
+                    bool ok = key.Resize( ( int )record.keySize ) && code.Resize( ( int )record.codeSize );
+                    if ( ok )
+                    {
+                        SDL_memcpy( key.Ptr(), manifest.Ptr() + record.keyOffset, record.keySize );
+                        if ( record.codeSize > 0 )
+                            SDL_memcpy( code.Ptr(), manifest.Ptr() + record.codeOffset, record.codeSize );
+                        if ( record.kind == KIND_GRAPHICS )
+                            ok = DecodeGraphics( key.Ptr(), record.keySize, graphicsInfo, vertexBuffers, vertexAttributes, colorTargets );
+                        else if ( record.kind == KIND_COMPUTE )
+                            ok = DecodeCompute( key.Ptr(), record.keySize, code.Ptr(), record.codeSize, entrypoint, computeInfo );
+                        else
+                            ok = false;
+                    }
+                    if ( !ok )
+                        stats.prewarmSkipped++;
+                    mutex.Unlock();
+                    if ( !ok )
+                        continue;
+
+                    void *pipeline;
+                    if ( record.kind == KIND_GRAPHICS )
+                        pipeline = AcquireEntry( KIND_GRAPHICS, &graphicsInfo, key, true, nullptr, 0, true );
+                    else
+                        pipeline = AcquireEntry( KIND_COMPUTE, &computeInfo, key, true, code.Ptr(), record.codeSize, true );
+                    if ( pipeline != nullptr )
+                        created++;
+                }
+                return created;
+            }
+
+            /// @brief Prewarm the whole manifest on a background thread.
+            SDL_INLINE bool StartPrewarm( void )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "PipelineCache not created" );
+
+                prewarmMutex.Lock();
+                mutex.Lock();
+                const bool running = prewarmRunning;
+                prewarmRunning = true;
+                stopPrewarm = false;
+                mutex.Unlock();
+                if ( running )
+                {
+                    prewarmMutex.Unlock();
+                    return true;
+                }
+                // join a prewarm that already finished
+                JoinPrewarm();
+
+                prewarmJoinable = prewarmThread.Create( PrewarmMain, "SDL_PipelinePrewarm", this );
+                const bool started = prewarmJoinable;
+                if ( !started )
+                {
+                    mutex.Lock();
+                    prewarmRunning = false;
+                    mutex.Unlock();
+                }
+                prewarmMutex.Unlock();
+                return started;
+            }
+
+            /// @brief Wait for the background prewarm to go through the whole manifest.
+            SDL_INLINE void WaitPrewarm( void )
+            {
+                prewarmMutex.Lock();
+                JoinPrewarm();
+                prewarmMutex.Unlock();
+            }
+
+            /// @brief Stop the background prewarm after the pipeline it is creating.
+            SDL_INLINE void StopPrewarm( void )
+            {
+                mutex.Lock();
+                stopPrewarm = true;
+                mutex.Unlock();
+                WaitPrewarm();
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                mutex.Lock();
+                Stats result = stats;
+                mutex.Unlock();
+                return result;
+            }
+
+        private:
+            PipelineCache( const PipelineCache & );
+            PipelineCache &operator=( const PipelineCache & );
+
+            enum
+            {
+                KIND_GRAPHICS = 1,
+                KIND_COMPUTE = 2
+            };
+
+            // shader references inside a key
+            enum
+            {
+                SHADER_NONE = 0,
+                SHADER_ID = 1,
+                SHADER_POINTER = 2
+            };
+
+            struct Entry
+            {
+                void*   pipeline;
+                Uint32  keyOffset;
+                Uint32  keySize;
+                Uint32  codeOffset;
+                Uint32  codeSize;
+                int     refs;
+                Uint8   kind;
+                bool    persistable;
+                bool    pending;    // being created by some thread
+                bool    pinned;     // one reference is owned by prewarm
+            };
+
+            struct Record
+            {
+                Uint32  keyOffset;
+                Uint32  keySize;
+                Uint32  codeOffset;
+                Uint32  codeSize;
+                Uint8   kind;
+            };
+
+            struct Reader
+            {
+                const Uint8*    data;
+                Uint32          size;
+                Uint32          pos;
+                bool            ok;
+
+                Reader( const Uint8 *bytes, const Uint32 count ) : data( bytes ), size( count ), pos( 0 ), ok( true ) {}
+
+                SDL_INLINE const Uint8* Bytes( const Uint32 count )
+                {
+                    if ( !ok || count > size - pos )
+                    {
+                        ok = false;
+                        return nullptr;
+                    }
+                    const Uint8 *ptr = data + pos;
+                    pos += count;
+                    return ptr;
+                }
+
+                SDL_INLINE Uint8 U8( void )
+                {
+                    const Uint8 *ptr = Bytes( 1 );
+                    return ptr != nullptr ? ptr[0] : 0;
+                }
+
+                SDL_INLINE Uint16 U16( void )
+                {
+                    const Uint8 *ptr = Bytes( 2 );
+                    return ptr != nullptr ? ( Uint16 )( ptr[0] | ( ptr[1] << 8 ) ) : 0;
+                }
+
+                SDL_INLINE Uint32 U32( void )
+                {
+                    const Uint8 *ptr = Bytes( 4 );
+                    return ptr != nullptr ? ( ( Uint32 )ptr[0] | ( ( Uint32 )ptr[1] << 8 ) | ( ( Uint32 )ptr[2] << 16 ) | ( ( Uint32 )ptr[3] << 24 ) ) : 0;
+                }
+
+                SDL_INLINE Uint64 U64( void )
+                {
+                    const Uint64 low = U32();
+                    return low | ( ( Uint64 )U32() << 32 );
+                }
+
+                SDL_INLINE float F32( void )
+                {
+                    const Uint32 bits = U32();
+                    float value;
+                    SDL_memcpy( &value, &bits, sizeof( value ) );
+                    return value;
+                }
+            };
+
+            static SDL_INLINE void PutRecord( Array<Uint8> &out, const Uint8 kind, const Uint8 *key, const Uint32 keySize, const Uint8 *code, const Uint32 codeSize )
+            {
+                PutU8( out, kind );
+                PutU32( out, keySize );
+                PutBytes( out, key, keySize );
+                PutU32( out, codeSize );
+                PutBytes( out, code, codeSize );
+            }
+
+            static SDL_INLINE void PutStencil( Array<Uint8> &out, const SDL_GPUStencilOpState &state )
+            {
+                PutU32( out, state.fail_op );
+                PutU32( out, state.pass_op );
+                PutU32( out, state.depth_fail_op );
+                PutU32( out, state.compare_op );
+            }
+
+            static SDL_INLINE void GetStencil( Reader &in, SDL_GPUStencilOpState &state )
+            {
+                state.fail_op = ( SDL_GPUStencilOp )in.U32();
+                state.pass_op = ( SDL_GPUStencilOp )in.U32();
+                state.depth_fail_op = ( SDL_GPUStencilOp )in.U32();
+                state.compare_op = ( SDL_GPUCompareOp )in.U32();
+            }
+
+            // caller holds the lock
+            SDL_INLINE void PutShader( Array<Uint8> &out, SDL_GPUShader *shader, bool &persistable )
+            {
+                if ( shader == nullptr )
+                {
+                    PutU8( out, SHADER_NONE );
+                    return;
+                }
+                const Uint64 *id = shaderIds.Find( ( uintptr_t )shader );
+                if ( id != nullptr )
+                {
+                    PutU8( out, SHADER_ID );
+                    PutU64( out, *id );
+                }
+                else
+                {
+                    PutU8( out, SHADER_POINTER );
+                    PutU64( out, ( Uint64 )( uintptr_t )shader );
+                    persistable = false;
+                }
+            }
+
+            // caller holds the lock
+            SDL_INLINE bool GetShader( Reader &in, SDL_GPUShader *&shader )
+            {
+                const Uint8 type = in.U8();
+                const Uint64 value = type != SHADER_NONE ? in.U64() : 0;
+                shader = nullptr;
+                if ( type == SHADER_NONE )
+                    return true;
+                if ( type != SHADER_ID )
+                    return false;
+                SDL_GPUShader **registered = shadersById.Find( value );
+                if ( registered == nullptr )
+                    return false;
+                shader = *registered;
+                return true;
+            }
+
+            SDL_INLINE bool BuildKey( const SDL_GPUGraphicsPipelineCreateInfo &info, Array<Uint8> &key, bool &persistable )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "PipelineCache not created" );
+
+                const SDL_GPUVertexInputState &input = info.vertex_input_state;
+                const SDL_GPURasterizerState &raster = info.rasterizer_state;
+                const SDL_GPUMultisampleState &multisample = info.multisample_state;
+                const SDL_GPUDepthStencilState &depth = info.depth_stencil_state;
+                const SDL_GPUGraphicsPipelineTargetInfo &targets = info.target_info;
+
+                key.Reserve( 128 + input.num_vertex_buffers * 16 + input.num_vertex_attributes * 16 + targets.num_color_targets * 36 );
+                PutU8( key, KIND_GRAPHICS );
+                mutex.Lock();
+                PutShader( key, info.vertex_shader, persistable );
+                PutShader( key, info.fragment_shader, persistable );
+                mutex.Unlock();
+
+                PutU32( key, input.num_vertex_buffers );
+                for ( Uint32 i = 0; i < input.num_vertex_buffers; i++ )
+                {
+                    const SDL_GPUVertexBufferDescription &desc = input.vertex_buffer_descriptions[i];
+                    PutU32( key, desc.slot );
+                    PutU32( key, desc.pitch );
+                    PutU32( key, desc.input_rate );
+                    PutU32( key, desc.instance_step_rate );
+                }
+                PutU32( key, input.num_vertex_attributes );
+                for ( Uint32 i = 0; i < input.num_vertex_attributes; i++ )
+                {
+                    const SDL_GPUVertexAttribute &attribute = input.vertex_attributes[i];
+                    PutU32( key, attribute.location );
+                    PutU32( key, attribute.buffer_slot );
+                    PutU32( key, attribute.format );
+                    PutU32( key, attribute.offset );
+                }
+                PutU32( key, info.primitive_type );
+
+                PutU32( key, raster.fill_mode );
+                PutU32( key, raster.cull_mode );
+                PutU32( key, raster.front_face );
+                PutF32( key, raster.depth_bias_constant_factor );
+                PutF32( key, raster.depth_bias_clamp );
+                PutF32( key, raster.depth_bias_slope_factor );
+                PutU8( key, raster.enable_depth_bias );
+                PutU8( key, raster.enable_depth_clip );
+
+                PutU32( key, multisample.sample_count );
+                PutU32( key, multisample.sample_mask );
+                PutU8( key, multisample.enable_mask );
+
+                PutU32( key, depth.compare_op );
+                PutStencil( key, depth.back_stencil_state );
+                PutStencil( key, depth.front_stencil_state );
+                PutU8( key, depth.compare_mask );
+                PutU8( key, depth.write_mask );
+                PutU8( key, depth.enable_depth_test );
+                PutU8( key, depth.enable_depth_write );
+                PutU8( key, depth.enable_stencil_test );
+
+                PutU32( key, targets.num_color_targets );
+                for ( Uint32 i = 0; i < targets.num_color_targets; i++ )
+                {
+                    const SDL_GPUColorTargetDescription &target = targets.color_target_descriptions[i];
+                    const SDL_GPUColorTargetBlendState &blend = target.blend_state;
+                    PutU32( key, target.format );
+                    PutU32( key, blend.src_color_blendfactor );
+                    PutU32( key, blend.dst_color_blendfactor );
+                    PutU32( key, blend.color_blend_op );
+                    PutU32( key, blend.src_alpha_blendfactor );
+                    PutU32( key, blend.dst_alpha_blendfactor );
+                    PutU32( key, blend.alpha_blend_op );
+                    PutU8( key, blend.color_write_mask );
+                    PutU8( key, blend.enable_blend );
+                    PutU8( key, blend.enable_color_write_mask );
+                }
+                PutU32( key, targets.depth_stencil_format );
+                PutU8( key, targets.has_depth_stencil_target );
+                return key.Num() > 0 ? true : SDL_OutOfMemory();
+            }
+
+            SDL_INLINE bool BuildKey( const SDL_GPUComputePipelineCreateInfo &info, Array<Uint8> &key )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "PipelineCache not created" );
+
+                // the code itself is stored next to the key, the key only carries its hash
+                PutU8( key, KIND_COMPUTE );
+                PutU64( key, HashBytes( info.code, info.code_size ) );
+                PutU32( key, ( Uint32 )info.code_size );
+                const char *entrypoint = info.entrypoint != nullptr ? info.entrypoint : "";
+                const Uint32 length = ( Uint32 )SDL_strlen( entrypoint );
+                PutU32( key, length );
+                PutBytes( key, entrypoint, length );
+                PutU32( key, info.format );
+                PutU32( key, info.num_samplers );
+                PutU32( key, info.num_readonly_storage_textures );
+                PutU32( key, info.num_readonly_storage_buffers );
+                PutU32( key, info.num_readwrite_storage_textures );
+                PutU32( key, info.num_readwrite_storage_buffers );
+                PutU32( key, info.num_uniform_buffers );
+                PutU32( key, info.threadcount_x );
+                PutU32( key, info.threadcount_y );
+                PutU32( key, info.threadcount_z );
+                return key.Num() > 0 ? true : SDL_OutOfMemory();
+            }
+
+            // caller holds the lock, the arrays receive what the create info points to
+            SDL_INLINE bool DecodeGraphics( const Uint8 *data, const Uint32 size, SDL_GPUGraphicsPipelineCreateInfo &info,
+                                            Array<SDL_GPUVertexBufferDescription> &vertexBuffers,
+                                            Array<SDL_GPUVertexAttribute> &vertexAttributes,
+                                            Array<SDL_GPUColorTargetDescription> &colorTargets )
+            {
+                Reader in( data, size );
+                SDL_zero( info );
+                if ( in.U8() != KIND_GRAPHICS )
+                    return false;
+                if ( !GetShader( in, info.vertex_shader ) || !GetShader( in, info.fragment_shader ) )
+                    return false;
+
+                SDL_GPUVertexInputState &input = info.vertex_input_state;
+                input.num_vertex_buffers = in.U32();
+                if ( !in.ok || input.num_vertex_buffers > size || !vertexBuffers.Resize( ( int )input.num_vertex_buffers ) )
+                    return false;
+                for ( Uint32 i = 0; i < input.num_vertex_buffers; i++ )
+                {
+                    SDL_GPUVertexBufferDescription &desc = vertexBuffers[i];
+                    desc.slot = in.U32();
+                    desc.pitch = in.U32();
+                    desc.input_rate = ( SDL_GPUVertexInputRate )in.U32();
+                    desc.instance_step_rate = in.U32();
+                }
+                input.vertex_buffer_descriptions = vertexBuffers.Ptr();
+                input.num_vertex_attributes = in.U32();
+                if ( !in.ok || input.num_vertex_attributes > size || !vertexAttributes.Resize( ( int )input.num_vertex_attributes ) )
+                    return false;
+                for ( Uint32 i = 0; i < input.num_vertex_attributes; i++ )
+                {
+                    SDL_GPUVertexAttribute &attribute = vertexAttributes[i];
+                    attribute.location = in.U32();
+                    attribute.buffer_slot = in.U32();
+                    attribute.format = ( SDL_GPUVertexElementFormat )in.U32();
+                    attribute.offset = in.U32();
+                }
+                input.vertex_attributes = vertexAttributes.Ptr();
+                info.primitive_type = ( SDL_GPUPrimitiveType )in.U32();
+
+                SDL_GPURasterizerState &raster = info.rasterizer_state;
+                raster.fill_mode = ( SDL_GPUFillMode )in.U32();
+                raster.cull_mode = ( SDL_GPUCullMode )in.U32();
+                raster.front_face = ( SDL_GPUFrontFace )in.U32();
+                raster.depth_bias_constant_factor = in.F32();
+                raster.depth_bias_clamp = in.F32();
+                raster.depth_bias_slope_factor = in.F32();
+                raster.enable_depth_bias = in.U8() != 0;
+                raster.enable_depth_clip = in.U8() != 0;
+
+                SDL_GPUMultisampleState &multisample = info.multisample_state;
+                multisample.sample_count = ( SDL_GPUSampleCount )in.U32();
+                multisample.sample_mask = in.U32();
+                multisample.enable_mask = in.U8() != 0;
+
+                SDL_GPUDepthStencilState &depth = info.depth_stencil_state;
+                depth.compare_op = ( SDL_GPUCompareOp )in.U32();
+                GetStencil( in, depth.back_stencil_state );
+                GetStencil( in, depth.front_stencil_state );
+                depth.compare_mask = in.U8();
+                depth.write_mask = in.U8();
+                depth.enable_depth_test = in.U8() != 0;
+                depth.enable_depth_write = in.U8() != 0;
+                depth.enable_stencil_test = in.U8() != 0;
+
+                SDL_GPUGraphicsPipelineTargetInfo &targets = info.target_info;
+                targets.num_color_targets = in.U32();
+                if ( !in.ok || targets.num_color_targets > size || !colorTargets.Resize( ( int )targets.num_color_targets ) )
+                    return false;
+                for ( Uint32 i = 0; i < targets.num_color_targets; i++ )
+                {
+                    SDL_GPUColorTargetDescription &target = colorTargets[i];
+                    SDL_GPUColorTargetBlendState &blend = target.blend_state;
+                    SDL_zero( target );
+                    target.format = ( SDL_GPUTextureFormat )in.U32();
+                    blend.src_color_blendfactor = ( SDL_GPUBlendFactor )in.U32();
+                    blend.dst_color_blendfactor = ( SDL_GPUBlendFactor )in.U32();
+                    blend.color_blend_op = ( SDL_GPUBlendOp )in.U32();
+                    blend.src_alpha_blendfactor = ( SDL_GPUBlendFactor )in.U32();
+                    blend.dst_alpha_blendfactor = ( SDL_GPUBlendFactor )in.U32();
+                    blend.alpha_blend_op = ( SDL_GPUBlendOp )in.U32();
+                    blend.color_write_mask = in.U8();
+                    blend.enable_blend = in.U8() != 0;
+                    blend.enable_color_write_mask = in.U8() != 0;
+                }
+                targets.color_target_descriptions = colorTargets.Ptr();
+                targets.depth_stencil_format = ( SDL_GPUTextureFormat )in.U32();
+                targets.has_depth_stencil_target = in.U8() != 0;
+                return in.ok && in.pos == size;
+            }
+
+            // the create info points into code and entrypoint, which must outlive it
+            static SDL_INLINE bool DecodeCompute( const Uint8 *data, const Uint32 size, const Uint8 *code, const Uint32 codeSize,
+                                                  char *entrypoint, SDL_GPUComputePipelineCreateInfo &info )
+            {
+                Reader in( data, size );
+                SDL_zero( info );
+                if ( in.U8() != KIND_COMPUTE )
+                    return false;
+                const Uint64 hash = in.U64();
+                info.code_size = in.U32();
+                if ( !in.ok || info.code_size != codeSize || HashBytes( code, codeSize ) != hash )
+                    return false;
+                info.code = code;
+                const Uint32 length = in.U32();
+                const Uint8 *name = in.Bytes( length );
+                if ( !in.ok || length > MAX_ENTRYPOINT )
+                    return false;
+                // the key has no terminator after the name
+                SDL_memcpy( entrypoint, name, length );
+                entrypoint[length] = '\0';
+                info.entrypoint = entrypoint;
+                info.format = ( SDL_GPUShaderFormat )in.U32();
+                info.num_samplers = in.U32();
+                info.num_readonly_storage_textures = in.U32();
+                info.num_readonly_storage_buffers = in.U32();
+                info.num_readwrite_storage_textures = in.U32();
+                info.num_readwrite_storage_buffers = in.U32();
+                info.num_uniform_buffers = in.U32();
+                info.threadcount_x = in.U32();
+                info.threadcount_y = in.U32();
+                info.threadcount_z = in.U32();
+                return in.ok && in.pos == size;
+            }
+
+            // caller holds the lock
+            SDL_INLINE int FindEntry( const Uint8 *key, const Uint32 size, Uint64 *freeSlot = nullptr ) const
+            {
+                // colliding keys go to the following hash values
+                for ( Uint64 slot = HashBytes( key, size );; slot++ )
+                {
+                    const int *index = byKey.Find( slot );
+                    if ( index == nullptr )
+                    {
+                        if ( freeSlot != nullptr )
+                            *freeSlot = slot;
+                        return -1;
+                    }
+                    const Entry &entry = entries[*index];
+                    if ( entry.keySize == size && SDL_memcmp( keys.Ptr() + entry.keyOffset, key, size ) == 0 )
+                        return *index;
+                }
+            }
+
+            SDL_INLINE void* AcquireEntry( const Uint8 kind, const void *createinfo, const Array<Uint8> &key, const bool persistable,
+                                           const Uint8 *code, const Uint32 codeSize, const bool pin )
+            {
+                mutex.Lock();
+                Uint64 slot = 0;
+                int index = FindEntry( key.Ptr(), ( Uint32 )key.Num(), &slot );
+                if ( index >= 0 )
+                {
+                    if ( entries[index].pending )
+                    {
+                        stats.waits++;
+                        while ( entries[index].pending )
+                            ready.Wait( mutex );
+                    }
+
+                    Entry &entry = entries[index];
+                    if ( entry.pipeline != nullptr )
+                    {
+                        void *pipeline = entry.pipeline;
+                        if ( !pin )
+                        {
+                            entry.refs++;
+                            stats.references++;
+                            stats.hits++;
+                        }
+                        else if ( !entry.pinned )
+                        {
+                            entry.pinned = true;
+                            entry.refs++;
+                            stats.references++;
+                            stats.prewarmed++;
+                        }
+                        else
+                        {
+                            // listed twice in the manifest
+                            pipeline = nullptr;
+                        }
+                        mutex.Unlock();
+                        return pipeline;
+                    }
+                    // known, but released since, create it again
+                    entry.pending = true;
+                }
+                else
+                {
+                    const Uint32 keyOffset = ( Uint32 )keys.Num();
+                    Uint8 *dst = keys.AppendUninitialized( key.Num() + ( int )codeSize );
+                    Entry *entry = dst != nullptr ? entries.AppendUninitialized( 1 ) : nullptr;
+                    if ( entry == nullptr )
+                    {
+                        keys.Resize( ( int )keyOffset );
+                        mutex.Unlock();
+                        SDL_OutOfMemory();
+                        return nullptr;
+                    }
+                    SDL_memcpy( dst, key.Ptr(), key.Size() );
+                    if ( codeSize > 0 )
+                        SDL_memcpy( dst + key.Num(), code, codeSize );
+
+                    SDL_zerop( entry );
+                    entry->keyOffset = keyOffset;
+                    entry->keySize = ( Uint32 )key.Num();
+                    entry->codeOffset = keyOffset + entry->keySize;
+                    entry->codeSize = codeSize;
+                    entry->kind = kind;
+                    entry->persistable = persistable;
+                    entry->pending = true;
+                    index = entries.Num() - 1;
+                    if ( byKey.Insert( slot, index ) == nullptr )
+                    {
+                        entries.Resize( index );
+                        keys.Resize( ( int )keyOffset );
+                        mutex.Unlock();
+                        SDL_OutOfMemory();
+                        return nullptr;
+                    }
+                }
+                if ( !pin )
+                    stats.misses++;
+                mutex.Unlock();
+
+                // compile without holding the lock, other keys can be created meanwhile
+                const Uint64 start = SDL_GetPerformanceCounter();
+                void *pipeline;
+                if ( kind == KIND_GRAPHICS )
+                    pipeline = SDL_CreateGPUGraphicsPipeline( *device, static_cast<const SDL_GPUGraphicsPipelineCreateInfo*>( createinfo ) );
+                else
+                    pipeline = SDL_CreateGPUComputePipeline( *device, static_cast<const SDL_GPUComputePipelineCreateInfo*>( createinfo ) );
+                const double ms = ( double )( SDL_GetPerformanceCounter() - start ) * 1000.0 / ( double )SDL_GetPerformanceFrequency();
+
+                mutex.Lock();
+                Entry &entry = entries[index];
+                entry.pending = false;
+                stats.createMS += ms;
+                if ( ms > stats.maxCreateMS )
+                    stats.maxCreateMS = ms;
+                if ( pipeline != nullptr && byPipeline.Insert( ( uintptr_t )pipeline, index ) != nullptr )
+                {
+                    entry.pipeline = pipeline;
+                    entry.refs = 1;
+                    entry.pinned = pin;
+                    stats.pipelines++;
+                    stats.references++;
+                    if ( pin )
+                        stats.prewarmed++;
+                }
+                else
+                {
+                    if ( pipeline != nullptr )
+                    {
+                        entry.pipeline = pipeline;
+                        DestroyPipeline( entry );
+                        pipeline = nullptr;
+                        SDL_OutOfMemory();
+                    }
+                    stats.failures++;
+                }
+                ready.Broadcast();
+                mutex.Unlock();
+                return pipeline;
+            }
+
+            SDL_INLINE void ReleasePointer( void *pipeline )
+            {
+                if ( pipeline == nullptr )
+                    return;
+
+                mutex.Lock();
+                const int *index = byPipeline.Find( ( uintptr_t )pipeline );
+                if ( index != nullptr )
+                {
+                    Entry &entry = entries[*index];
+                    stats.references--;
+                    if ( --entry.refs == 0 )
+                        DestroyPipeline( entry );
+                }
+                else
+                {
+                    SDL_SetError( "Pipeline was not acquired from this cache" );
+                }
+                mutex.Unlock();
+            }
+
+            // caller holds the lock
+            SDL_INLINE void DestroyPipeline( Entry &entry )
+            {
+                if ( entry.pipeline == nullptr )
+                    return;
+
+                if ( byPipeline.Remove( ( uintptr_t )entry.pipeline ) )
+                {
+                    stats.pipelines--;
+                    stats.references -= entry.refs;
+                }
+                if ( entry.kind == KIND_GRAPHICS )
+                    SDL_ReleaseGPUGraphicsPipeline( *device, static_cast<SDL_GPUGraphicsPipeline*>( entry.pipeline ) );
+                else
+                    SDL_ReleaseGPUComputePipeline( *device, static_cast<SDL_GPUComputePipeline*>( entry.pipeline ) );
+                entry.pipeline = nullptr;
+                entry.refs = 0;
+                entry.pinned = false;
+            }
+
+            static SDL_INLINE bool ParseManifest( const Uint8 *data, const size_t size, Array<Uint8> &loaded, Array<Record> &parsed )
+            {
+                if ( size > 0x7fffffff )
+                    return SDL_SetError( "Pipeline manifest is too large" );
+
+                Reader in( data, ( Uint32 )size );
+                if ( in.U32() != MANIFEST_MAGIC )
+                    return SDL_SetError( "Not a pipeline manifest" );
+                if ( in.U16() != MANIFEST_VERSION )
+                    return SDL_SetError( "Unsupported pipeline manifest version" );
+
+                const Uint32 count = in.U32();
+                for ( Uint32 i = 0; i < count && in.ok; i++ )
+                {
+                    Record record;
+                    record.kind = in.U8();
+                    record.keySize = in.U32();
+                    const Uint8 *key = in.Bytes( record.keySize );
+                    record.codeSize = in.U32();
+                    const Uint8 *code = in.Bytes( record.codeSize );
+                    if ( !in.ok )
+                        break;
+
+                    record.keyOffset = ( Uint32 )loaded.Num();
+                    record.codeOffset = record.keyOffset + record.keySize;
+                    Uint8 *dst = loaded.AppendUninitialized( ( int )( record.keySize + record.codeSize ) );
+                    if ( dst == nullptr || parsed.Append( record ) == nullptr )
+                        return SDL_OutOfMemory();
+                    SDL_memcpy( dst, key, record.keySize );
+                    if ( record.codeSize > 0 )
+                        SDL_memcpy( dst + record.keySize, code, record.codeSize );
+                }
+                return in.ok ? true : SDL_SetError( "Truncated pipeline manifest" );
+            }
+
+            // with prewarmMutex held, the thread never takes it
+            SDL_INLINE void JoinPrewarm( void )
+            {
+                if ( !prewarmJoinable )
+                    return;
+                prewarmThread.Wait();
+                prewarmJoinable = false;
+            }
+
+            static int SDLCALL PrewarmMain( void *data )
+            {
+                PipelineCache *cache = static_cast<PipelineCache*>( data );
+                cache->Prewarm( -1 );
+                cache->mutex.Lock();
+                cache->prewarmRunning = false;
+                cache->mutex.Unlock();
+                return 0;
+            }
+
+            static const Uint32 MAX_ENTRYPOINT = 255;
+
+            const Device*           device;
+            mutable Mutex           mutex;
+            Condition               ready;          // broadcast when a pending creation finishes
+            Array<Entry>            entries;
+            Array<Uint8>            keys;           // keys ( and compute code ) of every entry
+            HashMap<int>            byKey;          // key hash -> entry
+            HashMap<int>            byPipeline;     // pipeline pointer -> entry
+            HashMap<Uint64>         shaderIds;      // shader pointer -> id
+            HashMap<SDL_GPUShader*> shadersById;
+            Array<Uint8>            manifest;       // loaded records, waiting for prewarm
+            Array<Record>           records;
+            int                     nextRecord;
+            Mutex                   prewarmMutex;   // serializes starting and joining the prewarm thread
+            Thread                  prewarmThread;
+            bool                    prewarmJoinable;
+            bool                    prewarmRunning;
+            bool                    stopPrewarm;
+            Stats                   stats;
+        };
+    }
+}
+#endif //!__SDL_PIPELINE_CACHE_HPP__
@@ -0,0 +1,700 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_PIPELINE_COMPILER_HPP__
+#define __SDL_PIPELINE_COMPILER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_mutex.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_pipelinecache.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+PipelineCompiler
+==================================================================
+    Creates shaders and pipelines on a pool of worker threads. Every
+    Compile call copies the create info ( code, entry point, vertex
+    layout and color targets ) and returns a handle right away; the
+    properties id is passed as is and must stay valid until the job
+    is done.
+
+    A handle is polled with IsReady, GetGraphicsPipeline returns the
+    fallback given to it until the real pipeline exists, so drawing
+    never waits for a compilation. Ready callbacks are called from
+    Poll, on the thread that calls it. Results stay owned by the
+    compiler until they are taken with Take*, or released by Discard.
+
+    With a PipelineCache, pipelines are acquired from the cache ( and
+    must be released to it once taken ) and compiled shaders are
+    registered to it, so their pipelines end up in its manifest.
+
+    Example usage:
+        SDL::GPU::PipelineCompiler compiler;
+        compiler.Create( device );
+        SDL::GPU::PipelineCompiler::Handle handle = compiler.CompileGraphicsPipeline( pipelineInfo );
+        ...
+        // every frame
+        compiler.Poll();
+        SDL::GPU::GraphicsPipeline pipeline = compiler.GetGraphicsPipeline( handle, fallbackPipeline );
+        ...
+        compiler.Discard( handle );
+        compiler.Destroy();
+==================================================================
+*/
+        class PipelineCompiler
+        {
+        public:
+            static const int MAX_THREADS = 8;
+
+            /// @brief Generation in the high 16 bits, slot + 1 in the low 16 bits, 0 is never valid.
+            typedef Uint32 Handle;
+
+            /// @brief Called from Poll once a job finished, succeeded is false if creation failed.
+            typedef void ( SDLCALL *ReadyCallback )( void *userdata, Handle handle, bool succeeded );
+
+            struct Stats
+            {
+                int     queued;
+                int     running;
+                int     ready;          // finished, not taken or discarded yet
+                int     compiled;
+                int     failed;
+                double  compileMS;      // total time spent in creation, over all workers
+                double  maxCompileMS;
+            };
+
+            PipelineCompiler( void ) : device( nullptr ), cache( nullptr ), quit( false )
+            {
+                SDL_zero( stats );
+            }
+            ~PipelineCompiler( void ) { Destroy(); }
+
+            /// @brief Start the workers.
+            /// @param num_threads worker count, 0 for one less than the logical cores ( at least one, at most MAX_THREADS ).
+            /// @param pipeline_cache optional cache the pipelines are acquired from.
+            SDL_INLINE bool Create( const Device &gpu_device, int num_threads = 0, PipelineCache *pipeline_cache = nullptr )
+            {
+                if ( device != nullptr )
+                    return SDL_SetError( "PipelineCompiler already created" );
+
+                if ( num_threads <= 0 )
+                    num_threads = SDL_GetNumLogicalCPUCores() - 1;
+                num_threads = SDL_clamp( num_threads, 1, MAX_THREADS );
+
+                if ( !mutex.Create() )
+                    return false;
+                if ( !work.Create() || !done.Create() )
+                {
+                    work.Destroy();
+                    mutex.Destroy();
+                    return false;
+                }
+
+                device = &gpu_device;
+                cache = pipeline_cache;
+                quit = false;
+                for ( int i = 0; i < num_threads; i++ )
+                {
+                    SDL_Thread *thread = SDL_CreateThread( WorkerMain, "SDL_PipelineCompiler", this );
+                    if ( thread == nullptr )
+                    {
+                        Destroy();
+                        return false;
+                    }
+                    if ( threads.Append( thread ) == nullptr )
+                    {
+                        // not tracked, stop and join it here before the others
+                        mutex.Lock();
+                        quit = true;
+                        work.Broadcast();
+                        mutex.Unlock();
+                        SDL_WaitThread( thread, nullptr );
+                        Destroy();
+                        return SDL_OutOfMemory();
+                    }
+                }
+                return true;
+            }
+
+            /// @brief Drop the queued jobs, wait for the running ones and release every result not taken.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                mutex.Lock();
+                quit = true;
+                queue.Clear();
+                work.Broadcast();
+                mutex.Unlock();
+                for ( int i = 0; i < threads.Num(); i++ )
+                    SDL_WaitThread( threads[i], nullptr );
+
+                for ( int i = 0; i < jobs.Num(); i++ )
+                {
+                    Job &job = jobs[i];
+                    if ( job.state == STATE_FREE )
+                        continue;
+                    DestroyResult( job.kind, job.result );
+                    SDL_free( job.storage );
+                }
+
+                threads.Free();
+                jobs.Free();
+                freeSlots.Free();
+                queue.Free();
+                completed.Free();
+                SDL_zero( stats );
+
+                done.Destroy();
+                work.Destroy();
+                mutex.Destroy();
+                device = nullptr;
+                cache = nullptr;
+            }
+
+            SDL_INLINE Handle CompileShader( const SDL_GPUShaderCreateInfo &info, ReadyCallback callback = nullptr, void *userdata = nullptr )
+            {
+                Job job;
+                SDL_zero( job );
+                job.kind = KIND_SHADER;
+                job.info.shader = info;
+                const size_t entrypointSize = SDL_strlen( info.entrypoint != nullptr ? info.entrypoint : "" ) + 1;
+                Uint8 *storage = AllocStorage( job, info.code_size + entrypointSize );
+                if ( storage == nullptr )
+                    return 0;
+                SDL_memcpy( storage, info.code, info.code_size );
+                SDL_memcpy( storage + info.code_size, info.entrypoint != nullptr ? info.entrypoint : "", entrypointSize );
+                job.info.shader.code = storage;
+                job.info.shader.entrypoint = reinterpret_cast<const char*>( storage + info.code_size );
+                return Submit( job, callback, userdata );
+            }
+
+            SDL_INLINE Handle CompileGraphicsPipeline( const SDL_GPUGraphicsPipelineCreateInfo &info, ReadyCallback callback = nullptr, void *userdata = nullptr )
+            {
+                Job job;
+                SDL_zero( job );
+                job.kind = KIND_GRAPHICS;
+                job.info.graphics = info;
+
+                SDL_GPUGraphicsPipelineCreateInfo &copy = job.info.graphics;
+                const size_t buffersSize = sizeof( SDL_GPUVertexBufferDescription ) * info.vertex_input_state.num_vertex_buffers;
+                const size_t attributesSize = sizeof( SDL_GPUVertexAttribute ) * info.vertex_input_state.num_vertex_attributes;
+                const size_t targetsSize = sizeof( SDL_GPUColorTargetDescription ) * info.target_info.num_color_targets;
+                Uint8 *storage = AllocStorage( job, buffersSize + attributesSize + targetsSize );
+                if ( storage == nullptr )
+                    return 0;
+                if ( buffersSize > 0 )
+                    SDL_memcpy( storage, info.vertex_input_state.vertex_buffer_descriptions, buffersSize );
+                if ( attributesSize > 0 )
+                    SDL_memcpy( storage + buffersSize, info.vertex_input_state.vertex_attributes, attributesSize );
+                if ( targetsSize > 0 )
+                    SDL_memcpy( storage + buffersSize + attributesSize, info.target_info.color_target_descriptions, targetsSize );
+                copy.vertex_input_state.vertex_buffer_descriptions = reinterpret_cast<const SDL_GPUVertexBufferDescription*>( storage );
+                copy.vertex_input_state.vertex_attributes = reinterpret_cast<const SDL_GPUVertexAttribute*>( storage + buffersSize );
+                copy.target_info.color_target_descriptions = reinterpret_cast<const SDL_GPUColorTargetDescription*>( storage + buffersSize + attributesSize );
+                return Submit( job, callback, userdata );
+            }
+
+            SDL_INLINE Handle CompileComputePipeline( const SDL_GPUComputePipelineCreateInfo &info, ReadyCallback callback = nullptr, void *userdata = nullptr )
+            {
+                Job job;
+                SDL_zero( job );
+                job.kind = KIND_COMPUTE;
+                job.info.compute = info;
+                const size_t entrypointSize = SDL_strlen( info.entrypoint != nullptr ? info.entrypoint : "" ) + 1;
+                Uint8 *storage = AllocStorage( job, info.code_size + entrypointSize );
+                if ( storage == nullptr )
+                    return 0;
+                SDL_memcpy( storage, info.code, info.code_size );
+                SDL_memcpy( storage + info.code_size, info.entrypoint != nullptr ? info.entrypoint : "", entrypointSize );
+                job.info.compute.code = storage;
+                job.info.compute.entrypoint = reinterpret_cast<const char*>( storage + info.code_size );
+                return Submit( job, callback, userdata );
+            }
+
+            /// @brief True once the job finished, successfully or not.
+            SDL_INLINE bool IsReady( const Handle handle ) const
+            {
+                mutex.Lock();
+                const Job *job = Find( handle );
+                const bool ready = job != nullptr && ( job->state == STATE_READY || job->state == STATE_FAILED );
+                mutex.Unlock();
+                return ready;
+            }
+
+            SDL_INLINE bool HasFailed( const Handle handle ) const
+            {
+                mutex.Lock();
+                const Job *job = Find( handle );
+                const bool failed = job != nullptr && job->state == STATE_FAILED;
+                mutex.Unlock();
+                return failed;
+            }
+
+            /// @brief The compiled shader, still owned by the compiler, or the fallback while it is not ready.
+            SDL_INLINE Shader GetShader( const Handle handle, const Shader &fallback = Shader() ) const
+            {
+                return Shader( static_cast<SDL_GPUShader*>( GetResult( handle, KIND_SHADER, fallback.GetHandle() ) ) );
+            }
+
+            SDL_INLINE GraphicsPipeline GetGraphicsPipeline( const Handle handle, const GraphicsPipeline &fallback = GraphicsPipeline() ) const
+            {
+                return GraphicsPipeline( static_cast<SDL_GPUGraphicsPipeline*>( GetResult( handle, KIND_GRAPHICS, fallback.GetHandle() ) ) );
+            }
+
+            SDL_INLINE ComputePipeline GetComputePipeline( const Handle handle, const ComputePipeline &fallback = ComputePipeline() ) const
+            {
+                return ComputePipeline( static_cast<SDL_GPUComputePipeline*>( GetResult( handle, KIND_COMPUTE, fallback.GetHandle() ) ) );
+            }
+
+            /// @brief Take ownership of a finished shader, the handle becomes invalid. Null if it is not ready.
+            SDL_INLINE Shader TakeShader( const Handle handle )
+            {
+                return Shader( static_cast<SDL_GPUShader*>( TakeResult( handle, KIND_SHADER ) ) );
+            }
+
+            SDL_INLINE GraphicsPipeline TakeGraphicsPipeline( const Handle handle )
+            {
+                return GraphicsPipeline( static_cast<SDL_GPUGraphicsPipeline*>( TakeResult( handle, KIND_GRAPHICS ) ) );
+            }
+
+            SDL_INLINE ComputePipeline TakeComputePipeline( const Handle handle )
+            {
+                return ComputePipeline( static_cast<SDL_GPUComputePipeline*>( TakeResult( handle, KIND_COMPUTE ) ) );
+            }
+
+            /// @brief Block until a job is done, a job still queued is run on the calling thread.
+            /// @return true if the job succeeded.
+            SDL_INLINE bool Wait( const Handle handle )
+            {
+                mutex.Lock();
+                Job *job = Find( handle );
+                if ( job != nullptr && job->state == STATE_QUEUED )
+                {
+                    RemoveQueued( ( int )( handle & 0xffff ) - 1 );
+                    job->state = STATE_RUNNING;
+                    stats.queued--;
+                    stats.running++;
+                    Job local = *job;
+                    mutex.Unlock();
+                    double ms;
+                    void *result = Run( local, ms );
+                    mutex.Lock();
+                    Finish( ( int )( handle & 0xffff ) - 1, result, ms );
+                }
+                while ( ( job = Find( handle ) ) != nullptr && job->state == STATE_RUNNING )
+                    done.Wait( mutex );
+                const bool ok = job != nullptr && job->state == STATE_READY;
+                mutex.Unlock();
+                return ok;
+            }
+
+            /// @brief Forget a job: a queued job is dropped, a running one is released once done.
+            SDL_INLINE void Discard( const Handle handle )
+            {
+                mutex.Lock();
+                Job *job = Find( handle );
+                if ( job != nullptr )
+                {
+                    const int slot = ( int )( handle & 0xffff ) - 1;
+                    switch ( job->state )
+                    {
+                    case STATE_QUEUED:
+                        RemoveQueued( slot );
+                        stats.queued--;
+                        FreeSlot( slot );
+                        break;
+                    case STATE_RUNNING:
+                        job->discarded = true;
+                        break;
+                    case STATE_READY:
+                        DestroyResult( job->kind, job->result );
+                        stats.ready--;
+                        FreeSlot( slot );
+                        break;
+                    default:
+                        FreeSlot( slot );
+                        break;
+                    }
+                }
+                mutex.Unlock();
+            }
+
+            /// @brief Call the ready callbacks of the jobs finished since the last poll.
+            /// @return the number of callbacks called.
+            SDL_INLINE int Poll( void )
+            {
+                Array<Notification> pending;
+                mutex.Lock();
+                for ( int i = 0; i < completed.Num(); i++ )
+                {
+                    // skip jobs discarded meanwhile
+                    const Job *job = Find( completed[i].handle );
+                    if ( job != nullptr && job->state != STATE_RUNNING )
+                        pending.Append( completed[i] );
+                }
+                completed.Clear();
+                mutex.Unlock();
+
+                for ( int i = 0; i < pending.Num(); i++ )
+                {
+                    const Notification &notification = pending[i];
+                    notification.callback( notification.userdata, notification.handle, notification.succeeded );
+                }
+                return pending.Num();
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                mutex.Lock();
+                Stats result = stats;
+                mutex.Unlock();
+                return result;
+            }
+
+        private:
+            PipelineCompiler( const PipelineCompiler & );
+            PipelineCompiler &operator=( const PipelineCompiler & );
+
+            enum
+            {
+                KIND_SHADER = 1,
+                KIND_GRAPHICS,
+                KIND_COMPUTE
+            };
+
+            enum
+            {
+                STATE_FREE = 0,
+                STATE_QUEUED,
+                STATE_RUNNING,
+                STATE_READY,
+                STATE_FAILED
+            };
+
+            struct Job
+            {
+                union
+                {
+                    SDL_GPUShaderCreateInfo             shader;
+                    SDL_GPUGraphicsPipelineCreateInfo   graphics;
+                    SDL_GPUComputePipelineCreateInfo    compute;
+                } info;
+                void*           storage;        // copies of everything the create info points to
+                void*           result;
+                ReadyCallback   callback;
+                void*           userdata;
+                Uint16          generation;
+                Uint8           kind;
+                Uint8           state;
+                bool            discarded;
+            };
+
+            struct Notification
+            {
+                ReadyCallback   callback;
+                void*           userdata;
+                Handle          handle;
+                bool            succeeded;
+            };
+
+            static SDL_INLINE Uint8* AllocStorage( Job &job, const size_t size )
+            {
+                job.storage = SDL_malloc( size > 0 ? size : 1 );
+                if ( job.storage == nullptr )
+                    SDL_OutOfMemory();
+                return static_cast<Uint8*>( job.storage );
+            }
+
+            SDL_INLINE Handle Submit( Job &job, ReadyCallback callback, void *userdata )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_free( job.storage );
+                    SDL_SetError( "PipelineCompiler not created" );
+                    return 0;
+                }
+
+                job.callback = callback;
+                job.userdata = userdata;
+                job.state = STATE_QUEUED;
+
+                mutex.Lock();
+                int slot;
+                if ( freeSlots.Num() > 0 )
+                {
+                    slot = freeSlots.Last();
+                    freeSlots.RemoveIndexFast( freeSlots.Num() - 1 );
+                    job.generation = jobs[slot].generation;
+                    jobs[slot] = job;
+                }
+                else if ( jobs.Num() < 0xffff && jobs.Append( job ) != nullptr )
+                {
+                    slot = jobs.Num() - 1;
+                    jobs[slot].generation = 1;
+                }
+                else
+                {
+                    mutex.Unlock();
+                    SDL_free( job.storage );
+                    SDL_SetError( "PipelineCompiler has too many jobs" );
+                    return 0;
+                }
+
+                if ( queue.Append( slot ) == nullptr )
+                {
+                    FreeSlot( slot );
+                    mutex.Unlock();
+                    SDL_OutOfMemory();
+                    return 0;
+                }
+                stats.queued++;
+                const Handle handle = MakeHandle( slot );
+                work.Signal();
+                mutex.Unlock();
+                return handle;
+            }
+
+            SDL_INLINE Handle MakeHandle( const int slot ) const
+            {
+                return ( ( Handle )jobs[slot].generation << 16 ) | ( Handle )( slot + 1 );
+            }
+
+            // caller holds the lock
+            SDL_INLINE Job* Find( const Handle handle )
+            {
+                const int slot = ( int )( handle & 0xffff ) - 1;
+                if ( slot < 0 || slot >= jobs.Num() )
+                    return nullptr;
+                Job &job = jobs[slot];
+                return job.state != STATE_FREE && job.generation == ( Uint16 )( handle >> 16 ) ? &job : nullptr;
+            }
+
+            SDL_INLINE const Job* Find( const Handle handle ) const
+            {
+                return const_cast<PipelineCompiler*>( this )->Find( handle );
+            }
+
+            // caller holds the lock
+            SDL_INLINE void FreeSlot( const int slot )
+            {
+                Job &job = jobs[slot];
+                SDL_free( job.storage );
+                job.storage = nullptr;
+                job.result = nullptr;
+                job.state = STATE_FREE;
+                // skip 0 so a handle is never 0
+                job.generation = job.generation == 0xffff ? 1 : ( Uint16 )( job.generation + 1 );
+                freeSlots.Append( slot );
+            }
+
+            // caller holds the lock
+            SDL_INLINE void RemoveQueued( const int slot )
+            {
+                for ( int i = 0; i < queue.Num(); i++ )
+                {
+                    if ( queue[i] == slot )
+                    {
+                        queue.RemoveIndex( i );
+                        return;
+                    }
+                }
+            }
+
+            SDL_INLINE void* GetResult( const Handle handle, const Uint8 kind, void *fallback ) const
+            {
+                mutex.Lock();
+                const Job *job = Find( handle );
+                void *result = job != nullptr && job->kind == kind && job->state == STATE_READY ? job->result : fallback;
+                mutex.Unlock();
+                return result;
+            }
+
+            SDL_INLINE void* TakeResult( const Handle handle, const Uint8 kind )
+            {
+                mutex.Lock();
+                Job *job = Find( handle );
+                void *result = nullptr;
+                if ( job != nullptr && job->kind == kind && job->state == STATE_READY )
+                {
+                    result = job->result;
+                    stats.ready--;
+                    FreeSlot( ( int )( handle & 0xffff ) - 1 );
+                }
+                mutex.Unlock();
+                return result;
+            }
+
+            // runs without the lock, on a copy of the job
+            SDL_INLINE void* Run( const Job &job, double &ms )
+            {
+                const Uint64 start = SDL_GetPerformanceCounter();
+                void *result = nullptr;
+                switch ( job.kind )
+                {
+                case KIND_SHADER:
+                    result = SDL_CreateGPUShader( *device, &job.info.shader );
+                    if ( result != nullptr && cache != nullptr )
+                        cache->RegisterShader( static_cast<SDL_GPUShader*>( result ), job.info.shader );
+                    break;
+                case KIND_GRAPHICS:
+                    if ( cache != nullptr )
+                        result = cache->AcquireGraphicsPipeline( job.info.graphics ).GetHandle();
+                    else
+                        result = SDL_CreateGPUGraphicsPipeline( *device, &job.info.graphics );
+                    break;
+                case KIND_COMPUTE:
+                    if ( cache != nullptr )
+                        result = cache->AcquireComputePipeline( job.info.compute ).GetHandle();
+                    else
+                        result = SDL_CreateGPUComputePipeline( *device, &job.info.compute );
+                    break;
+                }
+                ms = ( double )( SDL_GetPerformanceCounter() - start ) * 1000.0 / ( double )SDL_GetPerformanceFrequency();
+                return result;
+            }
+
+            // caller holds the lock
+            SDL_INLINE void Finish( const int slot, void *result, const double ms )
+            {
+                Job &job = jobs[slot];
+                stats.running--;
+                stats.compileMS += ms;
+                if ( ms > stats.maxCompileMS )
+                    stats.maxCompileMS = ms;
+                if ( result != nullptr )
+                    stats.compiled++;
+                else
+                    stats.failed++;
+
+                if ( job.discarded )
+                {
+                    DestroyResult( job.kind, result );
+                    FreeSlot( slot );
+                }
+                else
+                {
+                    job.result = result;
+                    job.state = result != nullptr ? STATE_READY : STATE_FAILED;
+                    if ( result != nullptr )
+                        stats.ready++;
+                    // the copies are not needed anymore
+                    SDL_free( job.storage );
+                    job.storage = nullptr;
+                    if ( job.callback != nullptr )
+                    {
+                        Notification notification;
+                        notification.callback = job.callback;
+                        notification.userdata = job.userdata;
+                        notification.handle = MakeHandle( slot );
+                        notification.succeeded = result != nullptr;
+                        completed.Append( notification );
+                    }
+                }
+                done.Broadcast();
+            }
+
+            SDL_INLINE void DestroyResult( const Uint8 kind, void *result )
+            {
+                if ( result == nullptr )
+                    return;
+
+                switch ( kind )
+                {
+                case KIND_SHADER:
+                    if ( cache != nullptr )
+                        cache->UnregisterShader( static_cast<SDL_GPUShader*>( result ) );
+                    SDL_ReleaseGPUShader( *device, static_cast<SDL_GPUShader*>( result ) );
+                    break;
+                case KIND_GRAPHICS:
+                    if ( cache != nullptr )
+                        cache->Release( static_cast<SDL_GPUGraphicsPipeline*>( result ) );
+                    else
+                        SDL_ReleaseGPUGraphicsPipeline( *device, static_cast<SDL_GPUGraphicsPipeline*>( result ) );
+                    break;
+                case KIND_COMPUTE:
+                    if ( cache != nullptr )
+                        cache->Release( static_cast<SDL_GPUComputePipeline*>( result ) );
+                    else
+                        SDL_ReleaseGPUComputePipeline( *device, static_cast<SDL_GPUComputePipeline*>( result ) );
+                    break;
+                }
+            }
+
+            static int SDLCALL WorkerMain( void *data )
+            {
+                PipelineCompiler *compiler = static_cast<PipelineCompiler*>( data );
+                compiler->mutex.Lock();
+                for ( ;; )
+                {
+                    while ( !compiler->quit && compiler->queue.Num() == 0 )
+                        compiler->work.Wait( compiler->mutex );
+                    if ( compiler->quit )
+                        break;
+
+                    const int slot = compiler->queue[0];
+                    compiler->queue.RemoveIndex( 0 );
+                    Job &job = compiler->jobs[slot];
+                    job.state = STATE_RUNNING;
+                    compiler->stats.queued--;
+                    compiler->stats.running++;
+                    // the job array may grow while the lock is dropped
+                    const Job local = job;
+                    compiler->mutex.Unlock();
+
+                    double ms;
+                    void *result = compiler->Run( local, ms );
+
+                    compiler->mutex.Lock();
+                    compiler->Finish( slot, result, ms );
+                }
+                compiler->mutex.Unlock();
+                return 0;
+            }
+
+            const Device*           device;
+            PipelineCache*          cache;
+            mutable Mutex           mutex;
+            Condition               work;           // signaled when a job is queued
+            Condition               done;           // broadcast when a job finishes
+            Array<SDL_Thread*>      threads;
+            Array<Job>              jobs;
+            Array<int>              freeSlots;
+            Array<int>              queue;          // slots, oldest first
+            Array<Notification>     completed;      // waiting for Poll
+            bool                    quit;
+            Stats                   stats;
+        };
+    }
+}
+#endif //!__SDL_PIPELINE_COMPILER_HPP__
@@ -0,0 +1,459 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_READBACK_HPP__
+#define __SDL_READBACK_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+ReadbackManager
+==================================================================
+    Downloads textures and buffers without waiting for the GPU. The
+    Download calls record the copy into a pooled transfer buffer, and
+    EndFrame takes the fence of the command buffer holding them. Poll
+    queries the fences of the frames in flight ( in submission order )
+    and, for every readback whose frame is done, maps its transfer
+    buffer and calls the callback with the data; the buffer goes back
+    to the pool afterwards, and buffers left unused for a while are
+    released.
+
+    At most max_in_flight readbacks are pending at once, a Download
+    beyond that fails and can be retried on a later frame ( a picking
+    query can simply be skipped ). The data given to the callback is
+    only valid during the call, texture data is tightly packed.
+
+    Example usage:
+        SDL::GPU::ReadbackManager readback;
+        readback.Create( device, 8 );
+        ...
+        SDL_GPUTextureRegion pixel = { idTexture, 0, 0, mouseX, mouseY, 0, 1, 1, 1 };
+        readback.DownloadTexture( copyPass, pixel, SDL_GPU_TEXTUREFORMAT_R32_UINT, OnPicked, &scene );
+        ...
+        readback.EndFrame( commandBuffer.SubmitAndAcquireFence() );
+        ...
+        // every frame
+        readback.Poll();
+
+        static void SDLCALL OnPicked( void *userdata, SDL::GPU::ReadbackManager::Handle handle, const void *data, Uint32 size )
+        {
+            if ( data != nullptr )
+                static_cast<Scene*>( userdata )->Select( *static_cast<const Uint32*>( data ) );
+        }
+==================================================================
+*/
+        class ReadbackManager
+        {
+        public:
+            typedef Uint32 Handle;
+
+            static const Handle INVALID_HANDLE = 0;
+            // transfer buffer sizes are rounded up to this, so close sizes share buffers
+            static const Uint32 SIZE_GRANULARITY = 4096;
+            // frames a pooled transfer buffer may stay unused before it is released
+            static const Uint64 MAX_IDLE_FRAMES = 120;
+
+            /// @param data the downloaded bytes, only valid during the call, nullptr if the transfer buffer could not be mapped.
+            typedef void ( SDLCALL *ReadyCallback )( void *userdata, Handle handle, const void *data, Uint32 size );
+
+            struct Stats
+            {
+                int     inFlight;
+                int     pooledBuffers;
+                Uint64  pooledBytes;
+                Uint64  completed;
+                Uint64  rejected;       // Download calls over max_in_flight
+                Uint64  bytes;
+                Uint64  buffersCreated;
+            };
+
+            ReadbackManager( void ) : device( nullptr ), maxInFlight( 0 ), nextHandle( 1 ), frame( 1 ), frameDownloads( 0 )
+            {
+                SDL_zero( counters );
+            }
+            ~ReadbackManager( void ) { Destroy(); }
+
+            /// @param device the device, it must outlive the manager.
+            /// @param max_in_flight readbacks pending at most.
+            SDL_INLINE bool Create( const Device &_device, const int max_in_flight = 16 )
+            {
+                Destroy();
+                if ( max_in_flight < 1 )
+                    return SDL_SetError( "ReadbackManager: invalid max_in_flight %d", max_in_flight );
+                device = &_device;
+                maxInFlight = max_in_flight;
+                nextHandle = 1;
+                frame = 1;
+                frameDownloads = 0;
+                SDL_zero( counters );
+                return true;
+            }
+
+            /// @brief Wait for the frames in flight and release everything, pending callbacks are not called.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() != nullptr )
+                    {
+                        fence.WaitForFence( *device, true );
+                        fence.Release( *device );
+                    }
+                }
+                for ( int i = 0; i < pool.Num(); i++ )
+                {
+                    TransferBuffer buffer( pool[i].buffer );
+                    buffer.Release( *device );
+                }
+                frames.Free();
+                pool.Free();
+                pending.Free();
+                device = nullptr;
+            }
+
+            /// @brief Record the download of a texture region.
+            /// @param format format of the texture, for the size of the region.
+            /// @return the handle given to the callback, INVALID_HANDLE if too many readbacks are in flight or on failure.
+            SDL_INLINE Handle DownloadTexture( const CopyPass &copyPass, const SDL_GPUTextureRegion &region, const SDL_GPUTextureFormat format,
+                                               ReadyCallback callback, void *userdata = nullptr )
+            {
+                const Uint32 size = SDL_CalculateGPUTextureFormatSize( format, region.w, region.h, region.d > 0 ? region.d : 1 );
+                int index;
+                const Handle handle = Begin( size, callback, userdata, index );
+                if ( handle == INVALID_HANDLE )
+                    return INVALID_HANDLE;
+
+                SDL_GPUTextureTransferInfo destination;
+                SDL_zero( destination );
+                destination.transfer_buffer = pool[index].buffer;
+                copyPass.DownloadFromTexture( &region, &destination );
+                return handle;
+            }
+
+            /// @brief Record the download of a buffer region.
+            SDL_INLINE Handle DownloadBuffer( const CopyPass &copyPass, const SDL_GPUBufferRegion &region, ReadyCallback callback, void *userdata = nullptr )
+            {
+                int index;
+                const Handle handle = Begin( region.size, callback, userdata, index );
+                if ( handle == INVALID_HANDLE )
+                    return INVALID_HANDLE;
+
+                SDL_GPUTransferBufferLocation destination;
+                destination.transfer_buffer = pool[index].buffer;
+                destination.offset = 0;
+                copyPass.DownloadFromBuffer( &region, &destination );
+                return handle;
+            }
+
+            /// @brief Drop a pending readback, its callback is not called.
+            SDL_INLINE bool Cancel( const Handle handle )
+            {
+                for ( int i = 0; i < pending.Num(); i++ )
+                {
+                    if ( pending[i].handle == handle )
+                    {
+                        pending[i].callback = nullptr;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            SDL_INLINE bool IsPending( const Handle handle ) const
+            {
+                for ( int i = 0; i < pending.Num(); i++ )
+                {
+                    if ( pending[i].handle == handle )
+                        return true;
+                }
+                return false;
+            }
+
+            /// @brief Close the frame, the downloads recorded since the previous EndFrame are ready when fence signals.
+            /// @param fence the fence of the command buffer holding the downloads, the manager releases it.
+            SDL_INLINE bool EndFrame( SDL_GPUFence *fence )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "ReadbackManager: not created" );
+
+                if ( frameDownloads > 0 || fence == nullptr )
+                {
+                    // without a fence the frame completes with the next one, command buffers finish in order
+                    Frame entry;
+                    entry.fence = fence;
+                    entry.frame = frame;
+                    frames.Append( entry );
+                }
+                else
+                {
+                    Fence( fence ).Release( *device );
+                }
+                frame++;
+                frameDownloads = 0;
+                return fence != nullptr ? true : SDL_SetError( "ReadbackManager: EndFrame without a fence" );
+            }
+
+            /// @brief Call the callbacks of the readbacks whose frame is done, and release the idle buffers.
+            SDL_INLINE void Poll( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                int done = -1;
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() == nullptr )
+                        continue;
+                    if ( !fence.Query( *device ) )
+                        break;
+                    done = i;
+                }
+                if ( done >= 0 )
+                    Complete( done );
+                Trim();
+            }
+
+            /// @brief Wait for every frame in flight and call the callbacks, for a screenshot on exit.
+            SDL_INLINE void Flush( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                int done = -1;
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() == nullptr )
+                        continue;
+                    fence.WaitForFence( *device, true );
+                    done = i;
+                }
+                if ( done >= 0 )
+                    Complete( done );
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats = counters;
+                stats.inFlight = pending.Num();
+                stats.pooledBuffers = pool.Num();
+                for ( int i = 0; i < pool.Num(); i++ )
+                    stats.pooledBytes += pool[i].size;
+                return stats;
+            }
+
+        private:
+            ReadbackManager( const ReadbackManager & );
+            ReadbackManager &operator=( const ReadbackManager & );
+
+            struct Pending
+            {
+                Handle          handle;
+                int             buffer;     // into pool
+                Uint32          size;
+                Uint64          frame;
+                ReadyCallback   callback;
+                void*           userdata;
+            };
+
+            struct Staging
+            {
+                SDL_GPUTransferBuffer*  buffer;
+                Uint32                  size;
+                Uint64                  lastUsed;
+                bool                    busy;
+            };
+
+            struct Frame
+            {
+                SDL_GPUFence*   fence;
+                Uint64          frame;
+            };
+
+            SDL_INLINE Handle Begin( const Uint32 size, ReadyCallback callback, void *userdata, int &index )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "ReadbackManager: not created" );
+                    return INVALID_HANDLE;
+                }
+                if ( size == 0 )
+                {
+                    SDL_SetError( "ReadbackManager: empty download" );
+                    return INVALID_HANDLE;
+                }
+                if ( pending.Num() >= maxInFlight )
+                {
+                    counters.rejected++;
+                    SDL_SetError( "ReadbackManager: %d readbacks already in flight", maxInFlight );
+                    return INVALID_HANDLE;
+                }
+
+                index = AcquireBuffer( size );
+                if ( index < 0 )
+                    return INVALID_HANDLE;
+
+                Pending *entry = pending.AppendUninitialized( 1 );
+                if ( entry == nullptr )
+                {
+                    pool[index].busy = false;
+                    SDL_OutOfMemory();
+                    return INVALID_HANDLE;
+                }
+                entry->handle = nextHandle++;
+                if ( nextHandle == INVALID_HANDLE )
+                    nextHandle = 1;
+                entry->buffer = index;
+                entry->size = size;
+                entry->frame = frame;
+                entry->callback = callback;
+                entry->userdata = userdata;
+                frameDownloads++;
+                return entry->handle;
+            }
+
+            // the smallest free pooled buffer that fits, or a new one
+            SDL_INLINE int AcquireBuffer( const Uint32 size )
+            {
+                int best = -1;
+                for ( int i = 0; i < pool.Num(); i++ )
+                {
+                    const Staging &staging = pool[i];
+                    if ( !staging.busy && staging.size >= size && ( best < 0 || staging.size < pool[best].size ) )
+                        best = i;
+                }
+                if ( best < 0 )
+                {
+                    SDL_GPUTransferBufferCreateInfo info;
+                    SDL_zero( info );
+                    info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+                    info.size = ( size + SIZE_GRANULARITY - 1 ) / SIZE_GRANULARITY * SIZE_GRANULARITY;
+                    TransferBuffer buffer;
+                    if ( !buffer.Create( *device, &info ) )
+                        return -1;
+
+                    Staging *staging = pool.AppendUninitialized( 1 );
+                    if ( staging == nullptr )
+                    {
+                        buffer.Release( *device );
+                        SDL_OutOfMemory();
+                        return -1;
+                    }
+                    staging->buffer = buffer.GetHandle();
+                    staging->size = info.size;
+                    counters.buffersCreated++;
+                    best = pool.Num() - 1;
+                }
+                pool[best].busy = true;
+                pool[best].lastUsed = frame;
+                return best;
+            }
+
+            // frames up to index are done
+            SDL_INLINE void Complete( const int index )
+            {
+                const Uint64 completed = frames[index].frame;
+                for ( int i = 0; i <= index; i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() != nullptr )
+                        fence.Release( *device );
+                }
+                for ( int i = index; i >= 0; i-- )
+                    frames.RemoveIndex( i );
+
+                // taken out first, the callbacks may record new downloads
+                Array<Pending> ready;
+                for ( int i = 0; i < pending.Num(); i++ )
+                {
+                    if ( pending[i].frame > completed )
+                        continue;
+                    ready.Append( pending[i] );
+                    pending.RemoveIndex( i-- );
+                }
+
+                for ( int i = 0; i < ready.Num(); i++ )
+                {
+                    const Pending &entry = ready[i];
+                    if ( entry.callback != nullptr )
+                    {
+                        TransferBuffer buffer( pool[entry.buffer].buffer );
+                        const void *data = buffer.Map( *device, false );
+                        entry.callback( entry.userdata, entry.handle, data, data != nullptr ? entry.size : 0 );
+                        if ( data != nullptr )
+                            buffer.Unmap( *device );
+                        counters.bytes += entry.size;
+                    }
+                    counters.completed++;
+                    // index again, the callback may have grown the pool
+                    pool[entry.buffer].busy = false;
+                }
+            }
+
+            SDL_INLINE void Trim( void )
+            {
+                for ( int i = pool.Num() - 1; i >= 0; i-- )
+                {
+                    if ( pool[i].busy || frame - pool[i].lastUsed <= MAX_IDLE_FRAMES )
+                        continue;
+                    TransferBuffer buffer( pool[i].buffer );
+                    buffer.Release( *device );
+                    // keep the indices of the pending readbacks valid
+                    const int last = pool.Num() - 1;
+                    for ( int p = 0; p < pending.Num(); p++ )
+                    {
+                        if ( pending[p].buffer == last )
+                            pending[p].buffer = i;
+                    }
+                    pool.RemoveIndexFast( i );
+                }
+            }
+
+            const Device*           device;
+            int                     maxInFlight;
+            Handle                  nextHandle;
+            Uint64                  frame;
+            int                     frameDownloads;
+            Array<Pending>          pending;        // in request order
+            Array<Staging>          pool;
+            Array<Frame>            frames;
+            Stats                   counters;
+        };
+    }
+}
+#endif //!__SDL_READBACK_HPP__
@@ -0,0 +1,521 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_REGISTRY_HPP__
+#define __SDL_REGISTRY_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_hashmap.hpp"
+#include "SDL_mutex.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_pipelinecache.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+ObjectRegistry
+==================================================================
+    The shared part of SamplerRegistry and ShaderRegistry: objects
+    keyed by the bytes of their create info, reference counted, and
+    released with their last reference.
+
+    Keys with the same hash are chained, and compared byte for byte.
+    An object requested while another thread creates it waits for
+    that creation instead of creating a duplicate. Every method is
+    thread safe.
+==================================================================
+*/
+        class ObjectRegistry
+        {
+        public:
+            struct Stats
+            {
+                int     objects;        // alive objects
+                int     references;     // outstanding references
+                int     hits;
+                int     misses;
+                int     waits;          // acquires that waited for another thread's creation
+                int     failures;
+            };
+
+            ~ObjectRegistry( void ) { Destroy(); }
+
+            SDL_INLINE bool Create( const Device &gpu_device )
+            {
+                if ( device != nullptr )
+                    return SDL_SetError( "ObjectRegistry already created" );
+
+                if ( !mutex.Create() )
+                    return false;
+                if ( !ready.Create() )
+                {
+                    mutex.Destroy();
+                    return false;
+                }
+                device = &gpu_device;
+                return true;
+            }
+
+            /// @brief Release every object, even referenced ones.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < entries.Num(); i++ )
+                {
+                    Entry &entry = entries[i];
+                    if ( entry.object != nullptr )
+                        ReleaseObject( entry.object );
+                    SDL_free( entry.key );
+                }
+                entries.Free();
+                byKey.Free();
+                byObject.Free();
+                firstFree = -1;
+                SDL_zero( stats );
+
+                ready.Destroy();
+                mutex.Destroy();
+                device = nullptr;
+            }
+
+            /// @brief Number of references to an object of the registry, 0 if it is not one.
+            SDL_INLINE int GetReferences( const void *object ) const
+            {
+                mutex.Lock();
+                const int *index = byObject.Find( ( uintptr_t )object );
+                const int refs = index != nullptr ? entries[*index].refs : 0;
+                mutex.Unlock();
+                return refs;
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                mutex.Lock();
+                Stats result = stats;
+                mutex.Unlock();
+                return result;
+            }
+
+        protected:
+            enum Kind
+            {
+                KIND_SAMPLER,
+                KIND_SHADER
+            };
+
+            ObjectRegistry( const Kind registry_kind ) : device( nullptr ), kind( registry_kind ), firstFree( -1 )
+            {
+                SDL_zero( stats );
+            }
+
+            /// @brief Get ( or create ) the object of a key and add a reference to it.
+            SDL_INLINE void* Acquire( const Uint64 hash, const void *key, const Uint32 keySize, const void *createinfo )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "ObjectRegistry not created" );
+                    return nullptr;
+                }
+
+                mutex.Lock();
+                bool waited = false;
+                for ( ;; )
+                {
+                    const int index = FindEntry( hash, key, keySize );
+                    if ( index < 0 )
+                        break;
+                    Entry &entry = entries[index];
+                    if ( entry.object == nullptr )
+                    {
+                        // being created, look again once done, it may have failed
+                        if ( !waited )
+                            stats.waits++;
+                        waited = true;
+                        ready.Wait( mutex );
+                        continue;
+                    }
+                    entry.refs++;
+                    stats.references++;
+                    stats.hits++;
+                    void *object = entry.object;
+                    mutex.Unlock();
+                    return object;
+                }
+
+                const int index = AddEntry( hash, key, keySize );
+                if ( index < 0 )
+                {
+                    stats.failures++;
+                    mutex.Unlock();
+                    return nullptr;
+                }
+                stats.misses++;
+                mutex.Unlock();
+
+                // create without holding the lock, other keys can be acquired meanwhile
+                void *object;
+                if ( kind == KIND_SAMPLER )
+                    object = SDL_CreateGPUSampler( *device, static_cast<const SDL_GPUSamplerCreateInfo*>( createinfo ) );
+                else
+                    object = SDL_CreateGPUShader( *device, static_cast<const SDL_GPUShaderCreateInfo*>( createinfo ) );
+
+                mutex.Lock();
+                if ( object != nullptr && byObject.Insert( ( uintptr_t )object, index ) == nullptr )
+                {
+                    ReleaseObject( object );
+                    object = nullptr;
+                    SDL_OutOfMemory();
+                }
+                if ( object != nullptr )
+                {
+                    Entry &entry = entries[index];
+                    entry.object = object;
+                    entry.refs = 1;
+                    stats.objects++;
+                    stats.references++;
+                }
+                else
+                {
+                    RemoveEntry( index );
+                    stats.failures++;
+                }
+                ready.Broadcast();
+                mutex.Unlock();
+                return object;
+            }
+
+            SDL_INLINE bool Retain( const void *object )
+            {
+                mutex.Lock();
+                const int *index = byObject.Find( ( uintptr_t )object );
+                const bool found = index != nullptr;
+                if ( found )
+                {
+                    entries[*index].refs++;
+                    stats.references++;
+                }
+                mutex.Unlock();
+                return found ? true : SDL_SetError( "Object was not acquired from this registry" );
+            }
+
+            SDL_INLINE void Release( const void *object )
+            {
+                if ( object == nullptr )
+                    return;
+
+                mutex.Lock();
+                const int *index = byObject.Find( ( uintptr_t )object );
+                if ( index != nullptr )
+                {
+                    const int i = *index;
+                    stats.references--;
+                    if ( --entries[i].refs == 0 )
+                    {
+                        byObject.Remove( ( uintptr_t )object );
+                        ReleaseObject( entries[i].object );
+                        RemoveEntry( i );
+                        stats.objects--;
+                    }
+                }
+                else
+                {
+                    SDL_SetError( "Object was not acquired from this registry" );
+                }
+                mutex.Unlock();
+            }
+
+            // caller holds the lock
+            SDL_INLINE Uint64 GetHash( const void *object ) const
+            {
+                const int *index = byObject.Find( ( uintptr_t )object );
+                return index != nullptr ? entries[*index].hash : 0;
+            }
+
+            const Device*       device;
+            mutable Mutex       mutex;
+
+        private:
+            ObjectRegistry( const ObjectRegistry & );
+            ObjectRegistry &operator=( const ObjectRegistry & );
+
+            struct Entry
+            {
+                void*   object;     // nullptr while being created
+                Uint8*  key;
+                Uint32  keySize;
+                Uint64  hash;
+                int     refs;
+                int     next;       // next entry with the same hash, or next free entry
+            };
+
+            // caller holds the lock
+            SDL_INLINE int FindEntry( const Uint64 hash, const void *key, const Uint32 keySize ) const
+            {
+                const int *first = byKey.Find( hash );
+                for ( int i = first != nullptr ? *first : -1; i >= 0; i = entries[i].next )
+                {
+                    const Entry &entry = entries[i];
+                    if ( entry.keySize == keySize && SDL_memcmp( entry.key, key, keySize ) == 0 )
+                        return i;
+                }
+                return -1;
+            }
+
+            // caller holds the lock
+            SDL_INLINE int AddEntry( const Uint64 hash, const void *key, const Uint32 keySize )
+            {
+                Uint8 *copy = static_cast<Uint8*>( SDL_malloc( keySize ) );
+                if ( copy == nullptr )
+                {
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+                SDL_memcpy( copy, key, keySize );
+
+                int index = firstFree;
+                if ( index < 0 )
+                {
+                    if ( entries.AppendUninitialized( 1 ) == nullptr )
+                    {
+                        SDL_free( copy );
+                        SDL_OutOfMemory();
+                        return -1;
+                    }
+                    index = entries.Num() - 1;
+                }
+                const int *first = byKey.Find( hash );
+                const int next = first != nullptr ? *first : -1;
+                if ( byKey.Insert( hash, index ) == nullptr )
+                {
+                    if ( index != firstFree )
+                        entries.Resize( index );
+                    SDL_free( copy );
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+                if ( index == firstFree )
+                    firstFree = entries[index].next;
+
+                Entry &entry = entries[index];
+                entry.object = nullptr;
+                entry.key = copy;
+                entry.keySize = keySize;
+                entry.hash = hash;
+                entry.refs = 0;
+                entry.next = next;
+                return index;
+            }
+
+            // caller holds the lock
+            SDL_INLINE void RemoveEntry( const int index )
+            {
+                Entry &entry = entries[index];
+                int *link = byKey.Find( entry.hash );
+                if ( *link == index )
+                {
+                    if ( entry.next >= 0 )
+                        *link = entry.next;
+                    else
+                        byKey.Remove( entry.hash );
+                }
+                else
+                {
+                    int i = *link;
+                    while ( entries[i].next != index )
+                        i = entries[i].next;
+                    entries[i].next = entry.next;
+                }
+                SDL_free( entry.key );
+                entry.object = nullptr;
+                entry.key = nullptr;
+                entry.keySize = 0;
+                entry.refs = 0;
+                entry.next = firstFree;
+                firstFree = index;
+            }
+
+            SDL_INLINE void ReleaseObject( void *object )
+            {
+                if ( kind == KIND_SAMPLER )
+                    SDL_ReleaseGPUSampler( *device, static_cast<SDL_GPUSampler*>( object ) );
+                else
+                    SDL_ReleaseGPUShader( *device, static_cast<SDL_GPUShader*>( object ) );
+            }
+
+            Kind                kind;
+            Condition           ready;          // broadcast when a pending creation finishes
+            Array<Entry>        entries;
+            HashMap<int>        byKey;          // hash -> first entry of the chain
+            HashMap<int>        byObject;       // object pointer -> entry
+            int                 firstFree;
+            Stats               stats;
+        };
+
+/*
+==================================================================
+SamplerRegistry
+==================================================================
+    Shares samplers between the materials asking for the same state.
+    Acquire returns the sampler already created for an equal create
+    info ( properties left out ) with one more reference, so equal
+    samplers are the same pointer and pipelines and bind caches can
+    compare them by address. Release drops a reference, the sampler
+    is released with the last one.
+
+    Example usage:
+        SDL::GPU::SamplerRegistry samplers;
+        samplers.Create( device );
+        ...
+        SDL::GPU::Sampler linear = samplers.Acquire( linearInfo );
+        ...
+        samplers.Release( linear );
+==================================================================
+*/
+        class SamplerRegistry : public ObjectRegistry
+        {
+        public:
+            SamplerRegistry( void ) : ObjectRegistry( KIND_SAMPLER ) {}
+
+            /// @return the shared sampler, or a null sampler if creation failed.
+            SDL_INLINE Sampler Acquire( const SDL_GPUSamplerCreateInfo &info )
+            {
+                Key key;
+                BuildKey( info, key );
+                return Sampler( static_cast<SDL_GPUSampler*>( ObjectRegistry::Acquire( HashValue( key ), &key, sizeof( key ), &info ) ) );
+            }
+
+            /// @brief Add a reference to an acquired sampler, for a second owner.
+            SDL_INLINE bool Retain( SDL_GPUSampler *sampler ) { return ObjectRegistry::Retain( sampler ); }
+            SDL_INLINE void Release( SDL_GPUSampler *sampler ) { ObjectRegistry::Release( sampler ); }
+
+        private:
+            // the create info fields, without padding
+            struct Key
+            {
+                Uint32  fields[8];
+                float   values[4];
+            };
+
+            static SDL_INLINE void BuildKey( const SDL_GPUSamplerCreateInfo &info, Key &key )
+            {
+                key.fields[0] = ( Uint32 )info.min_filter;
+                key.fields[1] = ( Uint32 )info.mag_filter;
+                key.fields[2] = ( Uint32 )info.mipmap_mode;
+                key.fields[3] = ( Uint32 )info.address_mode_u;
+                key.fields[4] = ( Uint32 )info.address_mode_v;
+                key.fields[5] = ( Uint32 )info.address_mode_w;
+                key.fields[6] = info.enable_anisotropy ? 1u : 0u;
+                // the compare op and max anisotropy are ignored when disabled
+                key.fields[7] = info.enable_compare ? 1u + ( Uint32 )info.compare_op : 0u;
+                key.values[0] = info.mip_lod_bias;
+                key.values[1] = info.enable_anisotropy ? info.max_anisotropy : 0.0f;
+                key.values[2] = info.min_lod;
+                key.values[3] = info.max_lod;
+            }
+        };
+
+/*
+==================================================================
+ShaderRegistry
+==================================================================
+    Shares shaders between the materials loading the same code.
+    Shaders are keyed by their bytecode, entry point, format, stage
+    and resource counts ( properties left out ). Acquire returns the
+    shader already created for an equal create info with one more
+    reference, Release drops a reference and the shader is released
+    with the last one.
+
+    GetId returns the PipelineCache::HashShader of a shader, to
+    register it with a PipelineCache so pipelines using it can be
+    persisted.
+
+    Example usage:
+        SDL::GPU::ShaderRegistry shaders;
+        shaders.Create( device );
+        ...
+        SDL::GPU::Shader vertex = shaders.Acquire( vertexInfo );
+        pipelineCache.RegisterShader( vertex, shaders.GetId( vertex ) );
+        ...
+        pipelineCache.UnregisterShader( vertex );
+        shaders.Release( vertex );
+==================================================================
+*/
+        class ShaderRegistry : public ObjectRegistry
+        {
+        public:
+            ShaderRegistry( void ) : ObjectRegistry( KIND_SHADER ) {}
+
+            /// @return the shared shader, or a null shader if creation failed.
+            SDL_INLINE Shader Acquire( const SDL_GPUShaderCreateInfo &info )
+            {
+                if ( info.code == nullptr || info.code_size == 0 || info.code_size > 0x7fffffff )
+                {
+                    SDL_SetError( "ShaderRegistry: invalid shader code" );
+                    return Shader();
+                }
+
+                // resource counts, the entry point with its terminator, then the code
+                const Uint32 fields[] = { ( Uint32 )info.format, ( Uint32 )info.stage, info.num_samplers,
+                    info.num_storage_textures, info.num_storage_buffers, info.num_uniform_buffers };
+                const char *entrypoint = info.entrypoint != nullptr ? info.entrypoint : "";
+                const Uint32 entrySize = ( Uint32 )SDL_strlen( entrypoint ) + 1;
+                Array<Uint8> key;
+                Uint8 *dst = key.AppendUninitialized( ( int )( sizeof( fields ) + entrySize + info.code_size ) );
+                if ( dst == nullptr )
+                {
+                    SDL_OutOfMemory();
+                    return Shader();
+                }
+                SDL_memcpy( dst, fields, sizeof( fields ) );
+                SDL_memcpy( dst + sizeof( fields ), entrypoint, entrySize );
+                SDL_memcpy( dst + sizeof( fields ) + entrySize, info.code, info.code_size );
+
+                const Uint64 hash = PipelineCache::HashShader( info );
+                return Shader( static_cast<SDL_GPUShader*>( ObjectRegistry::Acquire( hash, key.Ptr(), ( Uint32 )key.Num(), &info ) ) );
+            }
+
+            /// @brief Add a reference to an acquired shader, for a second owner.
+            SDL_INLINE bool Retain( SDL_GPUShader *shader ) { return ObjectRegistry::Retain( shader ); }
+            SDL_INLINE void Release( SDL_GPUShader *shader ) { ObjectRegistry::Release( shader ); }
+
+            /// @return the PipelineCache::HashShader of the create info of an acquired shader, 0 if unknown.
+            SDL_INLINE Uint64 GetId( SDL_GPUShader *shader ) const
+            {
+                mutex.Lock();
+                const Uint64 id = GetHash( shader );
+                mutex.Unlock();
+                return id;
+            }
+        };
+    }
+}
+#endif //!__SDL_REGISTRY_HPP__
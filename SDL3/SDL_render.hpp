@@ -31,6 +31,7 @@
 #include <SDL3/SDL_render.h>
 #include "SDL_surface.hpp"
 #include "SDL_window.hpp"
+#include "SDL_instrument.hpp"
 
 namespace SDL
 {
@@ -43,10 +44,11 @@ namespace SDL
         Renderer( void ) : renderer( nullptr ){}
         Renderer( const Renderer &ref ) : renderer( ref.renderer ){}
         Renderer( SDL_Renderer* ptr ) : renderer( ptr ) {}
-        ~Renderer( void );
+        ~Renderer( void ) {}
 
         SDL_INLINE bool             Create( const Window &window, const char *name )
         {
+            SDL3PP_RENDER_CALL( "Renderer::Create", RESOURCE );
             renderer = SDL_CreateRenderer( window, name );
             if ( !renderer )
                 return false;
@@ -55,6 +57,7 @@ namespace SDL
 
         SDL_INLINE bool             CreateWindowAndRenderer( const char *title, int width, int height, SDL_WindowFlags window_flags, Window* &window )
         {
+            SDL3PP_RENDER_CALL( "Renderer::CreateWindowAndRenderer", RESOURCE );
             SDL_Window* win = nullptr;
             if( !SDL_CreateWindowAndRenderer( title, width, height, window_flags, &win, &renderer ) )
                 return false;
@@ -65,14 +68,16 @@ namespace SDL
 
         SDL_INLINE bool             CreateWithProperties(SDL_PropertiesID props)
         {
+            SDL3PP_RENDER_CALL( "Renderer::CreateWithProperties", RESOURCE );
             renderer = SDL_CreateRendererWithProperties( props );
             if ( !renderer )
                 return false;
             return true;
         }
 
-        SDL_INLINE bool             CreateSoftware( const Surface surface )
+        SDL_INLINE bool             CreateSoftware( const Surface &surface )
         {
+            SDL3PP_RENDER_CALL( "Renderer::CreateSoftware", RESOURCE );
             renderer = SDL_CreateSoftwareRenderer( surface );
             if ( !renderer )
                 return false;
@@ -81,6 +86,7 @@ namespace SDL
 
         SDL_INLINE void             Destroy( void )
         {
+            SDL3PP_RENDER_CALL( "Renderer::Destroy", RESOURCE );
             if( renderer != nullptr )
             {
                 SDL_DestroyRenderer( renderer );
@@ -90,206 +96,219 @@ namespace SDL
         
         SDL_INLINE bool             Present( void ) const 
         {
+            SDL3PP_RENDER_PRESENT( "Renderer::Present" );
             return SDL_RenderPresent( renderer );
         }
 
         SDL_INLINE bool             Flush( void )
         {
+            SDL3PP_RENDER_CALL( "Renderer::Flush", DRAW );
             return SDL_FlushRenderer( renderer );
         }
     
         SDL_INLINE bool             Clear( void )
         {
+            SDL3PP_RENDER_CALL( "Renderer::Clear", DRAW );
             return SDL_RenderClear( renderer );
         }
 
         SDL_INLINE bool GetOutputSize( int* &w, int* &h ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetOutputSize", QUERY );
             return SDL_GetRenderOutputSize( renderer, w, h );
         }
 
         SDL_INLINE bool GetCurrentOutputSize( int* &w, int* &h ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetCurrentOutputSize", QUERY );
             return SDL_GetCurrentRenderOutputSize( renderer, w, h );
         }
         
         SDL_INLINE bool ViewportSet( void )
         {
+            SDL3PP_RENDER_CALL( "Renderer::ViewportSet", QUERY );
             return SDL_RenderViewportSet( renderer );
         }
 
         SDL_INLINE bool SetViewport( const SDL_Rect *rect ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetViewport", STATE );
             return SDL_SetRenderViewport( renderer, rect );
         }
 
         SDL_INLINE bool GetViewport( SDL_Rect* &rect) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetViewport", QUERY );
             return SDL_GetRenderViewport( renderer, rect );
         }
 
         SDL_INLINE bool GetSafeArea( SDL_Rect* &rect) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetSafeArea", QUERY );
             return SDL_GetRenderSafeArea( renderer, rect );
         }
 
         SDL_INLINE bool SetClipRect( const SDL_Rect *rect )
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetClipRect", STATE );
             return SDL_SetRenderClipRect( renderer, rect );
         }
 
         SDL_INLINE bool GetClipRect( SDL_Rect* &rect ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetClipRect", QUERY );
             return SDL_GetRenderClipRect( renderer, rect );    
         }
 
         SDL_INLINE bool ClipEnabled( void )
         {
+            SDL3PP_RENDER_CALL( "Renderer::ClipEnabled", QUERY );
             return SDL_RenderClipEnabled( renderer );
         }
 
         SDL_INLINE bool SetScale( const float scaleX, const float scaleY ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetScale", STATE );
             return SDL_SetRenderScale( renderer, scaleX, scaleY );
         }
 
         SDL_INLINE bool GetScale( float *scaleX, float *scaleY )
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetScale", QUERY );
             return SDL_GetRenderScale( renderer, scaleX, scaleY );
         }
 
         SDL_INLINE bool SetDrawColor( const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a)
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetDrawColor", STATE );
             return SDL_SetRenderDrawColor( renderer, r, g, b, a );
         }
 
         SDL_INLINE bool SetDrawColorFloat( const float r, const float g, const float b, const float a )
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetDrawColorFloat", STATE );
             return SDL_SetRenderDrawColorFloat( renderer, r, g, b, a );
         }
 
         SDL_INLINE bool GetDrawColor( Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetDrawColor", QUERY );
             return SDL_GetRenderDrawColor( renderer, r, g, b, a );
         }
 
         SDL_INLINE bool GetDrawColorFloat( float *r, float *g, float *b, float *a) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetDrawColorFloat", QUERY );
             return SDL_GetRenderDrawColorFloat( renderer, r, g, b, a );
         }
 
         SDL_INLINE bool SetColorScale( const float scale )
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetColorScale", STATE );
             return SDL_SetRenderColorScale( renderer, scale );
         }
 
         SDL_INLINE bool GetColorScale( float *scale)
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetColorScale", QUERY );
             return SDL_GetRenderColorScale( renderer, scale );
         }
 
         SDL_INLINE bool SetDrawBlendMode( const SDL_BlendMode blendMode)
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetDrawBlendMode", STATE );
             return SDL_SetRenderDrawBlendMode( renderer, blendMode );
         }
 
         SDL_INLINE bool GetDrawBlendMode( SDL_BlendMode *blendMode ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetDrawBlendMode", QUERY );
             return SDL_GetRenderDrawBlendMode( renderer, blendMode );
         }
 
         SDL_INLINE bool RenderPoint( const float x, const float y )
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderPoint", DRAW );
             return SDL_RenderPoint( renderer, x, y );
         }
 
         SDL_INLINE bool RenderPoints( const SDL_FPoint *points, const int count )
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderPoints", DRAW );
             return SDL_RenderPoints( renderer, points, count );
         }
         
         SDL_INLINE bool RenderLine( const float x1, const float y1, const float x2, const float y2 )
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderLine", DRAW );
             return SDL_RenderLine( renderer, x1, y1, x2, y2 );
         }
         
         SDL_INLINE bool RenderLines( const SDL_FPoint *points, int count)
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderLines", DRAW );
             return SDL_RenderLines( renderer, points, count );
         }
         
         SDL_INLINE bool RenderRect( const SDL_FRect *rect )
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderRect", DRAW );
             return SDL_RenderRect( renderer, rect );
         }
         
         SDL_INLINE bool RenderRects( const SDL_FRect *rects, int count)
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderRects", DRAW );
             return SDL_RenderRects( renderer, rects, count );
         }
         
         SDL_INLINE bool RenderFillRect( const SDL_FRect *rect)
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderFillRect", DRAW );
             return SDL_RenderFillRect( renderer, rect );
         }
 
         SDL_INLINE bool RenderFillRects( const SDL_FRect *rects, int count )
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderFillRects", DRAW );
             return SDL_RenderFillRects( renderer, rects, count );
         }
 
-        SDL_INLINE bool RenderTexture( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
-        {
-            return SDL_RenderTexture( renderer, texture, srcrect, dstrect );
-        }
+        SDL_INLINE bool RenderTexture( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect);
 
-        SDL_INLINE bool RenderTextureRotated( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect, double angle, const SDL_FPoint *center, SDL_FlipMode flip )
-        {
-            return SDL_RenderTextureRotated( renderer, texture, srcrect, dstrect, angle, center, flip );
-        }
+        SDL_INLINE bool RenderTextureRotated( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect, double angle, const SDL_FPoint *center, SDL_FlipMode flip );
 
-        SDL_INLINE bool RenderTextureAffine( const Texture &texture, const SDL_FRect *srcrect, const SDL_FPoint *origin, const SDL_FPoint *right, const SDL_FPoint *down)
-        {
-            return SDL_RenderTextureAffine( renderer, texture, srcrect, origin, right, down );
-        }
+        SDL_INLINE bool RenderTextureAffine( const Texture &texture, const SDL_FRect *srcrect, const SDL_FPoint *origin, const SDL_FPoint *right, const SDL_FPoint *down);
         
-        SDL_INLINE bool RenderTextureTiled( const Texture &texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect )
-        {
-            return SDL_RenderTextureTiled( renderer, texture, srcrect, scale, dstrect );
-        }
+        SDL_INLINE bool RenderTextureTiled( const Texture &texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect );
 
-        SDL_INLINE bool RenderTexture9Grid( const Texture &texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect )
-        {
-            return SDL_RenderTexture9Grid( renderer, texture, srcrect, left_width, right_width, top_height, bottom_height, scale, dstrect );
-        }
+        SDL_INLINE bool RenderTexture9Grid( const Texture &texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect );
 
-        SDL_INLINE bool RenderGeometry( const Texture texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices )
-        {
-            return SDL_RenderGeometry( renderer, texture, vertices, num_vertices, indices, num_indices );
-        }
+        SDL_INLINE bool RenderGeometry( const Texture texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices );
 
-        SDL_INLINE bool RenderGeometryRaw( const Texture texture, const float *xy, int xy_stride, const SDL_FColor *color, int color_stride, const float *uv, int uv_stride, int num_vertices, const void *indices, int num_indices, int size_indices)
-        {
-            return SDL_RenderGeometryRaw( renderer, texture, xy, xy_stride, color, color_stride, uv, uv_stride, num_indices, indices, num_indices, size_indices );
-        }
+        SDL_INLINE bool RenderGeometryRaw( const Texture texture, const float *xy, int xy_stride, const SDL_FColor *color, int color_stride, const float *uv, int uv_stride, int num_vertices, const void *indices, int num_indices, int size_indices);
         
         SDL_INLINE bool AddVulkanRenderSemaphores( const Uint32 wait_stage_mask, const Sint64 wait_semaphore, const Sint64 signal_semaphore)
         {
+            SDL3PP_RENDER_CALL( "Renderer::AddVulkanRenderSemaphores", STATE );
             return SDL_AddVulkanRenderSemaphores( renderer, wait_stage_mask, wait_semaphore, signal_semaphore );
         }
         
         SDL_INLINE bool SetVSync( const int vsync )
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetVSync", STATE );
             return SDL_SetRenderVSync( renderer, vsync );
         }
         
         SDL_INLINE bool GetVSync( int *vsync) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetVSync", QUERY );
             return SDL_GetRenderVSync( renderer, vsync );
         }
         
         SDL_INLINE bool DebugText( const float x, const float y, const char *str )
         {
+            SDL3PP_RENDER_CALL( "Renderer::DebugText", DRAW );
             return SDL_RenderDebugText( renderer, x, y, str );
         }
 
@@ -299,73 +318,79 @@ namespace SDL
             return false;
         }
         
-        SDL_INLINE bool SetTarget( Texture texture )
-        {
-            return SDL_SetRenderTarget( renderer, texture );
-        }
+        SDL_INLINE bool SetTarget( Texture texture );
         
         SDL_INLINE bool SetLogicalPresentation( const int w, const int h, SDL_RendererLogicalPresentation mode )
         {
+            SDL3PP_RENDER_CALL( "Renderer::SetLogicalPresentation", STATE );
             return SDL_SetRenderLogicalPresentation( renderer, w, h, mode );
         }
         
         SDL_INLINE bool GetLogicalPresentation( int *w, int *h, SDL_RendererLogicalPresentation *mode)
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetLogicalPresentation", QUERY );
             return SDL_GetRenderLogicalPresentation( renderer, w, h, mode );
         }
         
         SDL_INLINE bool GetLogicalPresentationRect( SDL_FRect *rect )
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetLogicalPresentationRect", QUERY );
             return SDL_GetRenderLogicalPresentationRect( renderer, rect );
         }
         
         SDL_INLINE bool CoordinatesFromWindow( const float window_x, float window_y, float *x, float *y)
         {
+            SDL3PP_RENDER_CALL( "Renderer::CoordinatesFromWindow", QUERY );
             return SDL_RenderCoordinatesFromWindow( renderer, window_x, window_y, x, y );
         }
         
         SDL_INLINE bool CoordinatesToWindow( const float x, const float y, float *window_x, float *window_y )
         {
+            SDL3PP_RENDER_CALL( "Renderer::CoordinatesToWindow", QUERY );
             return SDL_RenderCoordinatesToWindow( renderer, x, y, window_x, window_y );
         }
         
         SDL_INLINE bool ConvertEventToRenderCoordinates( SDL_Event *event )
         {
+            SDL3PP_RENDER_CALL( "Renderer::ConvertEventToRenderCoordinates", QUERY );
             return SDL_ConvertEventToRenderCoordinates( renderer, event );
         }
         
         SDL_INLINE void* GetMetalLayer( void ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetMetalLayer", QUERY );
             return SDL_GetRenderMetalLayer( renderer );
         }
         
         SDL_INLINE void* GetMetalCommandEncoder( void ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetMetalCommandEncoder", QUERY );
             return SDL_GetRenderMetalCommandEncoder( renderer );
         }
         
-        SDL_INLINE Texture GetRenderTarget( void ) const
-        {
-            return Texture( SDL_GetRenderTarget(renderer ) );
-        }
+        SDL_INLINE Texture GetRenderTarget( void ) const;
         
         SDL_INLINE Surface RenderReadPixels( const SDL_Rect *rect ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::RenderReadPixels", QUERY );
             return Surface( SDL_RenderReadPixels( renderer, rect ) );
         }
 
         SDL_INLINE const Window  GetWindow( void ) const 
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetWindow", QUERY );
             return Window( SDL_GetRenderWindow( renderer ) );
         }
 
         SDL_INLINE const char*      GetName( void ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetName", QUERY );
             return SDL_GetRendererName( renderer );
         }
 
         SDL_INLINE SDL_PropertiesID GetProperties( void ) const
         {
+            SDL3PP_RENDER_CALL( "Renderer::GetProperties", QUERY );
             return SDL_GetRendererProperties( renderer );
         }
 
@@ -379,31 +404,35 @@ namespace SDL
     class Texture
     {
     public:
-        Texture( void );
+        Texture( void ) : texture( nullptr ) {}
         Texture( const Texture &ref ) : texture( ref.texture ) {}
         Texture( SDL_Texture* _texture ) : texture( _texture ) {} 
-        ~Texture( void );
+        ~Texture( void ) {}
 
         SDL_INLINE bool CreateTexture( const Renderer &renderer, const SDL_PixelFormat format, const SDL_TextureAccess access, const int w, const int h )
         {
+            SDL3PP_RENDER_CALL( "Texture::CreateTexture", RESOURCE );
             texture = SDL_CreateTexture( renderer, format, access, w, h );
             return texture != nullptr; 
         }
 
         SDL_INLINE bool CreateTextureFromSurface( const Renderer &renderer, const Surface &surface)
         {
+            SDL3PP_RENDER_CALL( "Texture::CreateTextureFromSurface", RESOURCE );
             texture = SDL_CreateTextureFromSurface( renderer, surface );
             return texture != nullptr;
         }
         
         SDL_INLINE bool CreateTextureWithProperties( const Renderer &renderer, SDL_PropertiesID props )
         {
+            SDL3PP_RENDER_CALL( "Texture::CreateTextureWithProperties", RESOURCE );
             texture = SDL_CreateTextureWithProperties( renderer, props );
             return texture != nullptr;
         }
         
         SDL_INLINE void Destroy( void )
         {
+            SDL3PP_RENDER_CALL( "Texture::Destroy", RESOURCE );
             if ( texture != nullptr )
             {
                 SDL_DestroyTexture( texture );
@@ -414,106 +443,127 @@ namespace SDL
 
         SDL_INLINE bool GetSize( float *w, float *h ) const 
         {
+            SDL3PP_RENDER_CALL( "Texture::GetSize", QUERY );
             return SDL_GetTextureSize( texture, w, h );
         }
 
         SDL_INLINE bool SetColorMod( const Uint8 r, const Uint8 g, const Uint8 b )
         {
+            SDL3PP_RENDER_CALL( "Texture::SetColorMod", STATE );
             return SDL_SetTextureColorMod( texture, r, g, b );
         }
 
         SDL_INLINE bool SetColorModFloat( const float r, const float g, const float b)
         {
+            SDL3PP_RENDER_CALL( "Texture::SetColorModFloat", STATE );
             return SDL_SetTextureColorModFloat( texture, r, g, b );
         }
 
         SDL_INLINE bool GetColorMod( Uint8 *r, Uint8 *g, Uint8 *b ) const
         {
+            SDL3PP_RENDER_CALL( "Texture::GetColorMod", QUERY );
             return SDL_GetTextureColorMod( texture, r, g, b );
         }
 
         SDL_INLINE bool GetColorModFloat( float *r, float *g, float *b ) const 
         {
+            SDL3PP_RENDER_CALL( "Texture::GetColorModFloat", QUERY );
             return SDL_GetTextureColorModFloat( texture, r, g, b );
         }
 
         SDL_INLINE bool SetAlphaMod( const Uint8 alpha )
         {
+            SDL3PP_RENDER_CALL( "Texture::SetAlphaMod", STATE );
             return SDL_SetTextureAlphaMod( texture, alpha );
         }
 
         SDL_INLINE bool SetAlphaModFloat( const float alpha )
         {
+            SDL3PP_RENDER_CALL( "Texture::SetAlphaModFloat", STATE );
             return SDL_SetTextureAlphaModFloat( texture, alpha );
         }
 
         SDL_INLINE bool GetAlphaMod( Uint8 *alpha ) const
         {
+            SDL3PP_RENDER_CALL( "Texture::GetAlphaMod", QUERY );
             return SDL_GetTextureAlphaMod( texture, alpha );
         }
         
         SDL_INLINE bool GetAlphaModFloat( float *alpha ) const
         {
+            SDL3PP_RENDER_CALL( "Texture::GetAlphaModFloat", QUERY );
             return SDL_GetTextureAlphaModFloat( texture, alpha );
         }
         
         SDL_INLINE bool SetBlendMode( SDL_BlendMode const blendMode ) 
         {
+            SDL3PP_RENDER_CALL( "Texture::SetBlendMode", STATE );
             return SDL_SetTextureBlendMode( texture, blendMode );
         }
         
         SDL_INLINE bool GetBlendMode( SDL_BlendMode *blendMode)
         {
+            SDL3PP_RENDER_CALL( "Texture::GetBlendMode", QUERY );
             return SDL_GetTextureBlendMode( texture, blendMode );
         }
         
         SDL_INLINE bool SetScaleMode( SDL_ScaleMode const scaleMode)
         {
+            SDL3PP_RENDER_CALL( "Texture::SetScaleMode", STATE );
             return SDL_SetTextureScaleMode( texture, scaleMode );
         }
         
         SDL_INLINE bool GetScaleMode( SDL_ScaleMode *scaleMode )
         {
+            SDL3PP_RENDER_CALL( "Texture::GetScaleMode", QUERY );
             return SDL_GetTextureScaleMode( texture, scaleMode );
         }
         
         SDL_INLINE bool Update( const SDL_Rect *rect, const void *pixels, int pitch)
         {
+            SDL3PP_RENDER_CALL( "Texture::Update", UPLOAD );
             return SDL_UpdateTexture( texture, rect, pixels, pitch );
         }
         
         SDL_INLINE bool UpdateYUV( const SDL_Rect *rect, const Uint8 *Yplane, int Ypitch, const Uint8 *Uplane, int Upitch, const Uint8 *Vplane, int Vpitch )
         {
+            SDL3PP_RENDER_CALL( "Texture::UpdateYUV", UPLOAD );
             return SDL_UpdateYUVTexture( texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch );
         }
         
         SDL_INLINE bool UpdateNV( const SDL_Rect *rect, const Uint8 *Yplane, int Ypitch, const Uint8 *UVplane, int UVpitch )
         {
+            SDL3PP_RENDER_CALL( "Texture::UpdateNV", UPLOAD );
             return SDL_UpdateNVTexture( texture, rect, Yplane, Ypitch, UVplane, UVpitch );
         }
         
         SDL_INLINE bool Lock( const SDL_Rect *rect, void **pixels, int *pitch)
         {
+            SDL3PP_RENDER_CALL( "Texture::Lock", UPLOAD );
             return SDL_LockTexture( texture, rect, pixels, pitch );
         }
         
         SDL_INLINE bool LockToSurface( const SDL_Rect *rect, SDL_Surface **surface)
         {
+            SDL3PP_RENDER_CALL( "Texture::LockToSurface", UPLOAD );
             return SDL_LockTextureToSurface( texture, rect, surface );
         }
         
         SDL_INLINE void Unlock( void ) const
         {
+            SDL3PP_RENDER_CALL( "Texture::Unlock", UPLOAD );
             return SDL_UnlockTexture( texture );
         }
         
         SDL_INLINE Renderer GetRendererFromTexture( void ) const
         {
+            SDL3PP_RENDER_CALL( "Texture::GetRendererFromTexture", QUERY );
             return SDL_GetRendererFromTexture( texture );
         }
         
         SDL_INLINE SDL_PropertiesID GetProperties(SDL_Texture *texture) const
         {
+            SDL3PP_RENDER_CALL( "Texture::GetProperties", QUERY );
             return SDL_GetTextureProperties( texture );
         }
 
@@ -524,6 +574,61 @@ namespace SDL
         SDL_Texture*    texture;
 
     };
+
+    // Renderer calls that need the complete Texture type
+    SDL_INLINE bool Renderer::RenderTexture( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderTexture", DRAW );
+        return SDL_RenderTexture( renderer, texture, srcrect, dstrect );
+    }
+
+    SDL_INLINE bool Renderer::RenderTextureRotated( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect, double angle, const SDL_FPoint *center, SDL_FlipMode flip )
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderTextureRotated", DRAW );
+        return SDL_RenderTextureRotated( renderer, texture, srcrect, dstrect, angle, center, flip );
+    }
+
+    SDL_INLINE bool Renderer::RenderTextureAffine( const Texture &texture, const SDL_FRect *srcrect, const SDL_FPoint *origin, const SDL_FPoint *right, const SDL_FPoint *down)
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderTextureAffine", DRAW );
+        return SDL_RenderTextureAffine( renderer, texture, srcrect, origin, right, down );
+    }
+
+    SDL_INLINE bool Renderer::RenderTextureTiled( const Texture &texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect )
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderTextureTiled", DRAW );
+        return SDL_RenderTextureTiled( renderer, texture, srcrect, scale, dstrect );
+    }
+
+    SDL_INLINE bool Renderer::RenderTexture9Grid( const Texture &texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect )
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderTexture9Grid", DRAW );
+        return SDL_RenderTexture9Grid( renderer, texture, srcrect, left_width, right_width, top_height, bottom_height, scale, dstrect );
+    }
+
+    SDL_INLINE bool Renderer::RenderGeometry( const Texture texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices )
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderGeometry", DRAW );
+        return SDL_RenderGeometry( renderer, texture, vertices, num_vertices, indices, num_indices );
+    }
+
+    SDL_INLINE bool Renderer::RenderGeometryRaw( const Texture texture, const float *xy, int xy_stride, const SDL_FColor *color, int color_stride, const float *uv, int uv_stride, int num_vertices, const void *indices, int num_indices, int size_indices)
+    {
+        SDL3PP_RENDER_CALL( "Renderer::RenderGeometryRaw", DRAW );
+        return SDL_RenderGeometryRaw( renderer, texture, xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices, indices, num_indices, size_indices );
+    }
+
+    SDL_INLINE bool Renderer::SetTarget( Texture texture )
+    {
+        SDL3PP_RENDER_CALL( "Renderer::SetTarget", STATE );
+        return SDL_SetRenderTarget( renderer, texture );
+    }
+
+    SDL_INLINE Texture Renderer::GetRenderTarget( void ) const
+    {
+        SDL3PP_RENDER_CALL( "Renderer::GetRenderTarget", QUERY );
+        return Texture( SDL_GetRenderTarget(renderer ) );
+    }
 }
 
 #endif //!__RENDERER_HPP__
\ No newline at end of file
@@ -0,0 +1,1486 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_RENDER_CAPTURE_HPP__
+#define __SDL_RENDER_CAPTURE_HPP__
+
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+#include "SDL_array.hpp"
+#include "SDL_hashmap.hpp"
+#include "SDL_iostream.hpp"
+#include "SDL_render.hpp"
+#include "SDL_surface.hpp"
+
+namespace SDL
+{
+    namespace Capture
+    {
+        static const Uint32 FILE_MAGIC = SDL_FOURCC( 'S', '3', 'P', 'C' );
+        static const Uint16 FILE_VERSION = 1;
+
+        // one byte opcode per recorded call, followed by its arguments in little endian
+        enum Op
+        {
+            OP_PRESENT = 1,
+            OP_CLEAR,
+            OP_SET_DRAW_COLOR,
+            OP_SET_DRAW_COLOR_FLOAT,
+            OP_SET_DRAW_BLEND_MODE,
+            OP_SET_VIEWPORT,
+            OP_SET_CLIP_RECT,
+            OP_SET_SCALE,
+            OP_SET_COLOR_SCALE,
+            OP_SET_LOGICAL_PRESENTATION,
+            OP_SET_TARGET,
+            OP_RENDER_POINTS,
+            OP_RENDER_LINES,
+            OP_RENDER_RECT,
+            OP_RENDER_RECTS,
+            OP_RENDER_FILL_RECT,
+            OP_RENDER_FILL_RECTS,
+            OP_RENDER_TEXTURE,
+            OP_RENDER_TEXTURE_ROTATED,
+            OP_RENDER_TEXTURE_AFFINE,
+            OP_RENDER_TEXTURE_TILED,
+            OP_RENDER_TEXTURE_9GRID,
+            OP_RENDER_GEOMETRY,
+            OP_DEBUG_TEXT,
+            OP_CREATE_TEXTURE,
+            OP_DESTROY_TEXTURE,
+            OP_UPDATE_TEXTURE,
+            OP_UPDATE_TEXTURE_YUV,
+            OP_UPDATE_TEXTURE_NV,
+            OP_TEXTURE_COLOR_MOD,
+            OP_TEXTURE_COLOR_MOD_FLOAT,
+            OP_TEXTURE_ALPHA_MOD,
+            OP_TEXTURE_ALPHA_MOD_FLOAT,
+            OP_TEXTURE_BLEND_MODE,
+            OP_TEXTURE_SCALE_MODE,
+            OP_COUNT
+        };
+
+/*
+==================================================================
+Recorder
+==================================================================
+    Records a rendering session into a compact binary stream, so it
+    can be replayed later without the application, its assets or a
+    display ( see Replayer ).
+
+    The recorder sits in front of a Renderer: draw, state and texture
+    calls made through it are written to the stream and then forwarded
+    to the renderer, so the application keeps running normally while
+    it is recorded. Texture contents are stored with their Update and
+    Unlock calls. Calls made on the Renderer or Texture directly are not
+    seen by the recorder, and textures created before Begin are recorded
+    as blank textures of the same size and format the first time they
+    are used.
+
+    The stream is written in chunks, at every Present and whenever the
+    pending data grows past FLUSH_SIZE.
+
+    Example usage:
+        SDL::IO::Stream file;
+        SDL::Capture::Recorder capture;
+        file.FromFile( "session.s3pc", "wb" );
+        capture.Begin( renderer, file );
+        ...
+        capture.CreateTexture( sprite, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STATIC, 64, 64 );
+        capture.UpdateTexture( sprite, nullptr, pixels, 64 * 4 );
+        ...
+        capture.Clear();
+        capture.RenderTexture( sprite, nullptr, &dst );
+        capture.Present();
+        ...
+        capture.End();
+        file.Close();
+==================================================================
+*/
+        class Recorder
+        {
+        public:
+            static const int FLUSH_SIZE = 256 * 1024;
+
+            Recorder( void ) : nextId( 1 ), lockedId( 0 ), lockedPixels( nullptr ), lockedPitch( 0 ), lockedBytesPerRow( 0 ), recording( false ), failed( false ) { SDL_zero( lockedRect ); }
+            ~Recorder( void ) { End(); }
+
+            /// @brief Start recording the calls made through this recorder into stream.
+            /// @param renderer the renderer the calls are forwarded to.
+            /// @param stream where the session is written, it is not closed by End.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool Begin( const Renderer &renderer, const IO::Stream &stream )
+            {
+                End();
+
+                int w = 0, h = 0;
+                if ( !SDL_GetCurrentRenderOutputSize( renderer, &w, &h ) )
+                    return false;
+
+                target = renderer;
+                output = stream;
+                nextId = 1;
+                lockedId = 0;
+                failed = false;
+                textures.Clear();
+                buffer.Clear();
+
+                PutU32( FILE_MAGIC );
+                PutU16( FILE_VERSION );
+                PutU32( ( Uint32 )w );
+                PutU32( ( Uint32 )h );
+                recording = true;
+                return Flush();
+            }
+
+            /// @brief Write the pending calls and stop recording.
+            /// @return false if any write failed during the session.
+            SDL_INLINE bool End( void )
+            {
+                if ( !recording )
+                    return !failed;
+
+                Flush();
+                recording = false;
+                textures.Free();
+                buffer.Free();
+                return !failed;
+            }
+
+            SDL_INLINE bool IsRecording( void ) const { return recording; }
+            SDL_INLINE const Renderer& GetRenderer( void ) const { return target; }
+
+            // frame
+            SDL_INLINE bool Present( void )
+            {
+                Put( OP_PRESENT );
+                const bool ok = target.Present();
+                Flush();
+                return ok;
+            }
+
+            SDL_INLINE bool Clear( void )
+            {
+                Put( OP_CLEAR );
+                return target.Clear();
+            }
+
+            // render state
+            SDL_INLINE bool SetDrawColor( const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a )
+            {
+                Put( OP_SET_DRAW_COLOR );
+                PutU8( r ); PutU8( g ); PutU8( b ); PutU8( a );
+                return target.SetDrawColor( r, g, b, a );
+            }
+
+            SDL_INLINE bool SetDrawColorFloat( const float r, const float g, const float b, const float a )
+            {
+                Put( OP_SET_DRAW_COLOR_FLOAT );
+                PutF32( r ); PutF32( g ); PutF32( b ); PutF32( a );
+                return target.SetDrawColorFloat( r, g, b, a );
+            }
+
+            SDL_INLINE bool SetDrawBlendMode( const SDL_BlendMode blendMode )
+            {
+                Put( OP_SET_DRAW_BLEND_MODE );
+                PutU32( blendMode );
+                return target.SetDrawBlendMode( blendMode );
+            }
+
+            SDL_INLINE bool SetViewport( const SDL_Rect *rect )
+            {
+                Put( OP_SET_VIEWPORT );
+                PutRect( rect );
+                return target.SetViewport( rect );
+            }
+
+            SDL_INLINE bool SetClipRect( const SDL_Rect *rect )
+            {
+                Put( OP_SET_CLIP_RECT );
+                PutRect( rect );
+                return target.SetClipRect( rect );
+            }
+
+            SDL_INLINE bool SetScale( const float scaleX, const float scaleY )
+            {
+                Put( OP_SET_SCALE );
+                PutF32( scaleX ); PutF32( scaleY );
+                return target.SetScale( scaleX, scaleY );
+            }
+
+            SDL_INLINE bool SetColorScale( const float scale )
+            {
+                Put( OP_SET_COLOR_SCALE );
+                PutF32( scale );
+                return target.SetColorScale( scale );
+            }
+
+            SDL_INLINE bool SetLogicalPresentation( const int w, const int h, const SDL_RendererLogicalPresentation mode )
+            {
+                Put( OP_SET_LOGICAL_PRESENTATION );
+                PutU32( ( Uint32 )w ); PutU32( ( Uint32 )h ); PutU32( ( Uint32 )mode );
+                return target.SetLogicalPresentation( w, h, mode );
+            }
+
+            SDL_INLINE bool SetTarget( const Texture &texture )
+            {
+                Put( OP_SET_TARGET );
+                PutU32( TextureId( texture ) );
+                return target.SetTarget( texture );
+            }
+
+            // primitives, single points and lines are recorded as a batch of one
+            SDL_INLINE bool RenderPoint( const float x, const float y )
+            {
+                const SDL_FPoint point = { x, y };
+                return RenderPoints( &point, 1 );
+            }
+
+            SDL_INLINE bool RenderPoints( const SDL_FPoint *points, const int count )
+            {
+                Put( OP_RENDER_POINTS );
+                PutPoints( points, count );
+                return target.RenderPoints( points, count );
+            }
+
+            SDL_INLINE bool RenderLine( const float x1, const float y1, const float x2, const float y2 )
+            {
+                const SDL_FPoint points[2] = { { x1, y1 }, { x2, y2 } };
+                return RenderLines( points, 2 );
+            }
+
+            SDL_INLINE bool RenderLines( const SDL_FPoint *points, const int count )
+            {
+                Put( OP_RENDER_LINES );
+                PutPoints( points, count );
+                return target.RenderLines( points, count );
+            }
+
+            SDL_INLINE bool RenderRect( const SDL_FRect *rect )
+            {
+                Put( OP_RENDER_RECT );
+                PutFRect( rect );
+                return target.RenderRect( rect );
+            }
+
+            SDL_INLINE bool RenderRects( const SDL_FRect *rects, const int count )
+            {
+                Put( OP_RENDER_RECTS );
+                PutFRects( rects, count );
+                return target.RenderRects( rects, count );
+            }
+
+            SDL_INLINE bool RenderFillRect( const SDL_FRect *rect )
+            {
+                Put( OP_RENDER_FILL_RECT );
+                PutFRect( rect );
+                return target.RenderFillRect( rect );
+            }
+
+            SDL_INLINE bool RenderFillRects( const SDL_FRect *rects, const int count )
+            {
+                Put( OP_RENDER_FILL_RECTS );
+                PutFRects( rects, count );
+                return target.RenderFillRects( rects, count );
+            }
+
+            SDL_INLINE bool RenderTexture( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect )
+            {
+                Put( OP_RENDER_TEXTURE );
+                PutU32( TextureId( texture ) );
+                PutFRect( srcrect );
+                PutFRect( dstrect );
+                return target.RenderTexture( texture, srcrect, dstrect );
+            }
+
+            SDL_INLINE bool RenderTextureRotated( const Texture &texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect, const double angle, const SDL_FPoint *center, const SDL_FlipMode flip )
+            {
+                Put( OP_RENDER_TEXTURE_ROTATED );
+                PutU32( TextureId( texture ) );
+                PutFRect( srcrect );
+                PutFRect( dstrect );
+                PutF64( angle );
+                PutFPoint( center );
+                PutU8( ( Uint8 )flip );
+                return target.RenderTextureRotated( texture, srcrect, dstrect, angle, center, flip );
+            }
+
+            SDL_INLINE bool RenderTextureAffine( const Texture &texture, const SDL_FRect *srcrect, const SDL_FPoint *origin, const SDL_FPoint *right, const SDL_FPoint *down )
+            {
+                Put( OP_RENDER_TEXTURE_AFFINE );
+                PutU32( TextureId( texture ) );
+                PutFRect( srcrect );
+                PutFPoint( origin );
+                PutFPoint( right );
+                PutFPoint( down );
+                return target.RenderTextureAffine( texture, srcrect, origin, right, down );
+            }
+
+            SDL_INLINE bool RenderTextureTiled( const Texture &texture, const SDL_FRect *srcrect, const float scale, const SDL_FRect *dstrect )
+            {
+                Put( OP_RENDER_TEXTURE_TILED );
+                PutU32( TextureId( texture ) );
+                PutFRect( srcrect );
+                PutF32( scale );
+                PutFRect( dstrect );
+                return target.RenderTextureTiled( texture, srcrect, scale, dstrect );
+            }
+
+            SDL_INLINE bool RenderTexture9Grid( const Texture &texture, const SDL_FRect *srcrect, const float left_width, const float right_width, const float top_height, const float bottom_height, const float scale, const SDL_FRect *dstrect )
+            {
+                Put( OP_RENDER_TEXTURE_9GRID );
+                PutU32( TextureId( texture ) );
+                PutFRect( srcrect );
+                PutF32( left_width ); PutF32( right_width ); PutF32( top_height ); PutF32( bottom_height );
+                PutF32( scale );
+                PutFRect( dstrect );
+                return target.RenderTexture9Grid( texture, srcrect, left_width, right_width, top_height, bottom_height, scale, dstrect );
+            }
+
+            SDL_INLINE bool RenderGeometry( const Texture &texture, const SDL_Vertex *vertices, const int num_vertices, const int *indices, const int num_indices )
+            {
+                Put( OP_RENDER_GEOMETRY );
+                PutU32( TextureId( texture ) );
+                PutU32( num_vertices > 0 && vertices != nullptr ? ( Uint32 )num_vertices : 0 );
+                for ( int i = 0; vertices != nullptr && i < num_vertices; i++ )
+                    PutVertex( vertices[i].position, vertices[i].color, vertices[i].tex_coord );
+                PutU32( num_indices > 0 && indices != nullptr ? ( Uint32 )num_indices : 0 );
+                for ( int i = 0; indices != nullptr && i < num_indices; i++ )
+                    PutU32( ( Uint32 )indices[i] );
+                return target.RenderGeometry( texture, vertices, num_vertices, indices, num_indices );
+            }
+
+            /// @brief Recorded as the equivalent RenderGeometry call, the strided arrays are gathered into vertices.
+            SDL_INLINE bool RenderGeometryRaw( const Texture &texture, const float *xy, const int xy_stride, const SDL_FColor *color, const int color_stride, const float *uv, const int uv_stride, const int num_vertices, const void *indices, const int num_indices, const int size_indices )
+            {
+                Put( OP_RENDER_GEOMETRY );
+                PutU32( TextureId( texture ) );
+                PutU32( num_vertices > 0 && xy != nullptr && color != nullptr ? ( Uint32 )num_vertices : 0 );
+                for ( int i = 0; xy != nullptr && color != nullptr && i < num_vertices; i++ )
+                {
+                    const float *pos = reinterpret_cast<const float*>( reinterpret_cast<const Uint8*>( xy ) + i * xy_stride );
+                    const SDL_FColor *col = reinterpret_cast<const SDL_FColor*>( reinterpret_cast<const Uint8*>( color ) + i * color_stride );
+                    const float *tex = uv != nullptr ? reinterpret_cast<const float*>( reinterpret_cast<const Uint8*>( uv ) + i * uv_stride ) : nullptr;
+                    const SDL_FPoint p = { pos[0], pos[1] };
+                    const SDL_FPoint t = { tex ? tex[0] : 0.0f, tex ? tex[1] : 0.0f };
+                    PutVertex( p, *col, t );
+                }
+
+                const bool hasIndices = indices != nullptr && num_indices > 0 && ( size_indices == 1 || size_indices == 2 || size_indices == 4 );
+                PutU32( hasIndices ? ( Uint32 )num_indices : 0 );
+                for ( int i = 0; hasIndices && i < num_indices; i++ )
+                {
+                    if ( size_indices == 1 )
+                        PutU32( static_cast<const Uint8*>( indices )[i] );
+                    else if ( size_indices == 2 )
+                        PutU32( static_cast<const Uint16*>( indices )[i] );
+                    else
+                        PutU32( static_cast<const Uint32*>( indices )[i] );
+                }
+                return target.RenderGeometryRaw( texture, xy, xy_stride, color, color_stride, uv, uv_stride, num_vertices, indices, num_indices, size_indices );
+            }
+
+            SDL_INLINE bool DebugText( const float x, const float y, const char *str )
+            {
+                const Uint32 len = str != nullptr ? ( Uint32 )SDL_strlen( str ) : 0;
+                Put( OP_DEBUG_TEXT );
+                PutF32( x ); PutF32( y );
+                PutU32( len );
+                PutBytes( str, len );
+                return target.DebugText( x, y, str );
+            }
+
+            // textures
+            SDL_INLINE bool CreateTexture( Texture &texture, const SDL_PixelFormat format, const SDL_TextureAccess access, const int w, const int h )
+            {
+                if ( !texture.CreateTexture( target, format, access, w, h ) )
+                    return false;
+                return AddTexture( texture ) != 0;
+            }
+
+            /// @brief The surface pixels are recorded in the format the texture was created with.
+            SDL_INLINE bool CreateTextureFromSurface( Texture &texture, const Surface &surface )
+            {
+                if ( !texture.CreateTextureFromSurface( target, surface ) )
+                    return false;
+
+                const Uint32 id = AddTexture( texture );
+                const TextureInfo *info = textures.Find( ( uintptr_t )( SDL_Texture* )texture );
+                if ( id == 0 || info == nullptr )
+                    return false;
+
+                SDL_Surface *converted = SDL_ConvertSurface( surface, info->format );
+                if ( converted == nullptr )
+                    return false;
+
+                if ( SDL_LockSurface( converted ) )
+                {
+                    const SDL_Rect rect = { 0, 0, converted->w, converted->h };
+                    Put( OP_UPDATE_TEXTURE );
+                    PutU32( id );
+                    PutRect( &rect );
+                    PutPlane( converted->pixels, converted->pitch, converted->w * SDL_BYTESPERPIXEL( info->format ), converted->h );
+                    SDL_UnlockSurface( converted );
+                }
+                SDL_DestroySurface( converted );
+
+                SDL_BlendMode blendMode;
+                if ( texture.GetBlendMode( &blendMode ) )
+                {
+                    Put( OP_TEXTURE_BLEND_MODE );
+                    PutU32( id );
+                    PutU32( blendMode );
+                }
+                return true;
+            }
+
+            SDL_INLINE void DestroyTexture( Texture &texture )
+            {
+                const Uint64 key = ( uintptr_t )( SDL_Texture* )texture;
+                const TextureInfo *info = textures.Find( key );
+                if ( info != nullptr )
+                {
+                    Put( OP_DESTROY_TEXTURE );
+                    PutU32( info->id );
+                    textures.Remove( key );
+                }
+                texture.Destroy();
+            }
+
+            SDL_INLINE bool UpdateTexture( const Texture &texture, const SDL_Rect *rect, const void *pixels, const int pitch )
+            {
+                Texture tex( texture );
+                SDL_Rect area;
+                const TextureInfo *info = ResolveRect( texture, rect, area );
+                if ( info != nullptr && pixels != nullptr && !SDL_ISPIXELFORMAT_FOURCC( info->format ) )
+                {
+                    Put( OP_UPDATE_TEXTURE );
+                    PutU32( info->id );
+                    PutRect( &area );
+                    PutPlane( pixels, pitch, area.w * SDL_BYTESPERPIXEL( info->format ), area.h );
+                }
+                return tex.Update( rect, pixels, pitch );
+            }
+
+            SDL_INLINE bool UpdateTextureYUV( const Texture &texture, const SDL_Rect *rect, const Uint8 *Yplane, const int Ypitch, const Uint8 *Uplane, const int Upitch, const Uint8 *Vplane, const int Vpitch )
+            {
+                Texture tex( texture );
+                SDL_Rect area;
+                const TextureInfo *info = ResolveRect( texture, rect, area );
+                if ( info != nullptr && Yplane && Uplane && Vplane )
+                {
+                    Put( OP_UPDATE_TEXTURE_YUV );
+                    PutU32( info->id );
+                    PutRect( &area );
+                    PutPlane( Yplane, Ypitch, area.w, area.h );
+                    PutPlane( Uplane, Upitch, ( area.w + 1 ) / 2, ( area.h + 1 ) / 2 );
+                    PutPlane( Vplane, Vpitch, ( area.w + 1 ) / 2, ( area.h + 1 ) / 2 );
+                }
+                return tex.UpdateYUV( rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch );
+            }
+
+            SDL_INLINE bool UpdateTextureNV( const Texture &texture, const SDL_Rect *rect, const Uint8 *Yplane, const int Ypitch, const Uint8 *UVplane, const int UVpitch )
+            {
+                Texture tex( texture );
+                SDL_Rect area;
+                const TextureInfo *info = ResolveRect( texture, rect, area );
+                if ( info != nullptr && Yplane && UVplane )
+                {
+                    Put( OP_UPDATE_TEXTURE_NV );
+                    PutU32( info->id );
+                    PutRect( &area );
+                    PutPlane( Yplane, Ypitch, area.w, area.h );
+                    PutPlane( UVplane, UVpitch, ( ( area.w + 1 ) / 2 ) * 2, ( area.h + 1 ) / 2 );
+                }
+                return tex.UpdateNV( rect, Yplane, Ypitch, UVplane, UVpitch );
+            }
+
+            /// @brief Lock a streaming texture, what was written to the pixels is recorded on UnlockTexture.
+            SDL_INLINE bool LockTexture( const Texture &texture, const SDL_Rect *rect, void **pixels, int *pitch )
+            {
+                Texture tex( texture );
+                if ( !tex.Lock( rect, pixels, pitch ) )
+                    return false;
+
+                const TextureInfo *info = ResolveRect( texture, rect, lockedRect );
+                lockedId = info != nullptr ? info->id : 0;
+                lockedBytesPerRow = info != nullptr && !SDL_ISPIXELFORMAT_FOURCC( info->format ) ? lockedRect.w * SDL_BYTESPERPIXEL( info->format ) : 0;
+                lockedPixels = *pixels;
+                lockedPitch = *pitch;
+                return true;
+            }
+
+            SDL_INLINE void UnlockTexture( const Texture &texture )
+            {
+                if ( lockedId != 0 && lockedBytesPerRow > 0 )
+                {
+                    Put( OP_UPDATE_TEXTURE );
+                    PutU32( lockedId );
+                    PutRect( &lockedRect );
+                    PutPlane( lockedPixels, lockedPitch, lockedBytesPerRow, lockedRect.h );
+                }
+                lockedId = 0;
+                lockedPixels = nullptr;
+                texture.Unlock();
+            }
+
+            SDL_INLINE bool SetTextureColorMod( const Texture &texture, const Uint8 r, const Uint8 g, const Uint8 b )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_COLOR_MOD );
+                PutU32( TextureId( texture ) );
+                PutU8( r ); PutU8( g ); PutU8( b );
+                return tex.SetColorMod( r, g, b );
+            }
+
+            SDL_INLINE bool SetTextureColorModFloat( const Texture &texture, const float r, const float g, const float b )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_COLOR_MOD_FLOAT );
+                PutU32( TextureId( texture ) );
+                PutF32( r ); PutF32( g ); PutF32( b );
+                return tex.SetColorModFloat( r, g, b );
+            }
+
+            SDL_INLINE bool SetTextureAlphaMod( const Texture &texture, const Uint8 alpha )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_ALPHA_MOD );
+                PutU32( TextureId( texture ) );
+                PutU8( alpha );
+                return tex.SetAlphaMod( alpha );
+            }
+
+            SDL_INLINE bool SetTextureAlphaModFloat( const Texture &texture, const float alpha )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_ALPHA_MOD_FLOAT );
+                PutU32( TextureId( texture ) );
+                PutF32( alpha );
+                return tex.SetAlphaModFloat( alpha );
+            }
+
+            SDL_INLINE bool SetTextureBlendMode( const Texture &texture, const SDL_BlendMode blendMode )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_BLEND_MODE );
+                PutU32( TextureId( texture ) );
+                PutU32( blendMode );
+                return tex.SetBlendMode( blendMode );
+            }
+
+            SDL_INLINE bool SetTextureScaleMode( const Texture &texture, const SDL_ScaleMode scaleMode )
+            {
+                Texture tex( texture );
+                Put( OP_TEXTURE_SCALE_MODE );
+                PutU32( TextureId( texture ) );
+                PutU32( ( Uint32 )scaleMode );
+                return tex.SetScaleMode( scaleMode );
+            }
+
+        private:
+            struct TextureInfo
+            {
+                Uint32          id;
+                SDL_PixelFormat format;
+                int             w;
+                int             h;
+            };
+
+            Recorder( const Recorder &ref );
+            Recorder& operator=( const Recorder &ref );
+
+            SDL_INLINE bool Flush( void )
+            {
+                if ( buffer.Empty() || failed )
+                {
+                    buffer.Clear();
+                    return !failed;
+                }
+
+                if ( output.Write( buffer.Ptr(), buffer.Size() ) != buffer.Size() )
+                    failed = true;
+                buffer.Clear();
+                return !failed;
+            }
+
+            SDL_INLINE void Put( const Op op )
+            {
+                if ( buffer.Num() >= FLUSH_SIZE )
+                    Flush();
+                buffer.Append( ( Uint8 )op );
+            }
+
+            SDL_INLINE void PutU8( const Uint8 value ) { buffer.Append( value ); }
+
+            SDL_INLINE void PutU16( const Uint16 value )
+            {
+                Uint8 *dst = buffer.AppendUninitialized( 2 );
+                if ( dst == nullptr )
+                    return;
+                dst[0] = ( Uint8 )value;
+                dst[1] = ( Uint8 )( value >> 8 );
+            }
+
+            SDL_INLINE void PutU32( const Uint32 value )
+            {
+                Uint8 *dst = buffer.AppendUninitialized( 4 );
+                if ( dst == nullptr )
+                    return;
+                dst[0] = ( Uint8 )value;
+                dst[1] = ( Uint8 )( value >> 8 );
+                dst[2] = ( Uint8 )( value >> 16 );
+                dst[3] = ( Uint8 )( value >> 24 );
+            }
+
+            SDL_INLINE void PutF32( const float value )
+            {
+                Uint32 bits;
+                SDL_memcpy( &bits, &value, sizeof( bits ) );
+                PutU32( bits );
+            }
+
+            SDL_INLINE void PutF64( const double value )
+            {
+                Uint64 bits;
+                SDL_memcpy( &bits, &value, sizeof( bits ) );
+                PutU32( ( Uint32 )bits );
+                PutU32( ( Uint32 )( bits >> 32 ) );
+            }
+
+            SDL_INLINE void PutBytes( const void *data, const Uint32 size )
+            {
+                if ( size == 0 )
+                    return;
+                Uint8 *dst = buffer.AppendUninitialized( ( int )size );
+                if ( dst != nullptr )
+                    SDL_memcpy( dst, data, size );
+            }
+
+            // optional arguments are a presence byte followed by the value
+            SDL_INLINE void PutRect( const SDL_Rect *rect )
+            {
+                PutU8( rect != nullptr );
+                if ( rect == nullptr )
+                    return;
+                PutU32( ( Uint32 )rect->x ); PutU32( ( Uint32 )rect->y );
+                PutU32( ( Uint32 )rect->w ); PutU32( ( Uint32 )rect->h );
+            }
+
+            SDL_INLINE void PutFRect( const SDL_FRect *rect )
+            {
+                PutU8( rect != nullptr );
+                if ( rect == nullptr )
+                    return;
+                PutF32( rect->x ); PutF32( rect->y ); PutF32( rect->w ); PutF32( rect->h );
+            }
+
+            SDL_INLINE void PutFPoint( const SDL_FPoint *point )
+            {
+                PutU8( point != nullptr );
+                if ( point == nullptr )
+                    return;
+                PutF32( point->x ); PutF32( point->y );
+            }
+
+            SDL_INLINE void PutPoints( const SDL_FPoint *points, const int count )
+            {
+                const Uint32 num = points != nullptr && count > 0 ? ( Uint32 )count : 0;
+                PutU32( num );
+                for ( Uint32 i = 0; i < num; i++ )
+                {
+                    PutF32( points[i].x ); PutF32( points[i].y );
+                }
+            }
+
+            SDL_INLINE void PutFRects( const SDL_FRect *rects, const int count )
+            {
+                const Uint32 num = rects != nullptr && count > 0 ? ( Uint32 )count : 0;
+                PutU32( num );
+                for ( Uint32 i = 0; i < num; i++ )
+                {
+                    PutF32( rects[i].x ); PutF32( rects[i].y ); PutF32( rects[i].w ); PutF32( rects[i].h );
+                }
+            }
+
+            SDL_INLINE void PutVertex( const SDL_FPoint &position, const SDL_FColor &color, const SDL_FPoint &uv )
+            {
+                PutF32( position.x ); PutF32( position.y );
+                PutF32( color.r ); PutF32( color.g ); PutF32( color.b ); PutF32( color.a );
+                PutF32( uv.x ); PutF32( uv.y );
+            }
+
+            // pixel rows are stored tightly packed, whatever the source pitch
+            SDL_INLINE void PutPlane( const void *pixels, const int pitch, const int rowBytes, const int rows )
+            {
+                PutU32( ( Uint32 )rowBytes );
+                PutU32( ( Uint32 )rows );
+                const Uint8 *src = static_cast<const Uint8*>( pixels );
+                for ( int y = 0; y < rows; y++ )
+                    PutBytes( src + ( size_t )y * pitch, ( Uint32 )rowBytes );
+            }
+
+            SDL_INLINE Uint32 AddTexture( const Texture &texture )
+            {
+                const SDL_PropertiesID props = SDL_GetTextureProperties( texture );
+                TextureInfo info;
+                info.id = nextId++;
+                info.format = ( SDL_PixelFormat )SDL_GetNumberProperty( props, SDL_PROP_TEXTURE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN );
+                info.w = ( int )SDL_GetNumberProperty( props, SDL_PROP_TEXTURE_WIDTH_NUMBER, 0 );
+                info.h = ( int )SDL_GetNumberProperty( props, SDL_PROP_TEXTURE_HEIGHT_NUMBER, 0 );
+                const SDL_TextureAccess access = ( SDL_TextureAccess )SDL_GetNumberProperty( props, SDL_PROP_TEXTURE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC );
+
+                if ( textures.Insert( ( uintptr_t )( SDL_Texture* )texture, info ) == nullptr )
+                    return 0;
+
+                Put( OP_CREATE_TEXTURE );
+                PutU32( info.id );
+                PutU32( ( Uint32 )info.format );
+                PutU32( ( Uint32 )access );
+                PutU32( ( Uint32 )info.w );
+                PutU32( ( Uint32 )info.h );
+                return info.id;
+            }
+
+            // 0 is the null texture, unknown textures are registered on first use
+            SDL_INLINE Uint32 TextureId( const Texture &texture )
+            {
+                if ( !texture )
+                    return 0;
+                const TextureInfo *info = textures.Find( ( uintptr_t )( SDL_Texture* )texture );
+                return info != nullptr ? info->id : AddTexture( texture );
+            }
+
+            SDL_INLINE const TextureInfo* ResolveRect( const Texture &texture, const SDL_Rect *rect, SDL_Rect &area )
+            {
+                if ( TextureId( texture ) == 0 )
+                    return nullptr;
+
+                const TextureInfo *info = textures.Find( ( uintptr_t )( SDL_Texture* )texture );
+                if ( rect != nullptr )
+                    area = *rect;
+                else
+                {
+                    area.x = 0;
+                    area.y = 0;
+                    area.w = info->w;
+                    area.h = info->h;
+                }
+                return info;
+            }
+
+            Renderer                target;
+            IO::Stream              output;
+            Array<Uint8>            buffer;
+            HashMap<TextureInfo>    textures;
+            Uint32                  nextId;
+            Uint32                  lockedId;
+            SDL_Rect                lockedRect;
+            void*                   lockedPixels;
+            int                     lockedPitch;
+            int                     lockedBytesPerRow;
+            bool                    recording;
+            bool                    failed;
+        };
+
+/*
+==================================================================
+Replayer
+==================================================================
+    Plays back a session written by Recorder, as fast as the renderer
+    allows, and reports the time of every frame ( the calls between
+    two Present ).
+
+    By default the session is replayed on a software renderer drawing
+    into a surface of the recorded output size, so it runs headless on
+    a CI machine and the frame times of two builds can be compared
+    without the application or its assets. Any other renderer can be
+    passed to Play instead.
+
+    Example usage:
+        SDL::Capture::Replayer replay;
+        SDL::Array<double> frames;
+        if ( replay.Load( "session.s3pc" ) && replay.Play( frames ) )
+        {
+            const SDL::Capture::Replayer::Summary stats = replay.Summarize( frames );
+            SDL_Log( "%d frames, median %.3f ms, p95 %.3f ms", stats.frames, stats.medianMS, stats.p95MS );
+        }
+==================================================================
+*/
+        class Replayer
+        {
+        public:
+            struct Summary
+            {
+                int     frames;
+                double  totalMS;
+                double  minMS;
+                double  medianMS;
+                double  meanMS;
+                double  p95MS;
+                double  maxMS;
+            };
+
+            Replayer( void ) : data( nullptr ), size( 0 ), width( 0 ), height( 0 ) {}
+            ~Replayer( void ) { Close(); }
+
+            /// @brief Read a whole session into memory, the stream is not closed.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool Load( IO::Stream &stream )
+            {
+                Close();
+
+                data = static_cast<Uint8*>( stream.LoadFile( &size, false ) );
+                if ( data == nullptr )
+                    return false;
+
+                Reader reader( data, size );
+                const Uint32 magic = reader.U32();
+                const Uint8 versionLow = reader.U8();
+                const Uint8 versionHigh = reader.U8();
+                const Uint16 version = ( Uint16 )( versionLow | ( versionHigh << 8 ) );
+                width = ( int )reader.U32();
+                height = ( int )reader.U32();
+                if ( !reader.ok || magic != FILE_MAGIC || version != FILE_VERSION || width <= 0 || height <= 0 )
+                {
+                    Close();
+                    return SDL_SetError( "Capture: not a render capture or unsupported version" );
+                }
+                return true;
+            }
+
+            SDL_INLINE bool Load( const char *path )
+            {
+                IO::Stream stream;
+                if ( !stream.FromFile( path, "rb" ) )
+                    return false;
+                const bool ok = Load( stream );
+                stream.Close();
+                return ok;
+            }
+
+            SDL_INLINE void Close( void )
+            {
+                software.Destroy();
+                surface.Destroy();
+                SDL_free( data );
+                data = nullptr;
+                size = 0;
+                width = 0;
+                height = 0;
+            }
+
+            SDL_INLINE int  GetWidth( void ) const { return width; }
+            SDL_INLINE int  GetHeight( void ) const { return height; }
+
+            /// @brief Replay the session once on the headless software renderer.
+            /// @param frameMS receives the time of every frame in milliseconds.
+            SDL_INLINE bool Play( Array<double> &frameMS )
+            {
+                if ( data == nullptr )
+                    return SDL_SetError( "Capture: nothing loaded" );
+
+                if ( !software )
+                {
+                    if ( !surface.Create( width, height, SDL_PIXELFORMAT_XRGB8888 ) || !software.CreateSoftware( surface ) )
+                        return false;
+                }
+                return Play( software, frameMS );
+            }
+
+            /// @brief Replay the session once on renderer.
+            /// @param frameMS receives the time of every frame in milliseconds.
+            SDL_INLINE bool Play( const Renderer &renderer, Array<double> &frameMS )
+            {
+                if ( data == nullptr )
+                    return SDL_SetError( "Capture: nothing loaded" );
+
+                Renderer target( renderer );
+                Reader reader( data + HEADER_SIZE, size - HEADER_SIZE );
+                const double msPerTick = 1000.0 / ( double )SDL_GetPerformanceFrequency();
+                bool ok = true;
+
+                frameMS.Clear();
+                textures.Clear();
+
+                Uint64 frameStart = SDL_GetPerformanceCounter();
+                while ( ok && reader.Remaining() > 0 )
+                {
+                    const Uint8 op = reader.U8();
+                    switch ( op )
+                    {
+                    case OP_PRESENT:
+                    {
+                        target.Present();
+                        const Uint64 now = SDL_GetPerformanceCounter();
+                        frameMS.Append( ( double )( now - frameStart ) * msPerTick );
+                        frameStart = now;
+                        break;
+                    }
+                    case OP_CLEAR:
+                        target.Clear();
+                        break;
+                    case OP_SET_DRAW_COLOR:
+                    {
+                        const Uint8 r = reader.U8(), g = reader.U8(), b = reader.U8(), a = reader.U8();
+                        if ( reader.ok )
+                            target.SetDrawColor( r, g, b, a );
+                        break;
+                    }
+                    case OP_SET_DRAW_COLOR_FLOAT:
+                    {
+                        const float r = reader.F32(), g = reader.F32(), b = reader.F32(), a = reader.F32();
+                        if ( reader.ok )
+                            target.SetDrawColorFloat( r, g, b, a );
+                        break;
+                    }
+                    case OP_SET_DRAW_BLEND_MODE:
+                    {
+                        const SDL_BlendMode blendMode = reader.U32();
+                        if ( reader.ok )
+                            target.SetDrawBlendMode( blendMode );
+                        break;
+                    }
+                    case OP_SET_VIEWPORT:
+                    {
+                        SDL_Rect rect;
+                        const SDL_Rect *r = reader.Rect( rect );
+                        if ( reader.ok )
+                            target.SetViewport( r );
+                        break;
+                    }
+                    case OP_SET_CLIP_RECT:
+                    {
+                        SDL_Rect rect;
+                        const SDL_Rect *r = reader.Rect( rect );
+                        if ( reader.ok )
+                            target.SetClipRect( r );
+                        break;
+                    }
+                    case OP_SET_SCALE:
+                    {
+                        const float x = reader.F32(), y = reader.F32();
+                        if ( reader.ok )
+                            target.SetScale( x, y );
+                        break;
+                    }
+                    case OP_SET_COLOR_SCALE:
+                    {
+                        const float scale = reader.F32();
+                        if ( reader.ok )
+                            target.SetColorScale( scale );
+                        break;
+                    }
+                    case OP_SET_LOGICAL_PRESENTATION:
+                    {
+                        const int w = ( int )reader.U32(), h = ( int )reader.U32();
+                        const SDL_RendererLogicalPresentation mode = ( SDL_RendererLogicalPresentation )reader.U32();
+                        if ( reader.ok )
+                            target.SetLogicalPresentation( w, h, mode );
+                        break;
+                    }
+                    case OP_SET_TARGET:
+                    {
+                        const Texture texture = Lookup( reader.U32() );
+                        if ( reader.ok )
+                            target.SetTarget( texture );
+                        break;
+                    }
+                    case OP_RENDER_POINTS:
+                    case OP_RENDER_LINES:
+                    {
+                        const int count = reader.Points( points );
+                        if ( reader.ok && op == OP_RENDER_POINTS )
+                            target.RenderPoints( points.Ptr(), count );
+                        else if ( reader.ok )
+                            target.RenderLines( points.Ptr(), count );
+                        break;
+                    }
+                    case OP_RENDER_RECT:
+                    case OP_RENDER_FILL_RECT:
+                    {
+                        SDL_FRect rect;
+                        const SDL_FRect *r = reader.FRect( rect );
+                        if ( reader.ok && op == OP_RENDER_RECT )
+                            target.RenderRect( r );
+                        else if ( reader.ok )
+                            target.RenderFillRect( r );
+                        break;
+                    }
+                    case OP_RENDER_RECTS:
+                    case OP_RENDER_FILL_RECTS:
+                    {
+                        const int count = reader.FRects( rects );
+                        if ( reader.ok && op == OP_RENDER_RECTS )
+                            target.RenderRects( rects.Ptr(), count );
+                        else if ( reader.ok )
+                            target.RenderFillRects( rects.Ptr(), count );
+                        break;
+                    }
+                    case OP_RENDER_TEXTURE:
+                    {
+                        SDL_FRect src, dst;
+                        const Texture texture = Lookup( reader.U32() );
+                        const SDL_FRect *s = reader.FRect( src );
+                        const SDL_FRect *d = reader.FRect( dst );
+                        if ( reader.ok )
+                            target.RenderTexture( texture, s, d );
+                        break;
+                    }
+                    case OP_RENDER_TEXTURE_ROTATED:
+                    {
+                        SDL_FRect src, dst;
+                        SDL_FPoint center;
+                        const Texture texture = Lookup( reader.U32() );
+                        const SDL_FRect *s = reader.FRect( src );
+                        const SDL_FRect *d = reader.FRect( dst );
+                        const double angle = reader.F64();
+                        const SDL_FPoint *c = reader.FPoint( center );
+                        const SDL_FlipMode flip = ( SDL_FlipMode )reader.U8();
+                        if ( reader.ok )
+                            target.RenderTextureRotated( texture, s, d, angle, c, flip );
+                        break;
+                    }
+                    case OP_RENDER_TEXTURE_AFFINE:
+                    {
+                        SDL_FRect src;
+                        SDL_FPoint origin, right, down;
+                        const Texture texture = Lookup( reader.U32() );
+                        const SDL_FRect *s = reader.FRect( src );
+                        const SDL_FPoint *o = reader.FPoint( origin );
+                        const SDL_FPoint *r = reader.FPoint( right );
+                        const SDL_FPoint *d = reader.FPoint( down );
+                        if ( reader.ok )
+                            target.RenderTextureAffine( texture, s, o, r, d );
+                        break;
+                    }
+                    case OP_RENDER_TEXTURE_TILED:
+                    {
+                        SDL_FRect src, dst;
+                        const Texture texture = Lookup( reader.U32() );
+                        const SDL_FRect *s = reader.FRect( src );
+                        const float scale = reader.F32();
+                        const SDL_FRect *d = reader.FRect( dst );
+                        if ( reader.ok )
+                            target.RenderTextureTiled( texture, s, scale, d );
+                        break;
+                    }
+                    case OP_RENDER_TEXTURE_9GRID:
+                    {
+                        SDL_FRect src, dst;
+                        const Texture texture = Lookup( reader.U32() );
+                        const SDL_FRect *s = reader.FRect( src );
+                        const float left = reader.F32(), right = reader.F32(), top = reader.F32(), bottom = reader.F32();
+                        const float scale = reader.F32();
+                        const SDL_FRect *d = reader.FRect( dst );
+                        if ( reader.ok )
+                            target.RenderTexture9Grid( texture, s, left, right, top, bottom, scale, d );
+                        break;
+                    }
+                    case OP_RENDER_GEOMETRY:
+                    {
+                        const Texture texture = Lookup( reader.U32() );
+                        const int numVertices = reader.Vertices( vertices );
+                        const int numIndices = reader.Indices( indices );
+                        if ( reader.ok )
+                            target.RenderGeometry( texture, vertices.Ptr(), numVertices, numIndices > 0 ? indices.Ptr() : nullptr, numIndices );
+                        break;
+                    }
+                    case OP_DEBUG_TEXT:
+                    {
+                        const float x = reader.F32(), y = reader.F32();
+                        const Uint32 len = reader.U32();
+                        const Uint8 *str = reader.Bytes( len );
+                        if ( reader.ok )
+                        {
+                            text.Resize( ( int )len + 1 );
+                            SDL_memcpy( text.Ptr(), str, len );
+                            text[( int )len] = '\0';
+                            target.DebugText( x, y, text.Ptr() );
+                        }
+                        break;
+                    }
+                    case OP_CREATE_TEXTURE:
+                    {
+                        const Uint32 id = reader.U32();
+                        const SDL_PixelFormat format = ( SDL_PixelFormat )reader.U32();
+                        const SDL_TextureAccess access = ( SDL_TextureAccess )reader.U32();
+                        const int w = ( int )reader.U32(), h = ( int )reader.U32();
+                        if ( !reader.ok )
+                            break;
+
+                        if ( id == 0 || id > MAX_TEXTURES )
+                        {
+                            ok = SDL_SetError( "Capture: bad texture id %u", id );
+                            break;
+                        }
+
+                        if ( ( int )id >= textures.Num() )
+                        {
+                            const int first = textures.Num();
+                            textures.Resize( ( int )id + 1 );
+                            for ( int i = first; i < textures.Num(); i++ )
+                                textures[i] = nullptr;
+                        }
+
+                        Texture texture;
+                        texture.CreateTexture( target, format, access, w, h );
+                        textures[( int )id] = texture;
+                        break;
+                    }
+                    case OP_DESTROY_TEXTURE:
+                    {
+                        const Uint32 id = reader.U32();
+                        Texture texture = Lookup( id );
+                        if ( reader.ok && texture )
+                        {
+                            texture.Destroy();
+                            textures[( int )id] = nullptr;
+                        }
+                        break;
+                    }
+                    case OP_UPDATE_TEXTURE:
+                    {
+                        SDL_Rect rect;
+                        int rowBytes, rows;
+                        Texture texture = Lookup( reader.U32() );
+                        const SDL_Rect *r = reader.Rect( rect );
+                        const Uint8 *pixels = reader.Plane( rowBytes, rows );
+                        if ( reader.ok )
+                            texture.Update( r, pixels, rowBytes );
+                        break;
+                    }
+                    case OP_UPDATE_TEXTURE_YUV:
+                    {
+                        SDL_Rect rect;
+                        int yBytes, uBytes, vBytes, rows;
+                        Texture texture = Lookup( reader.U32() );
+                        const SDL_Rect *r = reader.Rect( rect );
+                        const Uint8 *y = reader.Plane( yBytes, rows );
+                        const Uint8 *u = reader.Plane( uBytes, rows );
+                        const Uint8 *v = reader.Plane( vBytes, rows );
+                        if ( reader.ok )
+                            texture.UpdateYUV( r, y, yBytes, u, uBytes, v, vBytes );
+                        break;
+                    }
+                    case OP_UPDATE_TEXTURE_NV:
+                    {
+                        SDL_Rect rect;
+                        int yBytes, uvBytes, rows;
+                        Texture texture = Lookup( reader.U32() );
+                        const SDL_Rect *r = reader.Rect( rect );
+                        const Uint8 *y = reader.Plane( yBytes, rows );
+                        const Uint8 *uv = reader.Plane( uvBytes, rows );
+                        if ( reader.ok )
+                            texture.UpdateNV( r, y, yBytes, uv, uvBytes );
+                        break;
+                    }
+                    case OP_TEXTURE_COLOR_MOD:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const Uint8 r = reader.U8(), g = reader.U8(), b = reader.U8();
+                        if ( reader.ok )
+                            texture.SetColorMod( r, g, b );
+                        break;
+                    }
+                    case OP_TEXTURE_COLOR_MOD_FLOAT:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const float r = reader.F32(), g = reader.F32(), b = reader.F32();
+                        if ( reader.ok )
+                            texture.SetColorModFloat( r, g, b );
+                        break;
+                    }
+                    case OP_TEXTURE_ALPHA_MOD:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const Uint8 alpha = reader.U8();
+                        if ( reader.ok )
+                            texture.SetAlphaMod( alpha );
+                        break;
+                    }
+                    case OP_TEXTURE_ALPHA_MOD_FLOAT:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const float alpha = reader.F32();
+                        if ( reader.ok )
+                            texture.SetAlphaModFloat( alpha );
+                        break;
+                    }
+                    case OP_TEXTURE_BLEND_MODE:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const SDL_BlendMode blendMode = reader.U32();
+                        if ( reader.ok )
+                            texture.SetBlendMode( blendMode );
+                        break;
+                    }
+                    case OP_TEXTURE_SCALE_MODE:
+                    {
+                        Texture texture = Lookup( reader.U32() );
+                        const SDL_ScaleMode scaleMode = ( SDL_ScaleMode )reader.U32();
+                        if ( reader.ok )
+                            texture.SetScaleMode( scaleMode );
+                        break;
+                    }
+                    default:
+                        ok = SDL_SetError( "Capture: unknown op %d at offset %d", ( int )op, ( int )( reader.Offset() + HEADER_SIZE - 1 ) );
+                        break;
+                    }
+
+                    if ( ok && !reader.ok )
+                        ok = SDL_SetError( "Capture: truncated stream" );
+                }
+
+                target.SetTarget( Texture() );
+                for ( int i = 0; i < textures.Num(); i++ )
+                {
+                    if ( textures[i] != nullptr )
+                        SDL_DestroyTexture( textures[i] );
+                }
+                textures.Clear();
+                return ok;
+            }
+
+            /// @brief Frame time statistics of a replay.
+            static SDL_INLINE Summary Summarize( const Array<double> &frameMS )
+            {
+                Summary summary;
+                SDL_zero( summary );
+
+                const int num = frameMS.Num();
+                double *sorted = static_cast<double*>( SDL_malloc( sizeof( double ) * ( num > 0 ? num : 1 ) ) );
+                if ( num == 0 || sorted == nullptr )
+                {
+                    SDL_free( sorted );
+                    return summary;
+                }
+
+                for ( int i = 0; i < num; i++ )
+                {
+                    sorted[i] = frameMS[i];
+                    summary.totalMS += frameMS[i];
+                }
+                SDL_qsort( sorted, ( size_t )num, sizeof( double ), CompareMS );
+
+                summary.frames = num;
+                summary.minMS = sorted[0];
+                summary.medianMS = sorted[num / 2];
+                summary.meanMS = summary.totalMS / ( double )num;
+                summary.p95MS = sorted[SDL_min( num - 1, ( num * 95 ) / 100 )];
+                summary.maxMS = sorted[num - 1];
+                SDL_free( sorted );
+                return summary;
+            }
+
+        private:
+            // magic, version, width, height
+            static const size_t HEADER_SIZE = 14;
+            static const Uint32 MAX_TEXTURES = 1 << 20;
+
+            // bounds checked little endian reads, any overrun clears ok and returns zeros
+            struct Reader
+            {
+                Reader( const Uint8 *data, const size_t size ) : start( data ), ptr( data ), end( data + size ), ok( true ) {}
+
+                SDL_INLINE size_t Remaining( void ) const { return ( size_t )( end - ptr ); }
+                SDL_INLINE size_t Offset( void ) const { return ( size_t )( ptr - start ); }
+
+                SDL_INLINE bool Need( const Uint64 bytes )
+                {
+                    if ( ok && bytes <= ( Uint64 )Remaining() )
+                        return true;
+                    ok = false;
+                    return false;
+                }
+
+                SDL_INLINE Uint8 U8( void )
+                {
+                    return Need( 1 ) ? *ptr++ : 0;
+                }
+
+                SDL_INLINE Uint32 U32( void )
+                {
+                    if ( !Need( 4 ) )
+                        return 0;
+                    const Uint32 value = ( Uint32 )ptr[0] | ( ( Uint32 )ptr[1] << 8 ) | ( ( Uint32 )ptr[2] << 16 ) | ( ( Uint32 )ptr[3] << 24 );
+                    ptr += 4;
+                    return value;
+                }
+
+                SDL_INLINE float F32( void )
+                {
+                    const Uint32 bits = U32();
+                    float value;
+                    SDL_memcpy( &value, &bits, sizeof( value ) );
+                    return value;
+                }
+
+                SDL_INLINE double F64( void )
+                {
+                    const Uint64 low = U32();
+                    const Uint64 bits = low | ( ( Uint64 )U32() << 32 );
+                    double value;
+                    SDL_memcpy( &value, &bits, sizeof( value ) );
+                    return value;
+                }
+
+                SDL_INLINE const Uint8* Bytes( const Uint64 size )
+                {
+                    if ( !Need( size ) )
+                        return nullptr;
+                    const Uint8 *data = ptr;
+                    ptr += size;
+                    return data;
+                }
+
+                SDL_INLINE const SDL_Rect* Rect( SDL_Rect &rect )
+                {
+                    if ( U8() == 0 )
+                        return nullptr;
+                    rect.x = ( int )U32(); rect.y = ( int )U32();
+                    rect.w = ( int )U32(); rect.h = ( int )U32();
+                    return &rect;
+                }
+
+                SDL_INLINE const SDL_FRect* FRect( SDL_FRect &rect )
+                {
+                    if ( U8() == 0 )
+                        return nullptr;
+                    rect.x = F32(); rect.y = F32(); rect.w = F32(); rect.h = F32();
+                    return &rect;
+                }
+
+                SDL_INLINE const SDL_FPoint* FPoint( SDL_FPoint &point )
+                {
+                    if ( U8() == 0 )
+                        return nullptr;
+                    point.x = F32(); point.y = F32();
+                    return &point;
+                }
+
+                // the element count is checked against the remaining data before anything is allocated
+                SDL_INLINE int Points( Array<SDL_FPoint> &points )
+                {
+                    const Uint32 count = U32();
+                    if ( !Need( ( Uint64 )count * 8 ) )
+                        return 0;
+                    points.Resize( ( int )count );
+                    for ( Uint32 i = 0; i < count; i++ )
+                    {
+                        points[i].x = F32(); points[i].y = F32();
+                    }
+                    return ( int )count;
+                }
+
+                SDL_INLINE int FRects( Array<SDL_FRect> &rects )
+                {
+                    const Uint32 count = U32();
+                    if ( !Need( ( Uint64 )count * 16 ) )
+                        return 0;
+                    rects.Resize( ( int )count );
+                    for ( Uint32 i = 0; i < count; i++ )
+                    {
+                        rects[i].x = F32(); rects[i].y = F32(); rects[i].w = F32(); rects[i].h = F32();
+                    }
+                    return ( int )count;
+                }
+
+                SDL_INLINE int Vertices( Array<SDL_Vertex> &vertices )
+                {
+                    const Uint32 count = U32();
+                    if ( !Need( ( Uint64 )count * 32 ) )
+                        return 0;
+                    vertices.Resize( ( int )count );
+                    for ( Uint32 i = 0; i < count; i++ )
+                    {
+                        SDL_Vertex &v = vertices[i];
+                        v.position.x = F32(); v.position.y = F32();
+                        v.color.r = F32(); v.color.g = F32(); v.color.b = F32(); v.color.a = F32();
+                        v.tex_coord.x = F32(); v.tex_coord.y = F32();
+                    }
+                    return ( int )count;
+                }
+
+                SDL_INLINE int Indices( Array<int> &indices )
+                {
+                    const Uint32 count = U32();
+                    if ( !Need( ( Uint64 )count * 4 ) )
+                        return 0;
+                    indices.Resize( ( int )count );
+                    for ( Uint32 i = 0; i < count; i++ )
+                        indices[i] = ( int )U32();
+                    return ( int )count;
+                }
+
+                // packed rows, returned in place
+                SDL_INLINE const Uint8* Plane( int &rowBytes, int &rows )
+                {
+                    const Uint32 bytes = U32();
+                    const Uint32 count = U32();
+                    rowBytes = ( int )bytes;
+                    rows = ( int )count;
+                    return Bytes( ( Uint64 )bytes * count );
+                }
+
+                const Uint8*    start;
+                const Uint8*    ptr;
+                const Uint8*    end;
+                bool            ok;
+            };
+
+            Replayer( const Replayer &ref );
+            Replayer& operator=( const Replayer &ref );
+
+            SDL_INLINE Texture Lookup( const Uint32 id ) const
+            {
+                return ( id > 0 && ( int )id < textures.Num() ) ? Texture( textures[( int )id] ) : Texture();
+            }
+
+            static int SDLCALL CompareMS( const void *a, const void *b )
+            {
+                const double da = *static_cast<const double*>( a );
+                const double db = *static_cast<const double*>( b );
+                return ( da < db ) ? -1 : ( da > db ) ? 1 : 0;
+            }
+
+            Uint8*              data;
+            size_t              size;
+            int                 width;
+            int                 height;
+            Surface             surface;
+            Renderer            software;
+            Array<SDL_Texture*> textures;
+            Array<SDL_FPoint>   points;
+            Array<SDL_FRect>    rects;
+            Array<SDL_Vertex>   vertices;
+            Array<int>          indices;
+            Array<char>         text;
+        };
+    };
+};
+
+#endif //!__SDL_RENDER_CAPTURE_HPP__
@@ -0,0 +1,1164 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_RENDER_GRAPH_HPP__
+#define __SDL_RENDER_GRAPH_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+RenderGraph
+==================================================================
+    Builds a frame out of render, compute and copy passes that declare
+    the textures and buffers they read and write, instead of ordering
+    the passes and owning the intermediate resources by hand.
+
+    Compile derives the dependencies from the declarations ( in the
+    order the passes were added ), culls the passes whose results
+    nobody reads, schedules the rest, keeping render passes on the
+    same targets next to each other, and merges those into a single
+    SDL render pass when the later ones load the targets. Execute
+    records everything into one command buffer.
+
+    Transient resources are created by the graph. The GPU API has no
+    memory heaps, so aliasing is done per texture: transients with the
+    same size and format whose lifetimes do not overlap share one
+    texture ( buffers share when one is large enough ). The physical
+    resources are pooled across frames and released after a few frames
+    without use. A transient must be written ( cleared, or fully
+    overwritten ) before it is read, its contents do not survive the
+    frame. Imported resources are outputs: the passes writing them are
+    always kept.
+
+    Names are not copied and must stay valid until Execute, the graph
+    is rebuilt every frame after Reset.
+
+    Example usage:
+        graph.Reset();
+        SDL::GPU::RenderGraph::Resource hdr = graph.CreateTexture( "hdr", hdrInfo );
+        SDL::GPU::RenderGraph::Resource backbuffer = graph.ImportTexture( "swapchain", swapchainTexture );
+
+        int scene = graph.AddPass( "scene", SDL::GPU::RenderGraph::PASS_RENDER, DrawScene, &world );
+        graph.SetColorTarget( scene, 0, hdr, SDL_GPU_LOADOP_CLEAR );
+
+        int tonemap = graph.AddPass( "tonemap", SDL::GPU::RenderGraph::PASS_RENDER, Tonemap, nullptr );
+        graph.Read( tonemap, hdr );
+        graph.SetColorTarget( tonemap, 0, backbuffer, SDL_GPU_LOADOP_DONT_CARE );
+
+        if ( graph.Compile() )
+            graph.Execute( commandBuffer );
+        ...
+        static void SDLCALL Tonemap( const SDL::GPU::RenderGraph::Context &context )
+        {
+            SDL_GPUTextureSamplerBinding binding = { context.GetTexture( hdr ), sampler };
+            context.renderPass.BindFragmentSamplers( 0, &binding, 1 );
+            ...
+        }
+==================================================================
+*/
+        class RenderGraph
+        {
+        public:
+            /// @brief Index + 1 of a resource declared since the last Reset, 0 is never valid.
+            typedef Uint32 Resource;
+
+            enum PassType
+            {
+                PASS_RENDER,
+                PASS_COMPUTE,
+                PASS_COPY
+            };
+
+            static const int MAX_COLOR_TARGETS = 8;
+            static const int MAX_STORAGE_WRITES = 8;
+            // compiles a pooled resource may go unused before it is released
+            static const Uint32 MAX_IDLE_COMPILES = 3;
+
+            struct Context
+            {
+                RenderGraph*    graph;
+                CommandBuffer   commandBuffer;
+                RenderPass      renderPass;     // only inside render passes
+                ComputePass     computePass;    // only inside compute passes
+                CopyPass        copyPass;       // only inside copy passes
+                const char*     name;
+                void*           userdata;
+
+                Context( RenderGraph *_graph, const CommandBuffer &_commandBuffer ) :
+                    graph( _graph ), commandBuffer( _commandBuffer ), name( nullptr ), userdata( nullptr ) {}
+
+                SDL_INLINE SDL_GPUTexture* GetTexture( const Resource resource ) const { return graph->GetTexture( resource ); }
+                SDL_INLINE SDL_GPUBuffer* GetBuffer( const Resource resource ) const { return graph->GetBuffer( resource ); }
+            };
+
+            typedef void ( SDLCALL *PassCallback )( const Context &context );
+
+            struct Stats
+            {
+                int     passes;
+                int     culledPasses;
+                int     sdlPasses;              // passes begun by Execute, after merging
+                int     transientTextures;
+                int     physicalTextures;       // pooled textures used by this frame
+                int     transientBuffers;
+                int     physicalBuffers;
+                Uint64  transientBytes;         // what the transients would take without aliasing
+                Uint64  physicalBytes;
+                Uint64  pooledBytes;            // every pooled resource, idle ones included
+            };
+
+            RenderGraph( void ) : device( nullptr ), compiled( false ), compileCount( 0 )
+            {
+                SDL_zero( stats );
+            }
+            ~RenderGraph( void ) { Destroy(); }
+
+            /// @param device the device, it must outlive the graph.
+            SDL_INLINE bool Create( const Device &_device )
+            {
+                Destroy();
+                device = &_device;
+                return true;
+            }
+
+            /// @brief Release the pooled resources.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < pool.Num(); i++ )
+                    ReleasePhysical( pool[i] );
+                pool.Free();
+                resources.Free();
+                passes.Free();
+                accesses.Free();
+                deps.Free();
+                schedule.Free();
+                groups.Free();
+                device = nullptr;
+                compiled = false;
+                SDL_zero( stats );
+            }
+
+            /// @brief Forget the passes and resources of the previous frame, the pool is kept.
+            SDL_INLINE void Reset( void )
+            {
+                resources.Clear();
+                passes.Clear();
+                accesses.Clear();
+                schedule.Clear();
+                groups.Clear();
+                compiled = false;
+            }
+
+            SDL_INLINE Resource CreateTexture( const char *name, const SDL_GPUTextureCreateInfo &info )
+            {
+                ResourceInfo *resource = AddResource( name, KIND_TEXTURE );
+                if ( resource == nullptr )
+                    return 0;
+                // normalized once, the pool compares and sizes textures by these fields
+                resource->texture = info;
+                if ( resource->texture.num_levels == 0 )
+                    resource->texture.num_levels = 1;
+                if ( resource->texture.layer_count_or_depth == 0 )
+                    resource->texture.layer_count_or_depth = 1;
+                return ( Resource )resources.Num();
+            }
+
+            SDL_INLINE Resource CreateBuffer( const char *name, const SDL_GPUBufferCreateInfo &info )
+            {
+                ResourceInfo *resource = AddResource( name, KIND_BUFFER );
+                if ( resource == nullptr )
+                    return 0;
+                resource->buffer = info;
+                return ( Resource )resources.Num();
+            }
+
+            /// @param output keep the passes writing it, false if only the graph reads it.
+            SDL_INLINE Resource ImportTexture( const char *name, SDL_GPUTexture *texture, const bool output = true )
+            {
+                if ( texture == nullptr )
+                {
+                    SDL_SetError( "RenderGraph: null texture imported as '%s'", name );
+                    return 0;
+                }
+                ResourceInfo *resource = AddResource( name, KIND_TEXTURE );
+                if ( resource == nullptr )
+                    return 0;
+                resource->imported = true;
+                resource->output = output;
+                resource->handle = texture;
+                return ( Resource )resources.Num();
+            }
+
+            SDL_INLINE Resource ImportBuffer( const char *name, SDL_GPUBuffer *buffer, const bool output = true )
+            {
+                if ( buffer == nullptr )
+                {
+                    SDL_SetError( "RenderGraph: null buffer imported as '%s'", name );
+                    return 0;
+                }
+                ResourceInfo *resource = AddResource( name, KIND_BUFFER );
+                if ( resource == nullptr )
+                    return 0;
+                resource->imported = true;
+                resource->output = output;
+                resource->handle = buffer;
+                return ( Resource )resources.Num();
+            }
+
+            /// @brief Keep a transient alive until the end of the frame, and the passes writing it.
+            SDL_INLINE void MarkOutput( const Resource resource )
+            {
+                if ( IsValid( resource ) )
+                    resources[resource - 1].output = true;
+            }
+
+            /// @return the pass index, or -1 on failure.
+            SDL_INLINE int AddPass( const char *name, const PassType type, PassCallback callback, void *userdata = nullptr )
+            {
+                PassInfo *pass = passes.AppendUninitialized( 1 );
+                if ( pass == nullptr )
+                {
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+                SDL_zerop( pass );
+                pass->name = name;
+                pass->type = type;
+                pass->callback = callback;
+                pass->userdata = userdata;
+                compiled = false;
+                return passes.Num() - 1;
+            }
+
+            /// @brief Never cull the pass, for passes with effects outside the graph ( readbacks, ... ).
+            SDL_INLINE void SetSideEffect( const int pass )
+            {
+                if ( pass >= 0 && pass < passes.Num() )
+                    passes[pass].sideEffect = true;
+            }
+
+            /// @brief The pass samples or reads the resource.
+            SDL_INLINE bool Read( const int pass, const Resource resource )
+            {
+                return AddAccess( pass, resource, ACCESS_READ );
+            }
+
+            /// @brief The pass writes the resource: storage write in compute passes ( bound read-write at begin ),
+            /// destination in copy passes. Add a Read too if the previous contents matter.
+            SDL_INLINE bool Write( const int pass, const Resource resource )
+            {
+                return AddAccess( pass, resource, ACCESS_WRITE );
+            }
+
+            SDL_INLINE bool SetColorTarget( const int pass, const int slot, const Resource texture, const SDL_GPULoadOp load_op,
+                                            const SDL_FColor clear_color = SDL_FColor(), const SDL_GPUStoreOp store_op = SDL_GPU_STOREOP_STORE,
+                                            const Uint32 mip_level = 0, const Uint32 layer = 0 )
+            {
+                if ( pass < 0 || pass >= passes.Num() || passes[pass].type != PASS_RENDER )
+                    return SDL_SetError( "RenderGraph: invalid render pass %d", pass );
+                if ( slot < 0 || slot >= MAX_COLOR_TARGETS )
+                    return SDL_SetError( "RenderGraph: invalid color target slot %d", slot );
+                if ( !IsValid( texture ) || resources[texture - 1].kind != KIND_TEXTURE )
+                    return SDL_SetError( "RenderGraph: invalid texture %u", texture );
+
+                PassInfo &info = passes[pass];
+                Target &target = info.color[slot];
+                SDL_zero( target );
+                target.resource = texture;
+                target.load = load_op;
+                target.store = store_op;
+                target.clearColor = clear_color;
+                target.mip = mip_level;
+                target.layer = layer;
+                if ( slot >= info.numColor )
+                    info.numColor = slot + 1;
+                return AddAccess( pass, texture, ACCESS_WRITE | ACCESS_TARGET | ( load_op == SDL_GPU_LOADOP_LOAD ? ACCESS_READ : 0 ) );
+            }
+
+            SDL_INLINE bool SetDepthTarget( const int pass, const Resource texture, const SDL_GPULoadOp load_op, const float clear_depth = 1.0f,
+                                            const SDL_GPUStoreOp store_op = SDL_GPU_STOREOP_STORE,
+                                            const SDL_GPULoadOp stencil_load_op = SDL_GPU_LOADOP_DONT_CARE,
+                                            const SDL_GPUStoreOp stencil_store_op = SDL_GPU_STOREOP_DONT_CARE, const Uint8 clear_stencil = 0 )
+            {
+                if ( pass < 0 || pass >= passes.Num() || passes[pass].type != PASS_RENDER )
+                    return SDL_SetError( "RenderGraph: invalid render pass %d", pass );
+                if ( !IsValid( texture ) || resources[texture - 1].kind != KIND_TEXTURE )
+                    return SDL_SetError( "RenderGraph: invalid texture %u", texture );
+
+                PassInfo &info = passes[pass];
+                Target &target = info.depth;
+                SDL_zero( target );
+                target.resource = texture;
+                target.load = load_op;
+                target.store = store_op;
+                target.clearDepth = clear_depth;
+                target.stencilLoad = stencil_load_op;
+                target.stencilStore = stencil_store_op;
+                target.clearStencil = clear_stencil;
+                info.hasDepth = true;
+                const bool loads = load_op == SDL_GPU_LOADOP_LOAD || stencil_load_op == SDL_GPU_LOADOP_LOAD;
+                return AddAccess( pass, texture, ACCESS_WRITE | ACCESS_TARGET | ACCESS_DEPTH | ( loads ? ACCESS_READ : 0 ) );
+            }
+
+            /// @brief Cull, schedule, merge and assign the pooled resources.
+            SDL_INLINE bool Compile( void )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "RenderGraph: not created" );
+
+                compiled = false;
+                compileCount++;
+                SDL_zero( stats );
+                stats.passes = passes.Num();
+
+                const int numPasses = passes.Num();
+                if ( !deps.Resize( numPasses * numPasses ) || !schedule.Resize( 0 ) || !groups.Resize( 0 ) )
+                    return SDL_OutOfMemory();
+                if ( numPasses > 0 )
+                    SDL_memset( deps.Ptr(), 0, deps.Size() );
+
+                if ( !BuildDependencies() )
+                    return false;
+                Cull();
+                if ( !Schedule() || !Merge() || !Assign() )
+                    return false;
+
+                TrimPool();
+                compiled = true;
+                return true;
+            }
+
+            /// @brief Record every scheduled pass into the command buffer.
+            SDL_INLINE bool Execute( const CommandBuffer &commandBuffer )
+            {
+                if ( !compiled )
+                    return SDL_SetError( "RenderGraph: not compiled" );
+
+                for ( int g = 0; g < groups.Num(); g++ )
+                {
+                    const Group &group = groups[g];
+                    const PassInfo &first = passes[schedule[group.first]];
+                    Context context( this, commandBuffer );
+
+                    if ( first.type == PASS_RENDER )
+                    {
+                        if ( !BeginRender( g, context.renderPass, commandBuffer ) )
+                            return false;
+                    }
+                    else if ( first.type == PASS_COMPUTE )
+                    {
+                        if ( !BeginCompute( g, context.computePass, commandBuffer ) )
+                            return false;
+                    }
+                    else if ( !context.copyPass.Begin( commandBuffer ) )
+                    {
+                        return false;
+                    }
+
+                    for ( int i = group.first; i < group.first + group.count; i++ )
+                    {
+                        const PassInfo &pass = passes[schedule[i]];
+                        if ( pass.callback == nullptr )
+                            continue;
+                        context.name = pass.name;
+                        context.userdata = pass.userdata;
+                        pass.callback( context );
+                    }
+
+                    if ( first.type == PASS_RENDER )
+                        context.renderPass.End();
+                    else if ( first.type == PASS_COMPUTE )
+                        context.computePass.End();
+                    else
+                        context.copyPass.End();
+                }
+                return true;
+            }
+
+            /// @brief The texture behind a resource, transients only exist after Compile.
+            SDL_INLINE SDL_GPUTexture* GetTexture( const Resource resource ) const
+            {
+                if ( !IsValid( resource ) || resources[resource - 1].kind != KIND_TEXTURE )
+                    return nullptr;
+                return static_cast<SDL_GPUTexture*>( resources[resource - 1].handle );
+            }
+
+            SDL_INLINE SDL_GPUBuffer* GetBuffer( const Resource resource ) const
+            {
+                if ( !IsValid( resource ) || resources[resource - 1].kind != KIND_BUFFER )
+                    return nullptr;
+                return static_cast<SDL_GPUBuffer*>( resources[resource - 1].handle );
+            }
+
+            SDL_INLINE bool IsCulled( const int pass ) const
+            {
+                return compiled && pass >= 0 && pass < passes.Num() && !passes[pass].needed;
+            }
+
+            SDL_INLINE Stats GetStats( void ) const { return stats; }
+
+            /// @brief Log the compiled schedule, one line per SDL pass.
+            SDL_INLINE void LogSchedule( void ) const
+            {
+                static const char *TYPE_NAMES[] = { "render", "compute", "copy" };
+                SDL_Log( "RenderGraph: %d passes, %d culled, %d SDL passes, %d transient textures in %d, %.1f of %.1f MB",
+                         stats.passes, stats.culledPasses, stats.sdlPasses, stats.transientTextures, stats.physicalTextures,
+                         stats.physicalBytes / ( 1024.0 * 1024.0 ), stats.transientBytes / ( 1024.0 * 1024.0 ) );
+                for ( int g = 0; g < groups.Num(); g++ )
+                {
+                    const Group &group = groups[g];
+                    for ( int i = group.first; i < group.first + group.count; i++ )
+                    {
+                        const PassInfo &pass = passes[schedule[i]];
+                        SDL_Log( "  %3d %-7s %s%s", g, i == group.first ? TYPE_NAMES[pass.type] : "", i == group.first ? "" : "+ ",
+                                 pass.name != nullptr ? pass.name : "?" );
+                    }
+                }
+            }
+
+        private:
+            RenderGraph( const RenderGraph & );
+            RenderGraph &operator=( const RenderGraph & );
+
+            enum
+            {
+                KIND_TEXTURE,
+                KIND_BUFFER
+            };
+
+            enum
+            {
+                ACCESS_READ = 1 << 0,
+                ACCESS_WRITE = 1 << 1,
+                ACCESS_TARGET = 1 << 2,
+                ACCESS_DEPTH = 1 << 3
+            };
+
+            enum
+            {
+                DEP_DATA = 1 << 0,      // read after write, the reader needs the writer
+                DEP_ORDER = 1 << 1      // write after read or write, ordering only
+            };
+
+            struct ResourceInfo
+            {
+                const char*                 name;
+                int                         kind;
+                bool                        imported;
+                bool                        output;
+                SDL_GPUTextureCreateInfo    texture;
+                SDL_GPUBufferCreateInfo     buffer;
+                Uint32                      usage;      // derived from the accesses at Compile
+                void*                       handle;
+                int                         first;      // group range using it, at Compile
+                int                         last;
+                int                         firstPass;  // schedule position of the first use
+                bool                        firstReads;
+                bool                        cycles;     // first of the transients sharing its physical resource
+            };
+
+            struct Target
+            {
+                Resource        resource;
+                SDL_GPULoadOp   load;
+                SDL_GPUStoreOp  store;
+                SDL_FColor      clearColor;
+                float           clearDepth;
+                SDL_GPULoadOp   stencilLoad;
+                SDL_GPUStoreOp  stencilStore;
+                Uint8           clearStencil;
+                Uint32          mip;
+                Uint32          layer;
+            };
+
+            struct PassInfo
+            {
+                const char*     name;
+                PassType        type;
+                PassCallback    callback;
+                void*           userdata;
+                bool            sideEffect;
+                bool            needed;
+                int             numColor;
+                bool            hasDepth;
+                Target          color[MAX_COLOR_TARGETS];
+                Target          depth;
+            };
+
+            struct Access
+            {
+                int     pass;
+                int     resource;   // index
+                int     flags;
+            };
+
+            struct Group
+            {
+                int     first;      // into schedule
+                int     count;
+            };
+
+            struct Physical
+            {
+                int                         kind;
+                SDL_GPUTextureCreateInfo    texture;
+                SDL_GPUBufferCreateInfo     buffer;
+                void*                       handle;
+                Uint64                      bytes;
+                int                         busyUntil;  // last group using it in this compile, -1 if free
+                Uint64                      lastCompile;
+            };
+
+            SDL_INLINE bool IsValid( const Resource resource ) const
+            {
+                return resource > 0 && ( int )resource <= resources.Num();
+            }
+
+            SDL_INLINE ResourceInfo* AddResource( const char *name, const int kind )
+            {
+                ResourceInfo *resource = resources.AppendUninitialized( 1 );
+                if ( resource == nullptr )
+                {
+                    SDL_OutOfMemory();
+                    return nullptr;
+                }
+                SDL_zerop( resource );
+                resource->name = name;
+                resource->kind = kind;
+                compiled = false;
+                return resource;
+            }
+
+            SDL_INLINE bool AddAccess( const int pass, const Resource resource, const int flags )
+            {
+                if ( pass < 0 || pass >= passes.Num() )
+                    return SDL_SetError( "RenderGraph: invalid pass %d", pass );
+                if ( !IsValid( resource ) )
+                    return SDL_SetError( "RenderGraph: invalid resource %u", resource );
+
+                Access access;
+                access.pass = pass;
+                access.resource = ( int )resource - 1;
+                access.flags = flags;
+                if ( accesses.Append( access ) == nullptr )
+                    return SDL_OutOfMemory();
+                compiled = false;
+                return true;
+            }
+
+            static int SDLCALL CompareAccess( const void *a, const void *b )
+            {
+                const Access *x = static_cast<const Access*>( a );
+                const Access *y = static_cast<const Access*>( b );
+                if ( x->resource != y->resource )
+                    return x->resource < y->resource ? -1 : 1;
+                if ( x->pass != y->pass )
+                    return x->pass < y->pass ? -1 : 1;
+                return 0;
+            }
+
+            SDL_INLINE Uint8& Dep( const int from, const int to )
+            {
+                return deps[from * passes.Num() + to];
+            }
+
+            // dependencies follow the order the passes were added in
+            SDL_INLINE bool BuildDependencies( void )
+            {
+                if ( accesses.Num() > 1 )
+                    SDL_qsort( accesses.Ptr(), ( size_t )accesses.Num(), sizeof( Access ), CompareAccess );
+
+                Array<int> readers;
+                int i = 0;
+                while ( i < accesses.Num() )
+                {
+                    const int resource = accesses[i].resource;
+                    int lastWriter = -1;
+                    readers.Clear();
+                    while ( i < accesses.Num() && accesses[i].resource == resource )
+                    {
+                        // merge every access of one pass to the resource
+                        const int pass = accesses[i].pass;
+                        int flags = 0;
+                        while ( i < accesses.Num() && accesses[i].resource == resource && accesses[i].pass == pass )
+                            flags |= accesses[i++].flags;
+
+                        if ( ( flags & ACCESS_READ ) != 0 )
+                        {
+                            if ( lastWriter >= 0 )
+                                Dep( lastWriter, pass ) |= DEP_DATA;
+                            if ( readers.Append( pass ) == nullptr )
+                                return SDL_OutOfMemory();
+                        }
+                        if ( ( flags & ACCESS_WRITE ) != 0 )
+                        {
+                            if ( lastWriter >= 0 )
+                                Dep( lastWriter, pass ) |= DEP_ORDER;
+                            for ( int r = 0; r < readers.Num(); r++ )
+                            {
+                                if ( readers[r] != pass )
+                                    Dep( readers[r], pass ) |= DEP_ORDER;
+                            }
+                            readers.Clear();
+                            lastWriter = pass;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            // keep the passes with side effects or writing outputs, and everything they read from
+            SDL_INLINE void Cull( void )
+            {
+                const int numPasses = passes.Num();
+                Array<int> stack;
+                for ( int p = 0; p < numPasses; p++ )
+                    passes[p].needed = passes[p].sideEffect;
+                for ( int i = 0; i < accesses.Num(); i++ )
+                {
+                    const Access &access = accesses[i];
+                    if ( ( access.flags & ACCESS_WRITE ) != 0 && resources[access.resource].output )
+                        passes[access.pass].needed = true;
+                }
+                for ( int p = 0; p < numPasses; p++ )
+                {
+                    if ( passes[p].needed )
+                        stack.Append( p );
+                }
+
+                while ( stack.Num() > 0 )
+                {
+                    const int pass = stack.Last();
+                    stack.RemoveIndexFast( stack.Num() - 1 );
+                    for ( int q = 0; q < numPasses; q++ )
+                    {
+                        if ( !passes[q].needed && ( Dep( q, pass ) & DEP_DATA ) != 0 )
+                        {
+                            passes[q].needed = true;
+                            stack.Append( q );
+                        }
+                    }
+                }
+
+                for ( int p = 0; p < numPasses; p++ )
+                {
+                    if ( !passes[p].needed )
+                        stats.culledPasses++;
+                }
+            }
+
+            SDL_INLINE bool SameTargets( const PassInfo &a, const PassInfo &b ) const
+            {
+                if ( a.numColor != b.numColor || a.hasDepth != b.hasDepth )
+                    return false;
+                for ( int i = 0; i < a.numColor; i++ )
+                {
+                    const Target &x = a.color[i];
+                    const Target &y = b.color[i];
+                    if ( x.resource != y.resource || x.mip != y.mip || x.layer != y.layer )
+                        return false;
+                }
+                return !a.hasDepth || a.depth.resource == b.depth.resource;
+            }
+
+            // b can continue the SDL render pass a is in
+            SDL_INLINE bool CanMergeRender( const PassInfo &a, const int passB ) const
+            {
+                const PassInfo &b = passes[passB];
+                if ( a.type != PASS_RENDER || b.type != PASS_RENDER || !SameTargets( a, b ) )
+                    return false;
+                for ( int i = 0; i < b.numColor; i++ )
+                {
+                    if ( b.color[i].resource != 0 && b.color[i].load == SDL_GPU_LOADOP_CLEAR )
+                        return false;
+                }
+                if ( b.hasDepth && ( b.depth.load == SDL_GPU_LOADOP_CLEAR || b.depth.stencilLoad == SDL_GPU_LOADOP_CLEAR ) )
+                    return false;
+
+                // a target can not be sampled while it is bound
+                for ( int i = 0; i < accesses.Num(); i++ )
+                {
+                    const Access &access = accesses[i];
+                    if ( access.pass != passB || ( access.flags & ACCESS_TARGET ) != 0 )
+                        continue;
+                    for ( int t = 0; t < b.numColor; t++ )
+                    {
+                        if ( ( int )b.color[t].resource - 1 == access.resource )
+                            return false;
+                    }
+                    if ( b.hasDepth && ( int )b.depth.resource - 1 == access.resource )
+                        return false;
+                }
+                return true;
+            }
+
+            // topological order over the kept passes, render passes on the same targets are kept together
+            SDL_INLINE bool Schedule( void )
+            {
+                const int numPasses = passes.Num();
+                Array<int> pending;
+                if ( !pending.Resize( numPasses ) )
+                    return SDL_OutOfMemory();
+
+                int remaining = 0;
+                for ( int p = 0; p < numPasses; p++ )
+                {
+                    pending[p] = 0;
+                    if ( !passes[p].needed )
+                        continue;
+                    remaining++;
+                    for ( int q = 0; q < numPasses; q++ )
+                    {
+                        if ( passes[q].needed && Dep( q, p ) != 0 )
+                            pending[p]++;
+                    }
+                }
+
+                int previous = -1;
+                while ( remaining > 0 )
+                {
+                    int pick = -1;
+                    for ( int p = 0; p < numPasses; p++ )
+                    {
+                        if ( !passes[p].needed || pending[p] != 0 )
+                            continue;
+                        if ( previous >= 0 && CanMergeRender( passes[previous], p ) )
+                        {
+                            pick = p;
+                            break;
+                        }
+                        if ( pick < 0 )
+                            pick = p;
+                    }
+                    if ( pick < 0 )
+                        return SDL_SetError( "RenderGraph: dependency cycle" );
+
+                    if ( schedule.Append( pick ) == nullptr )
+                        return SDL_OutOfMemory();
+                    pending[pick] = -1;
+                    remaining--;
+                    for ( int p = 0; p < numPasses; p++ )
+                    {
+                        if ( passes[p].needed && pending[p] > 0 && Dep( pick, p ) != 0 )
+                            pending[p]--;
+                    }
+                    previous = pick;
+                }
+                return true;
+            }
+
+            // copy passes can share a SDL copy pass when they do not depend on each other
+            SDL_INLINE bool CanMergeCopy( const Group &group, const int pass )
+            {
+                if ( passes[pass].type != PASS_COPY )
+                    return false;
+                for ( int i = group.first; i < group.first + group.count; i++ )
+                {
+                    const int other = schedule[i];
+                    if ( passes[other].type != PASS_COPY || Dep( other, pass ) != 0 )
+                        return false;
+                }
+                return true;
+            }
+
+            SDL_INLINE bool Merge( void )
+            {
+                for ( int i = 0; i < schedule.Num(); i++ )
+                {
+                    const int pass = schedule[i];
+                    if ( groups.Num() > 0 )
+                    {
+                        Group &group = groups.Last();
+                        const PassInfo &last = passes[schedule[group.first + group.count - 1]];
+                        if ( CanMergeRender( last, pass ) || CanMergeCopy( group, pass ) )
+                        {
+                            group.count++;
+                            continue;
+                        }
+                    }
+                    Group group;
+                    group.first = i;
+                    group.count = 1;
+                    if ( groups.Append( group ) == nullptr )
+                        return SDL_OutOfMemory();
+                }
+                stats.sdlPasses = groups.Num();
+                return true;
+            }
+
+            static SDL_INLINE Uint64 TextureBytes( const SDL_GPUTextureCreateInfo &info )
+            {
+                Uint64 bytes = 0;
+                for ( Uint32 level = 0; level < info.num_levels; level++ )
+                {
+                    const Uint32 w = SDL_max( info.width >> level, 1u );
+                    const Uint32 h = SDL_max( info.height >> level, 1u );
+                    const Uint32 d = info.type == SDL_GPU_TEXTURETYPE_3D ? SDL_max( info.layer_count_or_depth >> level, 1u ) : info.layer_count_or_depth;
+                    bytes += SDL_CalculateGPUTextureFormatSize( info.format, w, h, d );
+                }
+                return bytes << ( int )info.sample_count;
+            }
+
+            SDL_INLINE bool Compatible( const Physical &physical, const ResourceInfo &resource ) const
+            {
+                if ( physical.kind != resource.kind || physical.busyUntil >= resource.first )
+                    return false;
+                if ( resource.kind == KIND_BUFFER )
+                    return physical.buffer.size >= resource.buffer.size && ( physical.buffer.usage & resource.usage ) == resource.usage;
+
+                const SDL_GPUTextureCreateInfo &a = physical.texture;
+                const SDL_GPUTextureCreateInfo &b = resource.texture;
+                return a.type == b.type && a.format == b.format && a.width == b.width && a.height == b.height &&
+                       a.layer_count_or_depth == b.layer_count_or_depth && a.num_levels == b.num_levels &&
+                       a.sample_count == b.sample_count && ( a.usage & resource.usage ) == resource.usage;
+            }
+
+            // lifetimes of the transients, then first fit into the pool in order of first use
+            SDL_INLINE bool Assign( void )
+            {
+                for ( int r = 0; r < resources.Num(); r++ )
+                {
+                    ResourceInfo &resource = resources[r];
+                    resource.first = -1;
+                    resource.last = -1;
+                    resource.firstPass = -1;
+                    resource.firstReads = false;
+                    resource.cycles = false;
+                    resource.usage = resource.kind == KIND_TEXTURE ? resource.texture.usage : resource.buffer.usage;
+                    if ( !resource.imported )
+                        resource.handle = nullptr;
+                }
+
+                Array<int> groupOf;
+                Array<int> position;
+                if ( !groupOf.Resize( passes.Num() ) || !position.Resize( passes.Num() ) )
+                    return SDL_OutOfMemory();
+                for ( int g = 0; g < groups.Num(); g++ )
+                {
+                    for ( int i = groups[g].first; i < groups[g].first + groups[g].count; i++ )
+                    {
+                        groupOf[schedule[i]] = g;
+                        position[schedule[i]] = i;
+                    }
+                }
+
+                for ( int i = 0; i < accesses.Num(); i++ )
+                {
+                    const Access &access = accesses[i];
+                    const PassInfo &pass = passes[access.pass];
+                    if ( !pass.needed )
+                        continue;
+
+                    ResourceInfo &resource = resources[access.resource];
+                    const int group = groupOf[access.pass];
+                    const int at = position[access.pass];
+                    if ( resource.first < 0 || group < resource.first )
+                        resource.first = group;
+                    if ( group > resource.last )
+                        resource.last = group;
+                    if ( resource.firstPass < 0 || at < resource.firstPass )
+                    {
+                        resource.firstPass = at;
+                        resource.firstReads = ( access.flags & ACCESS_READ ) != 0;
+                    }
+                    else if ( at == resource.firstPass && ( access.flags & ACCESS_READ ) != 0 )
+                    {
+                        resource.firstReads = true;
+                    }
+
+                    if ( resource.kind != KIND_TEXTURE )
+                        continue;
+                    if ( ( access.flags & ACCESS_DEPTH ) != 0 )
+                        resource.usage |= SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET;
+                    else if ( ( access.flags & ACCESS_TARGET ) != 0 )
+                        resource.usage |= SDL_GPU_TEXTUREUSAGE_COLOR_TARGET;
+                    else if ( ( access.flags & ACCESS_WRITE ) != 0 && pass.type == PASS_COMPUTE )
+                        resource.usage |= SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE;
+                    else if ( ( access.flags & ACCESS_READ ) != 0 &&
+                              ( resource.usage & ( SDL_GPU_TEXTUREUSAGE_SAMPLER | SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ ) ) == 0 )
+                        resource.usage |= SDL_GPU_TEXTUREUSAGE_SAMPLER;
+                }
+
+                Array<int> order;
+                for ( int r = 0; r < resources.Num(); r++ )
+                {
+                    ResourceInfo &resource = resources[r];
+                    if ( resource.imported || resource.first < 0 )
+                        continue;
+                    if ( resource.firstReads )
+                        return SDL_SetError( "RenderGraph: '%s' is read before it is written", resource.name != nullptr ? resource.name : "?" );
+                    if ( resource.output )
+                        resource.last = groups.Num();
+                    if ( order.Append( r ) == nullptr )
+                        return SDL_OutOfMemory();
+                }
+                // insertion sort by first use, there are few transients
+                for ( int i = 1; i < order.Num(); i++ )
+                {
+                    const int r = order[i];
+                    int j = i - 1;
+                    while ( j >= 0 && resources[order[j]].first > resources[r].first )
+                    {
+                        order[j + 1] = order[j];
+                        j--;
+                    }
+                    order[j + 1] = r;
+                }
+
+                for ( int i = 0; i < pool.Num(); i++ )
+                    pool[i].busyUntil = -1;
+
+                for ( int i = 0; i < order.Num(); i++ )
+                {
+                    ResourceInfo &resource = resources[order[i]];
+                    int best = -1;
+                    for ( int p = 0; p < pool.Num(); p++ )
+                    {
+                        if ( !Compatible( pool[p], resource ) )
+                            continue;
+                        // the smallest buffer that fits
+                        if ( best < 0 || pool[p].bytes < pool[best].bytes )
+                            best = p;
+                        if ( resource.kind == KIND_TEXTURE )
+                            break;
+                    }
+                    if ( best < 0 )
+                    {
+                        best = CreatePhysical( resource );
+                        if ( best < 0 )
+                            return false;
+                    }
+
+                    Physical &physical = pool[best];
+                    // transients come in order of first use, only the earliest on a physical resource may cycle it,
+                    // cycling it again would give each alias its own memory
+                    resource.cycles = physical.lastCompile != compileCount;
+                    if ( resource.cycles )
+                    {
+                        physical.lastCompile = compileCount;
+                        if ( physical.kind == KIND_TEXTURE )
+                            stats.physicalTextures++;
+                        else
+                            stats.physicalBuffers++;
+                        stats.physicalBytes += physical.bytes;
+                    }
+                    physical.busyUntil = resource.last;
+                    resource.handle = physical.handle;
+                    if ( resource.kind == KIND_TEXTURE )
+                    {
+                        stats.transientTextures++;
+                        stats.transientBytes += TextureBytes( resource.texture );
+                    }
+                    else
+                    {
+                        stats.transientBuffers++;
+                        stats.transientBytes += resource.buffer.size;
+                    }
+                }
+                return true;
+            }
+
+            SDL_INLINE int CreatePhysical( const ResourceInfo &resource )
+            {
+                Physical physical;
+                SDL_zero( physical );
+                physical.kind = resource.kind;
+                physical.busyUntil = -1;
+                if ( resource.kind == KIND_TEXTURE )
+                {
+                    physical.texture = resource.texture;
+                    physical.texture.usage = resource.usage;
+                    Texture texture;
+                    if ( !texture.Create( *device, &physical.texture ) )
+                        return -1;
+                    physical.handle = texture.GetHandle();
+                    physical.bytes = TextureBytes( physical.texture );
+                }
+                else
+                {
+                    physical.buffer = resource.buffer;
+                    physical.buffer.usage = resource.usage;
+                    Buffer buffer;
+                    if ( !buffer.Create( *device, &physical.buffer ) )
+                        return -1;
+                    physical.handle = buffer.GetHandle();
+                    physical.bytes = physical.buffer.size;
+                }
+
+                if ( pool.Append( physical ) == nullptr )
+                {
+                    ReleasePhysical( physical );
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+                return pool.Num() - 1;
+            }
+
+            SDL_INLINE void ReleasePhysical( Physical &physical )
+            {
+                // the GPU API keeps released resources alive until the command buffers using them are done
+                if ( physical.kind == KIND_TEXTURE )
+                {
+                    Texture texture( static_cast<SDL_GPUTexture*>( physical.handle ) );
+                    texture.Release( *device );
+                }
+                else
+                {
+                    Buffer buffer( static_cast<SDL_GPUBuffer*>( physical.handle ) );
+                    buffer.Release( *device );
+                }
+                physical.handle = nullptr;
+            }
+
+            SDL_INLINE void TrimPool( void )
+            {
+                for ( int i = pool.Num() - 1; i >= 0; i-- )
+                {
+                    if ( compileCount - pool[i].lastCompile > MAX_IDLE_COMPILES )
+                    {
+                        ReleasePhysical( pool[i] );
+                        pool.RemoveIndexFast( i );
+                    }
+                }
+                for ( int i = 0; i < pool.Num(); i++ )
+                    stats.pooledBytes += pool[i].bytes;
+            }
+
+            // cycle a physical resource on the first write of the frame, its previous contents are never needed
+            SDL_INLINE bool ShouldCycle( const Resource resource, const int group, const bool loads ) const
+            {
+                const ResourceInfo &info = resources[resource - 1];
+                return !info.imported && info.cycles && !loads && info.first == group;
+            }
+
+            SDL_INLINE bool BeginRender( const int g, RenderPass &renderPass, const CommandBuffer &commandBuffer )
+            {
+                const Group &group = groups[g];
+                const PassInfo &first = passes[schedule[group.first]];
+                const PassInfo &last = passes[schedule[group.first + group.count - 1]];
+
+                SDL_GPUColorTargetInfo colors[MAX_COLOR_TARGETS];
+                for ( int i = 0; i < first.numColor; i++ )
+                {
+                    const Target &target = first.color[i];
+                    SDL_GPUColorTargetInfo &info = colors[i];
+                    SDL_zero( info );
+                    if ( target.resource == 0 )
+                        return SDL_SetError( "RenderGraph: pass '%s' skips color target %d", first.name, i );
+                    info.texture = GetTexture( target.resource );
+                    info.mip_level = target.mip;
+                    info.layer_or_depth_plane = target.layer;
+                    info.clear_color = target.clearColor;
+                    info.load_op = target.load;
+                    info.store_op = last.color[i].store;
+                    info.cycle = ShouldCycle( target.resource, g, target.load == SDL_GPU_LOADOP_LOAD );
+                }
+
+                SDL_GPUDepthStencilTargetInfo depth;
+                SDL_zero( depth );
+                if ( first.hasDepth )
+                {
+                    const Target &target = first.depth;
+                    depth.texture = GetTexture( target.resource );
+                    depth.clear_depth = target.clearDepth;
+                    depth.load_op = target.load;
+                    depth.store_op = last.depth.store;
+                    depth.stencil_load_op = target.stencilLoad;
+                    depth.stencil_store_op = last.depth.stencilStore;
+                    depth.clear_stencil = target.clearStencil;
+                    depth.cycle = ShouldCycle( target.resource, g, target.load == SDL_GPU_LOADOP_LOAD || target.stencilLoad == SDL_GPU_LOADOP_LOAD );
+                }
+                return renderPass.Begin( commandBuffer, colors, ( Uint32 )first.numColor, first.hasDepth ? &depth : nullptr );
+            }
+
+            SDL_INLINE bool BeginCompute( const int g, ComputePass &computePass, const CommandBuffer &commandBuffer )
+            {
+                const int pass = schedule[groups[g].first];
+                SDL_GPUStorageTextureReadWriteBinding textures[MAX_STORAGE_WRITES];
+                SDL_GPUStorageBufferReadWriteBinding buffers[MAX_STORAGE_WRITES];
+                Uint32 numTextures = 0;
+                Uint32 numBuffers = 0;
+
+                // the accesses are sorted by resource, merge the flags of each
+                for ( int i = 0; i < accesses.Num(); i++ )
+                {
+                    if ( accesses[i].pass != pass || ( accesses[i].flags & ACCESS_WRITE ) == 0 )
+                        continue;
+                    const Resource resource = ( Resource )accesses[i].resource + 1;
+                    bool loads = false;
+                    for ( int j = 0; j < accesses.Num(); j++ )
+                    {
+                        if ( accesses[j].pass == pass && accesses[j].resource == accesses[i].resource && ( accesses[j].flags & ACCESS_READ ) != 0 )
+                            loads = true;
+                    }
+
+                    if ( resources[resource - 1].kind == KIND_TEXTURE )
+                    {
+                        if ( numTextures == MAX_STORAGE_WRITES )
+                            return SDL_SetError( "RenderGraph: too many storage writes in '%s'", passes[pass].name );
+                        SDL_GPUStorageTextureReadWriteBinding &binding = textures[numTextures++];
+                        SDL_zero( binding );
+                        binding.texture = GetTexture( resource );
+                        binding.cycle = ShouldCycle( resource, g, loads );
+                    }
+                    else
+                    {
+                        if ( numBuffers == MAX_STORAGE_WRITES )
+                            return SDL_SetError( "RenderGraph: too many storage writes in '%s'", passes[pass].name );
+                        SDL_GPUStorageBufferReadWriteBinding &binding = buffers[numBuffers++];
+                        SDL_zero( binding );
+                        binding.buffer = GetBuffer( resource );
+                        binding.cycle = ShouldCycle( resource, g, loads );
+                    }
+                }
+                return computePass.Begin( commandBuffer, textures, numTextures, buffers, numBuffers );
+            }
+
+            const Device*           device;
+            Array<ResourceInfo>     resources;
+            Array<PassInfo>         passes;
+            Array<Access>           accesses;       // sorted by resource and pass once compiled
+            Array<Uint8>            deps;           // passes x passes, DEP_ bits from row to column
+            Array<int>              schedule;       // pass indices in execution order
+            Array<Group>            groups;         // runs of the schedule sharing one SDL pass
+            Array<Physical>         pool;
+            bool                    compiled;
+            Uint64                  compileCount;
+            Stats                   stats;
+        };
+    }
+}
+#endif //!__SDL_RENDER_GRAPH_HPP__
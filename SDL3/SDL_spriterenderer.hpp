@@ -0,0 +1,555 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_SPRITE_RENDERER_HPP__
+#define __SDL_SPRITE_RENDERER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_half.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+SpriteRenderer
+==================================================================
+    Draws textured sprites on the GPU path, with the RenderTexture and
+    RenderTextureRotated calls of SDL::Renderer, so a 2D game can move
+    between the two backends.
+
+    Each sprite is a 32 byte instance written straight into a mapped
+    transfer buffer, the vertex shader expands it to a rotated quad
+    ( SV_VertexID picks the corner ), so a frame of sprites is one
+    upload and one instanced draw per texture change; SDL::Renderer
+    builds 4 vertices per sprite on the CPU instead. Textures are
+    2D texture arrays and sprites pick their layer, so sprites from
+    different images in the same array are drawn together.
+
+    Coordinates are in pixels of the size given to Begin, origin at
+    the top left, like SDL::Renderer; SetTransform replaces that
+    projection ( e.g. for a camera ). The color and alpha mods tint the
+    sprites that follow, as the texture mods do. Sizes and offsets are
+    stored as half floats, exact to the pixel up to 2048.
+
+    The shaders are GetVertexShaderSource() and
+    GetFragmentShaderSource() ( HLSL ), compiled by the application for
+    its backend and given to Create.
+
+    Example usage:
+        SDL::GPU::SpriteRenderer sprites;
+        sprites.Create( device, vsCode, vsSize, fsCode, fsSize, SDL_GPU_SHADERFORMAT_SPIRV, swapchainFormat );
+        ...
+        // every frame
+        sprites.Begin( width, height );
+        sprites.SetTexture( atlas, 1024, 1024, sampler );
+        sprites.RenderTexture( 0, &source, &destination );
+        sprites.RenderTextureRotated( 3, &source, &destination, 45.0, nullptr, SDL_FLIP_NONE );
+        sprites.Upload( copyPass );
+        ...
+        sprites.Draw( commandBuffer, renderPass );
+==================================================================
+*/
+        class SpriteRenderer
+        {
+        public:
+            static const Uint32 DEFAULT_MAX_SPRITES = 1u << 20;
+
+            // 32 bytes, the layout of the vertex shader's Input
+            struct Instance
+            {
+                float   pivot[2];   // the rotation center
+                Uint16  rect[4];    // half floats, the top left corner relative to the pivot, then the size
+                Uint16  uv[4];      // unorm, top left then bottom right, in the layer
+                Uint8   color[4];
+                Sint16  angle;      // snorm, 32767 is 180 degrees clockwise
+                Sint16  layer;
+            };
+
+            struct Stats
+            {
+                Uint32  sprites;    // in the current frame
+                Uint32  batches;
+                Uint32  dropped;    // sprites over max_sprites
+            };
+
+            SpriteRenderer( void ) : device( nullptr ), maxSprites( 0 ), numSprites( 0 ), dropped( 0 ), mapped( nullptr ),
+                                     layerWidth( 1.0f ), layerHeight( 1.0f ), texture( nullptr ), sampler( nullptr )
+            {
+                SetColorMod( 255, 255, 255 );
+                SetAlphaMod( 255 );
+                SDL_zero( transform );
+            }
+            ~SpriteRenderer( void ) { Destroy(); }
+
+            /// @brief The vertex shader, to compile for the backend of the device.
+            static SDL_INLINE const char* GetVertexShaderSource( void )
+            {
+                return
+                    "cbuffer Params : register( b0, space1 ) { float4x4 Transform; };\n"
+                    "struct Input\n"
+                    "{\n"
+                    "    float2 pivot : TEXCOORD0;\n"
+                    "    float4 rect : TEXCOORD1;\n"
+                    "    float4 uv : TEXCOORD2;\n"
+                    "    float4 color : TEXCOORD3;\n"
+                    "    int2 angleLayer : TEXCOORD4;\n"
+                    "    uint vertex : SV_VertexID;\n"
+                    "};\n"
+                    "struct Output\n"
+                    "{\n"
+                    "    float3 uv : TEXCOORD0;\n"
+                    "    float4 color : TEXCOORD1;\n"
+                    "    float4 position : SV_Position;\n"
+                    "};\n"
+                    "static const float2 Corners[6] = { float2( 0, 0 ), float2( 1, 0 ), float2( 0, 1 ), float2( 0, 1 ), float2( 1, 0 ), float2( 1, 1 ) };\n"
+                    "Output main( Input input )\n"
+                    "{\n"
+                    "    float2 corner = Corners[input.vertex];\n"
+                    "    float2 local = input.rect.xy + corner * input.rect.zw;\n"
+                    "    float s, c;\n"
+                    "    sincos( input.angleLayer.x * ( 3.14159265 / 32767.0 ), s, c );\n"
+                    "    float2 position = input.pivot + float2( local.x * c - local.y * s, local.x * s + local.y * c );\n"
+                    "    Output output;\n"
+                    "    output.uv = float3( lerp( input.uv.xy, input.uv.zw, corner ), input.angleLayer.y );\n"
+                    "    output.color = input.color;\n"
+                    "    output.position = mul( Transform, float4( position, 0.0, 1.0 ) );\n"
+                    "    return output;\n"
+                    "}\n";
+            }
+
+            /// @brief The fragment shader, to compile for the backend of the device.
+            static SDL_INLINE const char* GetFragmentShaderSource( void )
+            {
+                return
+                    "Texture2DArray<float4> Sprites : register( t0, space2 );\n"
+                    "SamplerState Sampler : register( s0, space2 );\n"
+                    "float4 main( float3 uv : TEXCOORD0, float4 color : TEXCOORD1 ) : SV_Target0\n"
+                    "{\n"
+                    "    return Sprites.Sample( Sampler, uv ) * color;\n"
+                    "}\n";
+            }
+
+            /// @param blend the blending of the color target, nullptr for SDL_BLENDMODE_BLEND.
+            SDL_INLINE bool Create( const Device &_device, const Uint8 *vertex_code, const size_t vertex_size, const Uint8 *fragment_code, const size_t fragment_size,
+                                    const SDL_GPUShaderFormat format, const SDL_GPUTextureFormat color_format,
+                                    const Uint32 max_sprites = DEFAULT_MAX_SPRITES, const SDL_GPUColorTargetBlendState *blend = nullptr )
+            {
+                Destroy();
+                if ( max_sprites == 0 || max_sprites > 0x7fffffff / ( Uint32 )sizeof( Instance ) )
+                    return SDL_SetError( "SpriteRenderer: invalid sprite count %u", max_sprites );
+                device = &_device;
+                maxSprites = max_sprites;
+
+                SDL_GPUShaderCreateInfo shaderInfo;
+                SDL_zero( shaderInfo );
+                shaderInfo.code = vertex_code;
+                shaderInfo.code_size = vertex_size;
+                shaderInfo.entrypoint = "main";
+                shaderInfo.format = format;
+                shaderInfo.stage = SDL_GPU_SHADERSTAGE_VERTEX;
+                shaderInfo.num_uniform_buffers = 1;
+                Shader vertexShader;
+                if ( !vertexShader.Create( *device, &shaderInfo ) )
+                {
+                    Destroy();
+                    return false;
+                }
+                shaderInfo.code = fragment_code;
+                shaderInfo.code_size = fragment_size;
+                shaderInfo.stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
+                shaderInfo.num_uniform_buffers = 0;
+                shaderInfo.num_samplers = 1;
+                Shader fragmentShader;
+                if ( !fragmentShader.Create( *device, &shaderInfo ) )
+                {
+                    vertexShader.Release( *device );
+                    Destroy();
+                    return false;
+                }
+
+                SDL_GPUVertexBufferDescription buffer;
+                SDL_zero( buffer );
+                buffer.slot = 0;
+                buffer.pitch = sizeof( Instance );
+                buffer.input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE;
+                SDL_GPUVertexAttribute attributes[5];
+                SDL_zero( attributes );
+                const SDL_GPUVertexElementFormat formats[5] = { SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2, SDL_GPU_VERTEXELEMENTFORMAT_HALF4,
+                    SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM, SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM, SDL_GPU_VERTEXELEMENTFORMAT_SHORT2 };
+                const Uint32 offsets[5] = { 0, 8, 16, 24, 28 };
+                for ( Uint32 i = 0; i < 5; i++ )
+                {
+                    attributes[i].location = i;
+                    attributes[i].format = formats[i];
+                    attributes[i].offset = offsets[i];
+                }
+
+                SDL_GPUColorTargetDescription target;
+                SDL_zero( target );
+                target.format = color_format;
+                if ( blend != nullptr )
+                {
+                    target.blend_state = *blend;
+                }
+                else
+                {
+                    target.blend_state.enable_blend = true;
+                    target.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+                    target.blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+                    target.blend_state.color_blend_op = SDL_GPU_BLENDOP_ADD;
+                    target.blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+                    target.blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+                    target.blend_state.alpha_blend_op = SDL_GPU_BLENDOP_ADD;
+                }
+
+                SDL_GPUGraphicsPipelineCreateInfo info;
+                SDL_zero( info );
+                info.vertex_shader = vertexShader;
+                info.fragment_shader = fragmentShader;
+                info.vertex_input_state.vertex_buffer_descriptions = &buffer;
+                info.vertex_input_state.num_vertex_buffers = 1;
+                info.vertex_input_state.vertex_attributes = attributes;
+                info.vertex_input_state.num_vertex_attributes = 5;
+                info.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+                info.rasterizer_state.fill_mode = SDL_GPU_FILLMODE_FILL;
+                info.rasterizer_state.cull_mode = SDL_GPU_CULLMODE_NONE;
+                info.multisample_state.sample_count = SDL_GPU_SAMPLECOUNT_1;
+                info.target_info.color_target_descriptions = &target;
+                info.target_info.num_color_targets = 1;
+                const bool created = pipeline.Create( *device, &info );
+                // the pipeline keeps what it needs of the shaders
+                vertexShader.Release( *device );
+                fragmentShader.Release( *device );
+                if ( !created )
+                {
+                    Destroy();
+                    return false;
+                }
+
+                SDL_GPUBufferCreateInfo bufferInfo;
+                SDL_zero( bufferInfo );
+                bufferInfo.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+                bufferInfo.size = maxSprites * ( Uint32 )sizeof( Instance );
+                SDL_GPUTransferBufferCreateInfo transferInfo;
+                SDL_zero( transferInfo );
+                transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                transferInfo.size = bufferInfo.size;
+                if ( !instanceBuffer.Create( *device, &bufferInfo ) || !staging.Create( *device, &transferInfo ) )
+                {
+                    Destroy();
+                    return false;
+                }
+                return true;
+            }
+
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+                if ( mapped != nullptr )
+                    staging.Unmap( *device );
+                mapped = nullptr;
+                staging.Release( *device );
+                instanceBuffer.Release( *device );
+                pipeline.Release( *device );
+                batches.Free();
+                numSprites = 0;
+                device = nullptr;
+            }
+
+            /// @brief Start a frame of sprites, in pixels of a width x height target.
+            SDL_INLINE bool Begin( const float width, const float height )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "SpriteRenderer: not created" );
+                if ( mapped == nullptr )
+                {
+                    // cycled, the previous frame's upload may still be pending
+                    mapped = static_cast<Instance*>( staging.Map( *device, true ) );
+                    if ( mapped == nullptr )
+                        return false;
+                }
+                numSprites = 0;
+                dropped = 0;
+                batches.Clear();
+
+                SDL_zero( transform );
+                transform[0] = 2.0f / width;
+                transform[5] = -2.0f / height;
+                transform[10] = 1.0f;
+                transform[12] = -1.0f;
+                transform[13] = 1.0f;
+                transform[15] = 1.0f;
+                return true;
+            }
+
+            /// @brief Replace the projection of Begin, a column major matrix ( clip = m * position ).
+            SDL_INLINE void SetTransform( const float m[16] )
+            {
+                SDL_memcpy( transform, m, sizeof( transform ) );
+            }
+
+            /// @brief Set the texture array of the sprites that follow, all its layers are width x height.
+            SDL_INLINE void SetTexture( const Texture &texture_array, const Uint32 width, const Uint32 height, const Sampler &texture_sampler )
+            {
+                texture = texture_array;
+                sampler = texture_sampler;
+                layerWidth = ( float )width;
+                layerHeight = ( float )height;
+            }
+
+            SDL_INLINE void SetColorMod( const Uint8 r, const Uint8 g, const Uint8 b )
+            {
+                color[0] = r;
+                color[1] = g;
+                color[2] = b;
+            }
+
+            SDL_INLINE void SetAlphaMod( const Uint8 a )
+            {
+                color[3] = a;
+            }
+
+            /// @param srcrect in pixels of the layer, nullptr for the whole layer.
+            /// @param dstrect nullptr for the whole target.
+            SDL_INLINE bool RenderTexture( const Uint32 layer, const SDL_FRect *srcrect, const SDL_FRect *dstrect )
+            {
+                return RenderTextureRotated( layer, srcrect, dstrect, 0.0, nullptr, SDL_FLIP_NONE );
+            }
+
+            /// @param angle in degrees, clockwise.
+            /// @param center relative to dstrect, nullptr for its center.
+            SDL_INLINE bool RenderTextureRotated( const Uint32 layer, const SDL_FRect *srcrect, const SDL_FRect *dstrect, const double angle,
+                                                  const SDL_FPoint *center, const SDL_FlipMode flip )
+            {
+                Instance *instance = NextInstance();
+                if ( instance == nullptr )
+                    return false;
+
+                SDL_FRect dst;
+                if ( dstrect != nullptr )
+                {
+                    dst = *dstrect;
+                }
+                else
+                {
+                    // the inverse of the projection set by Begin
+                    dst.x = 0.0f;
+                    dst.y = 0.0f;
+                    dst.w = 2.0f / transform[0];
+                    dst.h = -2.0f / transform[5];
+                }
+                const float cx = center != nullptr ? center->x : dst.w * 0.5f;
+                const float cy = center != nullptr ? center->y : dst.h * 0.5f;
+                instance->pivot[0] = dst.x + cx;
+                instance->pivot[1] = dst.y + cy;
+                instance->rect[0] = FloatToHalf( -cx );
+                instance->rect[1] = FloatToHalf( -cy );
+                instance->rect[2] = FloatToHalf( dst.w );
+                instance->rect[3] = FloatToHalf( dst.h );
+
+                float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+                if ( srcrect != nullptr )
+                {
+                    u0 = srcrect->x / layerWidth;
+                    v0 = srcrect->y / layerHeight;
+                    u1 = ( srcrect->x + srcrect->w ) / layerWidth;
+                    v1 = ( srcrect->y + srcrect->h ) / layerHeight;
+                }
+                if ( flip & SDL_FLIP_HORIZONTAL )
+                {
+                    const float u = u0;
+                    u0 = u1;
+                    u1 = u;
+                }
+                if ( flip & SDL_FLIP_VERTICAL )
+                {
+                    const float v = v0;
+                    v0 = v1;
+                    v1 = v;
+                }
+                instance->uv[0] = ToUnorm16( u0 );
+                instance->uv[1] = ToUnorm16( v0 );
+                instance->uv[2] = ToUnorm16( u1 );
+                instance->uv[3] = ToUnorm16( v1 );
+
+                instance->color[0] = color[0];
+                instance->color[1] = color[1];
+                instance->color[2] = color[2];
+                instance->color[3] = color[3];
+
+                // to -180 .. 180
+                double degrees = SDL_fmod( angle, 360.0 );
+                if ( degrees > 180.0 )
+                    degrees -= 360.0;
+                else if ( degrees < -180.0 )
+                    degrees += 360.0;
+                instance->angle = ( Sint16 )SDL_lround( degrees * ( 32767.0 / 180.0 ) );
+                instance->layer = ( Sint16 )layer;
+                return true;
+            }
+
+            /// @brief Add prebuilt instances, with the current texture.
+            SDL_INLINE Uint32 RenderInstances( const Instance *instances, const Uint32 count )
+            {
+                Uint32 added = 0;
+                while ( added < count )
+                {
+                    Instance *instance = NextInstance();
+                    if ( instance == nullptr )
+                    {
+                        dropped += count - added - 1;
+                        break;
+                    }
+                    *instance = instances[added++];
+                }
+                return added;
+            }
+
+            /// @brief Record the upload of the frame's sprites, before the render pass drawing them.
+            SDL_INLINE void Upload( const CopyPass &copyPass )
+            {
+                if ( mapped == nullptr )
+                    return;
+                staging.Unmap( *device );
+                mapped = nullptr;
+                if ( numSprites == 0 )
+                    return;
+
+                SDL_GPUTransferBufferLocation source;
+                source.transfer_buffer = staging;
+                source.offset = 0;
+                SDL_GPUBufferRegion destination;
+                destination.buffer = instanceBuffer;
+                destination.offset = 0;
+                destination.size = numSprites * ( Uint32 )sizeof( Instance );
+                copyPass.UploadToBuffer( &source, &destination, true );
+            }
+
+            /// @brief Draw the uploaded sprites, one instanced draw per texture change.
+            SDL_INLINE void Draw( const CommandBuffer &commandBuffer, const RenderPass &renderPass ) const
+            {
+                if ( numSprites == 0 || mapped != nullptr )
+                    return;
+
+                renderPass.BindGraphicsPipeline( pipeline );
+                SDL_GPUBufferBinding binding;
+                binding.buffer = instanceBuffer;
+                binding.offset = 0;
+                renderPass.BindVertexBuffers( 0, &binding, 1 );
+                commandBuffer.PushGPUVertexUniformData( 0, transform, sizeof( transform ) );
+                for ( int i = 0; i < batches.Num(); i++ )
+                {
+                    const Batch &batch = batches[i];
+                    SDL_GPUTextureSamplerBinding textureBinding;
+                    textureBinding.texture = batch.texture;
+                    textureBinding.sampler = batch.sampler;
+                    renderPass.BindFragmentSamplers( 0, &textureBinding, 1 );
+                    renderPass.DrawGPUPrimitives( 6, batch.count, 0, batch.first );
+                }
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats;
+                stats.sprites = numSprites;
+                stats.batches = ( Uint32 )batches.Num();
+                stats.dropped = dropped;
+                return stats;
+            }
+
+        private:
+            SpriteRenderer( const SpriteRenderer & );
+            SpriteRenderer &operator=( const SpriteRenderer & );
+
+            struct Batch
+            {
+                SDL_GPUTexture*     texture;
+                SDL_GPUSampler*     sampler;
+                Uint32              first;
+                Uint32              count;
+            };
+
+            static SDL_INLINE Uint16 ToUnorm16( const float value )
+            {
+                return ( Uint16 )( SDL_clamp( value, 0.0f, 1.0f ) * 65535.0f + 0.5f );
+            }
+
+            SDL_INLINE Instance* NextInstance( void )
+            {
+                if ( mapped == nullptr )
+                {
+                    SDL_SetError( "SpriteRenderer: Begin was not called" );
+                    return nullptr;
+                }
+                if ( numSprites == maxSprites )
+                {
+                    dropped++;
+                    SDL_SetError( "SpriteRenderer: more than %u sprites", maxSprites );
+                    return nullptr;
+                }
+                Batch *batch = batches.Num() > 0 ? &batches.Last() : nullptr;
+                if ( batch == nullptr || batch->texture != texture || batch->sampler != sampler )
+                {
+                    Batch next;
+                    next.texture = texture;
+                    next.sampler = sampler;
+                    next.first = numSprites;
+                    next.count = 0;
+                    if ( !batches.Append( next ) )
+                    {
+                        SDL_OutOfMemory();
+                        return nullptr;
+                    }
+                    batch = &batches.Last();
+                }
+                batch->count++;
+                return &mapped[numSprites++];
+            }
+
+            const Device*       device;
+            GraphicsPipeline    pipeline;
+            Buffer              instanceBuffer;
+            TransferBuffer      staging;
+            Uint32              maxSprites;
+            Uint32              numSprites;
+            Uint32              dropped;
+            Instance*           mapped;         // the staging buffer, between Begin and Upload
+            float               transform[16];
+            float               layerWidth;
+            float               layerHeight;
+            SDL_GPUTexture*     texture;
+            SDL_GPUSampler*     sampler;
+            Uint8               color[4];
+            Array<Batch>        batches;
+        };
+    }
+}
+#endif //!__SDL_SPRITE_RENDERER_HPP__
@@ -0,0 +1,344 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_STATS_OVERLAY_HPP__
+#define __SDL_STATS_OVERLAY_HPP__
+
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+#include "SDL_array.hpp"
+#include "SDL_audio.hpp"
+#include "SDL_render.hpp"
+
+namespace SDL
+{
+/*
+==================================================================
+StatsOverlay
+==================================================================
+    Draws a small stats panel in a corner of the render output: a
+    frame time graph, draw call and state change counts, texture
+    memory and audio queue depth.
+
+    The debug font glyphs are rendered once into an atlas texture on
+    Create, after that the whole panel ( background, graph and text )
+    is built on the CPU and drawn with a single RenderGeometry call,
+    so it is cheap enough to leave on.
+
+    Draw and state change counts come from the render instrumentation
+    when SDL3PP_INSTRUMENT_RENDER is defined, otherwise set them with
+    SetCallCounts. Texture memory is not tracked by SDL, the owner of
+    the textures reports it with SetTextureMemory.
+
+    Example usage:
+        SDL::StatsOverlay overlay;
+        if ( overlay.Create( renderer ) )
+        {
+            overlay.SetAudioStream( music );
+            ...
+            // every frame, just before Present
+            overlay.Draw();
+            renderer.Present();
+            ...
+            overlay.Destroy();
+        }
+==================================================================
+*/
+    class StatsOverlay
+    {
+    public:
+        enum Corner
+        {
+            TOP_LEFT = 0,
+            TOP_RIGHT,
+            BOTTOM_LEFT,
+            BOTTOM_RIGHT
+        };
+
+        static const int    GRAPH_SAMPLES = 120;
+        static const int    COLUMNS = 30;
+        static const int    MAX_QUADS = 1024;
+
+        StatsOverlay( void ) :
+            corner( TOP_LEFT ),
+            margin( 8.0f ),
+            scale( 1.0f ),
+            graphMaxMS( 33.3f ),
+            targetMS( 1000.0f / 60.0f ),
+            audioStream( nullptr ),
+            textureMemory( 0 ),
+            drawCalls( 0 ),
+            stateChanges( 0 ),
+            lastDraw( 0 ),
+            sampleIndex( 0 )
+        {
+            SDL_zeroa( samples );
+        }
+
+        ~StatsOverlay( void ) {}
+
+        /// @brief Build the glyph atlas, uses the renderer's debug font.
+        /// @return true on success or false on failure; call SDL_GetError() for more information.
+        SDL_INLINE bool Create( const Renderer &target )
+        {
+            const int glyph = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+            renderer = target;
+
+            if ( !atlas.CreateTexture( renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, ATLAS_COLUMNS * glyph, ATLAS_ROWS * glyph ) )
+                return false;
+
+            atlas.SetBlendMode( SDL_BLENDMODE_BLEND );
+            atlas.SetScaleMode( SDL_SCALEMODE_NEAREST );
+
+            // render the printable ASCII range once, the last cell is left solid white for the panel and graph quads
+            Texture previous = renderer.GetRenderTarget();
+            Uint8 r, g, b, a;
+            renderer.GetDrawColor( &r, &g, &b, &a );
+
+            bool ok = renderer.SetTarget( atlas );
+            ok = ok && renderer.SetDrawColor( 0, 0, 0, 0 ) && renderer.Clear();
+            ok = ok && renderer.SetDrawColor( 255, 255, 255, 255 );
+
+            char text[2] = { 0, 0 };
+            for ( int c = FIRST_CHAR; ok && c < WHITE_CHAR; c++ )
+            {
+                text[0] = ( char )c;
+                ok = renderer.DebugText( ( float )( GlyphColumn( c ) * glyph ), ( float )( GlyphRow( c ) * glyph ), text );
+            }
+
+            const SDL_FRect white = { ( float )( GlyphColumn( WHITE_CHAR ) * glyph ), ( float )( GlyphRow( WHITE_CHAR ) * glyph ), ( float )glyph, ( float )glyph };
+            ok = ok && renderer.RenderFillRect( &white );
+
+            renderer.SetTarget( previous );
+            renderer.SetDrawColor( r, g, b, a );
+
+            if ( !ok )
+            {
+                atlas.Destroy();
+                return false;
+            }
+
+            // the quad index pattern never changes
+            if ( !indices.Resize( MAX_QUADS * 6 ) || !vertices.Reserve( MAX_QUADS * 4 ) )
+            {
+                atlas.Destroy();
+                return SDL_SetError( "StatsOverlay: out of memory" );
+            }
+
+            for ( int i = 0; i < MAX_QUADS; i++ )
+            {
+                int *idx = &indices[i * 6];
+                idx[0] = i * 4 + 0; idx[1] = i * 4 + 1; idx[2] = i * 4 + 2;
+                idx[3] = i * 4 + 0; idx[4] = i * 4 + 2; idx[5] = i * 4 + 3;
+            }
+
+            lastDraw = SDL_GetPerformanceCounter();
+            return true;
+        }
+
+        SDL_INLINE void Destroy( void )
+        {
+            atlas.Destroy();
+            vertices.Free();
+            indices.Free();
+        }
+
+        SDL_INLINE void SetCorner( const Corner where, const float margin_px ) { corner = where; margin = margin_px; }
+        SDL_INLINE void SetScale( const float pixel_scale ) { scale = pixel_scale; }
+
+        /// @brief Set the frame time graph range and the target frame time drawn as a line.
+        SDL_INLINE void SetGraphRange( const float max_ms, const float target_ms ) { graphMaxMS = max_ms; targetMS = target_ms; }
+
+        /// @brief The texture memory shown in the panel, in bytes.
+        SDL_INLINE void SetTextureMemory( const Uint64 bytes ) { textureMemory = bytes; }
+
+        /// @brief Show the queue depth of a audio stream, pass a null stream to hide it.
+        SDL_INLINE void SetAudioStream( const Audio::Stream &stream ) { audioStream = stream; }
+
+        /// @brief Draw and state change counts, only used without SDL3PP_INSTRUMENT_RENDER.
+        SDL_INLINE void SetCallCounts( const Uint32 draw_calls, const Uint32 state_changes ) { drawCalls = draw_calls; stateChanges = state_changes; }
+
+        /// @brief Draw the panel, call once per frame before Present. The time between calls is the frame time.
+        /// @return true on success or false on failure; call SDL_GetError() for more information.
+        SDL_INLINE bool Draw( void )
+        {
+            const Uint64 now = SDL_GetPerformanceCounter();
+            const float frameMS = ( float )( ( double )( now - lastDraw ) * 1000.0 / ( double )SDL_GetPerformanceFrequency() );
+            lastDraw = now;
+            samples[sampleIndex] = frameMS;
+            sampleIndex = ( sampleIndex + 1 ) % GRAPH_SAMPLES;
+
+#ifdef SDL3PP_INSTRUMENT_RENDER
+            const Instrument::Recorder &recorder = Instrument::Recorder::Get();
+            if ( recorder.NumFrames() > 0 )
+            {
+                drawCalls = recorder.GetFrame( 0 ).calls[Instrument::CALL_DRAW];
+                stateChanges = recorder.GetFrame( 0 ).calls[Instrument::CALL_STATE];
+            }
+#endif //SDL3PP_INSTRUMENT_RENDER
+
+            float maxMS = 0.0f;
+            float sumMS = 0.0f;
+            for ( int i = 0; i < GRAPH_SAMPLES; i++ )
+            {
+                maxMS = SDL_max( maxMS, samples[i] );
+                sumMS += samples[i];
+            }
+
+            char lines[LINES][COLUMNS + 1];
+            SDL_snprintf( lines[0], sizeof( lines[0] ), "frame %6.2f ms %6.1f fps", frameMS, frameMS > 0.0f ? 1000.0f / frameMS : 0.0f );
+            SDL_snprintf( lines[1], sizeof( lines[1] ), "avg   %6.2f ms max %6.2f", sumMS / GRAPH_SAMPLES, maxMS );
+            SDL_snprintf( lines[2], sizeof( lines[2] ), "draws %6u  state %6u", drawCalls, stateChanges );
+            SDL_snprintf( lines[3], sizeof( lines[3] ), "tex   %8.2f MB", ( double )textureMemory / ( 1024.0 * 1024.0 ) );
+            AudioLine( lines[4], sizeof( lines[4] ) );
+
+            const float glyph = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * scale;
+            const float pad = 4.0f * scale;
+            const float graphHeight = 40.0f * scale;
+            const float width = COLUMNS * glyph + pad * 2.0f;
+            const float height = LINES * glyph + graphHeight + pad * 3.0f;
+
+            int outW = 0, outH = 0;
+            int *pw = &outW, *ph = &outH;
+            renderer.GetCurrentOutputSize( pw, ph );
+
+            const float x0 = ( corner == TOP_LEFT || corner == BOTTOM_LEFT ) ? margin : ( float )outW - width - margin;
+            const float y0 = ( corner == TOP_LEFT || corner == TOP_RIGHT ) ? margin : ( float )outH - height - margin;
+
+            vertices.Clear();
+
+            const SDL_FColor background = { 0.0f, 0.0f, 0.0f, 0.6f };
+            PushSolid( x0, y0, width, height, background );
+
+            // frame time graph, oldest sample on the left
+            const float graphY = y0 + pad + glyph * 2.0f + pad;
+            const float barWidth = ( width - pad * 2.0f ) / GRAPH_SAMPLES;
+            for ( int i = 0; i < GRAPH_SAMPLES; i++ )
+            {
+                const float ms = samples[( sampleIndex + i ) % GRAPH_SAMPLES];
+                const float h = SDL_min( ms / graphMaxMS, 1.0f ) * graphHeight;
+                const SDL_FColor good = { 0.2f, 0.9f, 0.2f, 0.9f };
+                const SDL_FColor late = { 0.95f, 0.8f, 0.1f, 0.9f };
+                const SDL_FColor bad = { 0.95f, 0.2f, 0.2f, 0.9f };
+                PushSolid( x0 + pad + i * barWidth, graphY + graphHeight - h, barWidth, h, ms <= targetMS * 1.05f ? good : ms <= targetMS * 2.05f ? late : bad );
+            }
+
+            const SDL_FColor line = { 1.0f, 1.0f, 1.0f, 0.5f };
+            const float targetY = graphY + graphHeight - SDL_min( targetMS / graphMaxMS, 1.0f ) * graphHeight;
+            PushSolid( x0 + pad, targetY, width - pad * 2.0f, scale, line );
+
+            const SDL_FColor text = { 1.0f, 1.0f, 1.0f, 1.0f };
+            PushText( x0 + pad, y0 + pad, lines[0], glyph, text );
+            PushText( x0 + pad, y0 + pad + glyph, lines[1], glyph, text );
+            for ( int i = 2; i < LINES; i++ )
+                PushText( x0 + pad, graphY + graphHeight + pad + ( i - 2 ) * glyph, lines[i], glyph, text );
+
+            const int quads = vertices.Num() / 4;
+            return renderer.RenderGeometry( atlas, vertices.Ptr(), vertices.Num(), indices.Ptr(), quads * 6 );
+        }
+
+    private:
+        static const int    LINES = 5;
+        static const int    FIRST_CHAR = 32;
+        static const int    WHITE_CHAR = 127;
+        static const int    ATLAS_COLUMNS = 16;
+        static const int    ATLAS_ROWS = 6;
+
+        static SDL_INLINE int GlyphColumn( const int c ) { return ( c - FIRST_CHAR ) % ATLAS_COLUMNS; }
+        static SDL_INLINE int GlyphRow( const int c ) { return ( c - FIRST_CHAR ) / ATLAS_COLUMNS; }
+
+        SDL_INLINE void PushQuad( const float x, const float y, const float w, const float h, const float u0, const float v0, const float u1, const float v1, const SDL_FColor &color )
+        {
+            if ( vertices.Num() + 4 > MAX_QUADS * 4 )
+                return;
+
+            SDL_Vertex *v = vertices.AppendUninitialized( 4 );
+            v[0].position.x = x;        v[0].position.y = y;        v[0].tex_coord.x = u0;  v[0].tex_coord.y = v0;
+            v[1].position.x = x + w;    v[1].position.y = y;        v[1].tex_coord.x = u1;  v[1].tex_coord.y = v0;
+            v[2].position.x = x + w;    v[2].position.y = y + h;    v[2].tex_coord.x = u1;  v[2].tex_coord.y = v1;
+            v[3].position.x = x;        v[3].position.y = y + h;    v[3].tex_coord.x = u0;  v[3].tex_coord.y = v1;
+            v[0].color = v[1].color = v[2].color = v[3].color = color;
+        }
+
+        SDL_INLINE void PushSolid( const float x, const float y, const float w, const float h, const SDL_FColor &color )
+        {
+            // sample the middle of the white cell so filtering never reaches a glyph
+            const float u = ( GlyphColumn( WHITE_CHAR ) + 0.5f ) / ATLAS_COLUMNS;
+            const float v = ( GlyphRow( WHITE_CHAR ) + 0.5f ) / ATLAS_ROWS;
+            PushQuad( x, y, w, h, u, v, u, v, color );
+        }
+
+        SDL_INLINE void PushText( float x, const float y, const char *str, const float glyph, const SDL_FColor &color )
+        {
+            for ( ; *str; str++, x += glyph )
+            {
+                const int c = ( Uint8 )*str;
+                if ( c <= FIRST_CHAR || c >= WHITE_CHAR )
+                    continue;
+
+                const float u0 = ( float )GlyphColumn( c ) / ATLAS_COLUMNS;
+                const float v0 = ( float )GlyphRow( c ) / ATLAS_ROWS;
+                PushQuad( x, y, glyph, glyph, u0, v0, u0 + 1.0f / ATLAS_COLUMNS, v0 + 1.0f / ATLAS_ROWS, color );
+            }
+        }
+
+        SDL_INLINE void AudioLine( char *line, const size_t size ) const
+        {
+            if ( audioStream.GetHandle() == nullptr )
+            {
+                SDL_snprintf( line, size, "audio -" );
+                return;
+            }
+
+            const int queued = audioStream.GetQueued();
+            SDL_AudioSpec src, dst;
+            double ms = 0.0;
+            if ( queued > 0 && audioStream.GetFormat( &src, &dst ) && src.freq > 0 )
+                ms = ( double )queued * 1000.0 / ( ( double )SDL_AUDIO_FRAMESIZE( src ) * src.freq );
+
+            SDL_snprintf( line, size, "audio %8d B %6.1f ms", queued, ms );
+        }
+
+        Renderer            renderer;
+        Texture             atlas;
+        Corner              corner;
+        float               margin;
+        float               scale;
+        float               graphMaxMS;
+        float               targetMS;
+        Audio::Stream       audioStream;
+        Uint64              textureMemory;
+        Uint32              drawCalls;
+        Uint32              stateChanges;
+        Uint64              lastDraw;
+        int                 sampleIndex;
+        float               samples[GRAPH_SAMPLES];
+        Array<SDL_Vertex>   vertices;
+        Array<int>          indices;
+    };
+};
+
+#endif //!__SDL_STATS_OVERLAY_HPP__
@@ -0,0 +1,814 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_TEXTURE_STREAMER_HPP__
+#define __SDL_TEXTURE_STREAMER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_iostream.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+TextureStreamer
+==================================================================
+    Streams texture data from files to GPU textures without blocking
+    the frame. Each request reads a range of a file, already in the
+    layout of the texture ( a mip level of a DDS / KTX payload, a
+    packed asset archive, ... ), with IO::AsyncIO::Read straight into
+    mapped transfer buffer memory, so the data is never copied on the
+    CPU.
+
+    Requests are staged in a few large transfer buffers. A block stays
+    mapped while reads land in it; once they are done it is unmapped
+    and its requests are uploaded by Upload, in request order ( a
+    request still reading does not hold back the ones after it ) and at
+    most frame_budget bytes per frame so streaming never spikes the
+    frame time ( a request larger than the budget gets a frame of its
+    own ). EndFrame takes the fence of the command buffer holding the
+    uploads; when it signals, the callbacks of the requests are called
+    from Update and the staging space is reused. Requests larger than
+    a block get a transfer buffer of their own.
+
+    The files and the textures must stay alive until the callback of
+    their requests, Destroy waits for the reads in flight.
+
+    Example usage:
+        SDL::GPU::TextureStreamer streamer;
+        streamer.Create( device, 8 * 1024 * 1024, 4, 4 * 1024 * 1024 );
+        ...
+        SDL_GPUTextureRegion region = { texture, mip, 0, 0, 0, 0, width >> mip, height >> mip, 1 };
+        streamer.Request( archive, mipOffset, mipSize, region, 0, 0, OnMipLoaded, material );
+        ...
+        // every frame
+        streamer.Update();
+        copyPass.Begin( commandBuffer );
+        streamer.Upload( copyPass );
+        copyPass.End();
+        ...
+        streamer.EndFrame( commandBuffer.SubmitAndAcquireFence() );
+==================================================================
+*/
+        class TextureStreamer
+        {
+        public:
+            typedef Uint32 Handle;
+
+            static const Handle INVALID_HANDLE = 0;
+            // staging offsets are aligned to this, the strictest texture upload placement of the backends
+            static const Uint32 STAGING_ALIGNMENT = 512;
+
+            /// @param succeeded false if the read failed, the texture was not updated.
+            typedef void ( SDLCALL *ReadyCallback )( void *userdata, Handle handle, bool succeeded );
+
+            struct Stats
+            {
+                int     queued;         // waiting for staging space
+                int     reading;
+                int     ready;          // read, waiting for Upload
+                int     uploading;      // uploaded, waiting for the fence
+                int     blocks;
+                Uint64  stagingBytes;
+                Uint64  completed;
+                Uint64  failed;
+                Uint64  bytesRead;
+                Uint64  bytesUploaded;
+                Uint64  frameBytes;     // uploaded by the last Upload
+                Uint32  deferredFrames; // frames the budget left ready requests for later
+            };
+
+            TextureStreamer( void ) : device( nullptr ), blockSize( 0 ), maxBlocks( 0 ), frameBudget( 0 ), current( -1 ), reading( 0 ), frame( 1 ), sequence( 0 ), frameBytes( 0 ), lastFrameBytes( 0 ), frameUploads( 0 )
+            {
+                SDL_zero( counters );
+            }
+            ~TextureStreamer( void ) { Destroy(); }
+
+            /// @param device the device, it must outlive the streamer.
+            /// @param block_size size of the staging transfer buffers.
+            /// @param max_blocks staging buffers that may exist at once, requests wait for space beyond that.
+            /// @param frame_budget bytes uploaded per frame at most, 0 for no limit.
+            SDL_INLINE bool Create( const Device &_device, const Uint32 block_size = 8 * 1024 * 1024, const int max_blocks = 4, const Uint32 frame_budget = 4 * 1024 * 1024 )
+            {
+                Destroy();
+                if ( block_size < STAGING_ALIGNMENT || max_blocks < 1 )
+                    return SDL_SetError( "TextureStreamer: invalid staging size" );
+                if ( !queue.Create() )
+                    return false;
+
+                device = &_device;
+                blockSize = RoundUp( block_size, STAGING_ALIGNMENT );
+                maxBlocks = max_blocks;
+                frameBudget = frame_budget;
+                current = -1;
+                frame = 1;
+                SDL_zero( counters );
+                return true;
+            }
+
+            /// @brief Wait for the reads and uploads in flight and release everything, callbacks are not called.
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                // the reads write into the staging memory, it must outlive them
+                SDL_AsyncIOOutcome outcome;
+                while ( reading > 0 && queue.WaitResult( &outcome, -1 ) )
+                    reading--;
+                queue.DestroyAsyncIOQueue();
+
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() != nullptr )
+                    {
+                        fence.WaitForFence( *device, true );
+                        fence.Release( *device );
+                    }
+                }
+                for ( int i = 0; i < blocks.Num(); i++ )
+                    ReleaseBlock( blocks[i] );
+
+                requests.Free();
+                freeSlots.Free();
+                queued.Free();
+                ready.Free();
+                uploaded.Free();
+                frames.Free();
+                blocks.Free();
+                notifications.Free();
+                reading = 0;
+                current = -1;
+                device = nullptr;
+            }
+
+            /// @brief Queue a read of size bytes at offset in file, uploaded into region.
+            /// @param pixels_per_row, rows_per_layer layout of the data, 0 if tightly packed.
+            /// @param cycle cycle the texture on upload, only if nothing else in it is still needed.
+            /// @return the handle of the request, INVALID_HANDLE on failure.
+            SDL_INLINE Handle Request( const IO::AsyncIO &file, const Uint64 offset, const Uint32 size, const SDL_GPUTextureRegion &region,
+                                       const Uint32 pixels_per_row = 0, const Uint32 rows_per_layer = 0,
+                                       ReadyCallback callback = nullptr, void *userdata = nullptr, const bool cycle = false )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "TextureStreamer: not created" );
+                    return INVALID_HANDLE;
+                }
+                if ( static_cast<SDL_AsyncIO*>( file ) == nullptr || region.texture == nullptr || size == 0 )
+                {
+                    SDL_SetError( "TextureStreamer: invalid request" );
+                    return INVALID_HANDLE;
+                }
+
+                const int slot = AllocateSlot();
+                if ( slot < 0 || queued.Append( slot ) == nullptr )
+                {
+                    if ( slot >= 0 )
+                        FreeSlot( slot );
+                    SDL_OutOfMemory();
+                    return INVALID_HANDLE;
+                }
+
+                Entry &entry = requests[slot];
+                entry.file = file;
+                entry.offset = offset;
+                entry.size = size;
+                entry.region = region;
+                entry.pixelsPerRow = pixels_per_row;
+                entry.rowsPerLayer = rows_per_layer;
+                entry.callback = callback;
+                entry.userdata = userdata;
+                entry.cycle = cycle;
+                entry.canceled = false;
+                entry.block = -1;
+                entry.sequence = sequence++;
+                entry.state = STATE_QUEUED;
+                return MakeHandle( slot );
+            }
+
+            /// @brief Drop a request that is not uploaded yet, its callback is not called.
+            /// @return false if the handle is unknown or the upload is already recorded.
+            SDL_INLINE bool Cancel( const Handle handle )
+            {
+                const int slot = Find( handle );
+                if ( slot < 0 )
+                    return false;
+
+                Entry &entry = requests[slot];
+                switch ( entry.state )
+                {
+                case STATE_QUEUED:
+                    RemoveSlot( queued, slot );
+                    FreeSlot( slot );
+                    return true;
+                case STATE_READING:
+                    // the read can not be stopped, the slot is freed when it lands
+                    entry.canceled = true;
+                    return true;
+                case STATE_READY:
+                    RemoveSlot( ready, slot );
+                    blocks[entry.block].readyCount--;
+                    Unreference( entry.block );
+                    FreeSlot( slot );
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            /// @return true until the callback of the request was called.
+            SDL_INLINE bool IsPending( const Handle handle ) const
+            {
+                return Find( handle ) >= 0;
+            }
+
+            /// @brief Collect finished reads and signaled fences, start the reads that fit in staging and call the callbacks.
+            SDL_INLINE void Update( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                CollectReads();
+                Retire();
+                Seal();
+                StartReads();
+
+                // callbacks last, they may make new requests
+                for ( int i = 0; i < notifications.Num(); i++ )
+                {
+                    const Notification &notification = notifications[i];
+                    notification.callback( notification.userdata, notification.handle, notification.succeeded );
+                }
+                notifications.Clear();
+            }
+
+            /// @brief Record the uploads of the requests that are read, within the frame budget.
+            SDL_INLINE void Upload( const CopyPass &copyPass )
+            {
+                for ( int i = 0; i < ready.Num(); i++ )
+                {
+                    const int slot = ready[i];
+                    Entry &entry = requests[slot];
+                    const Block &block = blocks[entry.block];
+                    // other reads still land in its block
+                    if ( block.mapped != nullptr )
+                        continue;
+                    if ( frameBudget > 0 && frameBytes > 0 && frameBytes + entry.size > frameBudget )
+                    {
+                        counters.deferredFrames++;
+                        break;
+                    }
+
+                    SDL_GPUTextureTransferInfo source;
+                    source.transfer_buffer = block.buffer;
+                    source.offset = entry.stagingOffset;
+                    source.pixels_per_row = entry.pixelsPerRow;
+                    source.rows_per_layer = entry.rowsPerLayer;
+                    copyPass.UploadToTexture( &source, &entry.region, entry.cycle );
+
+                    entry.state = STATE_UPLOADED;
+                    entry.frame = frame;
+                    blocks[entry.block].readyCount--;
+                    frameBytes += entry.size;
+                    frameUploads++;
+                    counters.bytesUploaded += entry.size;
+                    uploaded.Append( slot );
+                    ready.RemoveIndex( i-- );
+                }
+            }
+
+            /// @brief Close the frame, the uploads recorded since the previous EndFrame complete when fence signals.
+            /// @param fence the fence of the command buffer holding the uploads, the streamer releases it.
+            SDL_INLINE bool EndFrame( SDL_GPUFence *fence )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "TextureStreamer: not created" );
+
+                lastFrameBytes = frameBytes;
+                if ( frameUploads > 0 || fence == nullptr )
+                {
+                    // without a fence the frame completes with the next one, command buffers finish in order
+                    Frame entry;
+                    entry.fence = fence;
+                    entry.frame = frame;
+                    frames.Append( entry );
+                }
+                else
+                {
+                    Fence( fence ).Release( *device );
+                }
+
+                frame++;
+                frameBytes = 0;
+                frameUploads = 0;
+                return fence != nullptr ? true : SDL_SetError( "TextureStreamer: EndFrame without a fence" );
+            }
+
+            SDL_INLINE void SetFrameBudget( const Uint32 frame_budget ) { frameBudget = frame_budget; }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats = counters;
+                stats.queued = queued.Num();
+                stats.reading = reading;
+                stats.ready = ready.Num();
+                stats.uploading = uploaded.Num();
+                stats.frameBytes = lastFrameBytes;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].buffer == nullptr )
+                        continue;
+                    stats.blocks++;
+                    stats.stagingBytes += blocks[i].size;
+                }
+                return stats;
+            }
+
+        private:
+            TextureStreamer( const TextureStreamer & );
+            TextureStreamer &operator=( const TextureStreamer & );
+
+            enum
+            {
+                STATE_FREE,
+                STATE_QUEUED,
+                STATE_READING,
+                STATE_READY,
+                STATE_UPLOADED
+            };
+
+            struct Entry
+            {
+                SDL_AsyncIO*            file;
+                Uint64                  offset;
+                Uint32                  size;
+                SDL_GPUTextureRegion    region;
+                Uint32                  pixelsPerRow;
+                Uint32                  rowsPerLayer;
+                ReadyCallback           callback;
+                void*                   userdata;
+                int                     block;
+                Uint32                  stagingOffset;
+                Uint64                  frame;
+                Uint64                  sequence;       // order of the request
+                Uint16                  generation;
+                Uint8                   state;
+                bool                    cycle;
+                bool                    canceled;
+            };
+
+            struct Block
+            {
+                SDL_GPUTransferBuffer*  buffer;     // null once a dedicated block is released
+                Uint8*                  mapped;     // while reads may land in it
+                Uint32                  size;
+                Uint32                  head;
+                int                     reading;
+                int                     readyCount;
+                int                     refs;       // requests staged in it and not completed
+                bool                    sealed;     // full, no more allocations until refs drop to 0
+                bool                    dedicated;  // for a request larger than the block size
+            };
+
+            struct Frame
+            {
+                SDL_GPUFence*   fence;
+                Uint64          frame;
+            };
+
+            struct Notification
+            {
+                ReadyCallback   callback;
+                void*           userdata;
+                Handle          handle;
+                bool            succeeded;
+            };
+
+            static SDL_INLINE Uint32 RoundUp( const Uint32 value, const Uint32 multiple )
+            {
+                return ( value + multiple - 1 ) / multiple * multiple;
+            }
+
+            SDL_INLINE int AllocateSlot( void )
+            {
+                int slot;
+                if ( freeSlots.Num() > 0 )
+                {
+                    slot = freeSlots.Last();
+                    freeSlots.RemoveIndexFast( freeSlots.Num() - 1 );
+                }
+                else
+                {
+                    Entry *entry = requests.AppendUninitialized( 1 );
+                    if ( entry == nullptr )
+                        return -1;
+                    SDL_zerop( entry );
+                    entry->generation = 1;
+                    slot = requests.Num() - 1;
+                }
+                return slot;
+            }
+
+            SDL_INLINE void FreeSlot( const int slot )
+            {
+                Entry &entry = requests[slot];
+                entry.state = STATE_FREE;
+                entry.generation = entry.generation == 0xffff ? 1 : ( Uint16 )( entry.generation + 1 );
+                freeSlots.Append( slot );
+            }
+
+            SDL_INLINE Handle MakeHandle( const int slot ) const
+            {
+                return ( ( Handle )requests[slot].generation << 16 ) | ( Handle )( slot + 1 );
+            }
+
+            SDL_INLINE int Find( const Handle handle ) const
+            {
+                const int slot = ( int )( handle & 0xffff ) - 1;
+                if ( slot < 0 || slot >= requests.Num() )
+                    return -1;
+                const Entry &entry = requests[slot];
+                return entry.state != STATE_FREE && entry.generation == ( Uint16 )( handle >> 16 ) ? slot : -1;
+            }
+
+            // reads mostly land in order, so the place is found from the end
+            SDL_INLINE void InsertReady( const int slot )
+            {
+                if ( ready.Append( slot ) == nullptr )
+                    return;
+                int i = ready.Num() - 1;
+                while ( i > 0 && requests[ready[i - 1]].sequence > requests[slot].sequence )
+                {
+                    ready[i] = ready[i - 1];
+                    i--;
+                }
+                ready[i] = slot;
+            }
+
+            static SDL_INLINE void RemoveSlot( Array<int> &list, const int slot )
+            {
+                for ( int i = 0; i < list.Num(); i++ )
+                {
+                    if ( list[i] == slot )
+                    {
+                        list.RemoveIndex( i );
+                        return;
+                    }
+                }
+            }
+
+            SDL_INLINE void Notify( const int slot, const bool succeeded )
+            {
+                const Entry &entry = requests[slot];
+                if ( succeeded )
+                    counters.completed++;
+                else
+                    counters.failed++;
+                if ( entry.callback == nullptr )
+                    return;
+
+                Notification notification;
+                notification.callback = entry.callback;
+                notification.userdata = entry.userdata;
+                notification.handle = MakeHandle( slot );
+                notification.succeeded = succeeded;
+                notifications.Append( notification );
+            }
+
+            SDL_INLINE void ReleaseBlock( Block &block )
+            {
+                if ( block.buffer == nullptr )
+                    return;
+                TransferBuffer buffer( block.buffer );
+                if ( block.mapped != nullptr )
+                    buffer.Unmap( *device );
+                buffer.Release( *device );
+                block.buffer = nullptr;
+                block.mapped = nullptr;
+            }
+
+            SDL_INLINE void Unmap( Block &block )
+            {
+                if ( block.mapped == nullptr )
+                    return;
+                TransferBuffer buffer( block.buffer );
+                buffer.Unmap( *device );
+                block.mapped = nullptr;
+            }
+
+            // a request staged in the block is done with it
+            SDL_INLINE void Unreference( const int index )
+            {
+                Block &block = blocks[index];
+                if ( --block.refs > 0 )
+                    return;
+                if ( block.dedicated )
+                {
+                    ReleaseBlock( block );
+                    return;
+                }
+                // an open block keeps filling, a sealed one starts over
+                if ( block.sealed )
+                {
+                    Unmap( block );
+                    block.head = 0;
+                    block.sealed = false;
+                }
+            }
+
+            SDL_INLINE int CreateBlock( const Uint32 size, const bool dedicated )
+            {
+                int index = -1;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].buffer == nullptr )
+                    {
+                        index = i;
+                        break;
+                    }
+                }
+                if ( index < 0 )
+                {
+                    if ( blocks.AppendUninitialized( 1 ) == nullptr )
+                    {
+                        SDL_OutOfMemory();
+                        return -1;
+                    }
+                    index = blocks.Num() - 1;
+                }
+
+                Block &block = blocks[index];
+                SDL_zero( block );
+                SDL_GPUTransferBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                info.size = size;
+                TransferBuffer buffer;
+                if ( !buffer.Create( *device, &info ) )
+                    return -1;
+                block.buffer = buffer.GetHandle();
+                block.size = size;
+                block.dedicated = dedicated;
+                return index;
+            }
+
+            SDL_INLINE int CountBlocks( void ) const
+            {
+                int count = 0;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].buffer != nullptr && !blocks[i].dedicated )
+                        count++;
+                }
+                return count;
+            }
+
+            // staging space for size bytes, -1 if it has to wait
+            SDL_INLINE int AllocateStaging( const Uint32 size, Uint32 &offset )
+            {
+                const Uint32 aligned = RoundUp( size, STAGING_ALIGNMENT );
+                int index = -1;
+                if ( aligned > blockSize )
+                {
+                    // one at a time, so large requests can not take all the memory
+                    for ( int i = 0; i < blocks.Num(); i++ )
+                    {
+                        if ( blocks[i].buffer != nullptr && blocks[i].dedicated )
+                            return -1;
+                    }
+                    index = CreateBlock( aligned, true );
+                }
+                else
+                {
+                    if ( current >= 0 )
+                    {
+                        Block &block = blocks[current];
+                        if ( !block.sealed && block.head + aligned <= block.size )
+                            index = current;
+                        else
+                            SealBlock( current );
+                    }
+                    for ( int i = 0; index < 0 && i < blocks.Num(); i++ )
+                    {
+                        const Block &block = blocks[i];
+                        if ( block.buffer != nullptr && !block.dedicated && !block.sealed && block.refs == 0 )
+                            index = i;
+                    }
+                    if ( index < 0 && CountBlocks() < maxBlocks )
+                        index = CreateBlock( blockSize, false );
+                    if ( index < 0 )
+                        return -1;
+                    current = index;
+                }
+                if ( index < 0 )
+                    return -1;
+
+                Block &block = blocks[index];
+                if ( block.mapped == nullptr )
+                {
+                    // the uploads from it are complete, there is nothing to cycle
+                    TransferBuffer buffer( block.buffer );
+                    block.mapped = static_cast<Uint8*>( buffer.Map( *device, false ) );
+                    if ( block.mapped == nullptr )
+                    {
+                        if ( block.dedicated )
+                            ReleaseBlock( block );
+                        return -1;
+                    }
+                }
+                offset = block.head;
+                block.head += aligned;
+                block.refs++;
+                if ( block.dedicated )
+                    block.sealed = true;
+                return index;
+            }
+
+            SDL_INLINE void SealBlock( const int index )
+            {
+                Block &block = blocks[index];
+                if ( current == index )
+                    current = -1;
+                if ( block.reading == 0 )
+                    Unmap( block );
+                if ( block.refs > 0 )
+                {
+                    block.sealed = true;
+                    return;
+                }
+                // every request staged in it is already done
+                block.head = 0;
+            }
+
+            SDL_INLINE void CollectReads( void )
+            {
+                SDL_AsyncIOOutcome outcome;
+                while ( reading > 0 && queue.GetResult( &outcome ) )
+                {
+                    reading--;
+                    const int slot = Find( ( Handle )( uintptr_t )outcome.userdata );
+                    if ( slot < 0 )
+                        continue;
+
+                    Entry &entry = requests[slot];
+                    Block &block = blocks[entry.block];
+                    block.reading--;
+                    counters.bytesRead += outcome.bytes_transferred;
+                    if ( entry.canceled )
+                    {
+                        Unreference( entry.block );
+                        FreeSlot( slot );
+                    }
+                    else if ( outcome.result != SDL_ASYNCIO_COMPLETE || outcome.bytes_transferred != entry.size )
+                    {
+                        Notify( slot, false );
+                        Unreference( entry.block );
+                        FreeSlot( slot );
+                    }
+                    else
+                    {
+                        entry.state = STATE_READY;
+                        block.readyCount++;
+                        InsertReady( slot );
+                    }
+                }
+            }
+
+            // complete the uploads of the frames whose fence signaled
+            SDL_INLINE void Retire( void )
+            {
+                int done = -1;
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() == nullptr )
+                        continue;
+                    if ( !fence.Query( *device ) )
+                        break;
+                    done = i;
+                }
+                if ( done < 0 )
+                    return;
+
+                const Uint64 completed = frames[done].frame;
+                for ( int i = 0; i <= done; i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    if ( fence.GetHandle() != nullptr )
+                        fence.Release( *device );
+                }
+                for ( int i = done; i >= 0; i-- )
+                    frames.RemoveIndex( i );
+
+                for ( int i = 0; i < uploaded.Num(); i++ )
+                {
+                    const int slot = uploaded[i];
+                    Entry &entry = requests[slot];
+                    if ( entry.frame > completed )
+                        continue;
+                    Notify( slot, true );
+                    Unreference( entry.block );
+                    FreeSlot( slot );
+                    uploaded.RemoveIndexFast( i-- );
+                }
+            }
+
+            // unmap the blocks whose reads are done, so their requests can be uploaded
+            SDL_INLINE void Seal( void )
+            {
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    Block &block = blocks[i];
+                    if ( block.mapped == nullptr || block.reading > 0 )
+                        continue;
+                    if ( block.sealed )
+                        Unmap( block );
+                    else if ( block.readyCount > 0 )
+                        SealBlock( i );
+                }
+            }
+
+            SDL_INLINE void StartReads( void )
+            {
+                while ( queued.Num() > 0 )
+                {
+                    const int slot = queued[0];
+                    Entry &entry = requests[slot];
+                    Uint32 offset = 0;
+                    const int index = AllocateStaging( entry.size, offset );
+                    if ( index < 0 )
+                        break;
+
+                    queued.RemoveIndex( 0 );
+                    Block &block = blocks[index];
+                    entry.block = index;
+                    entry.stagingOffset = offset;
+                    entry.state = STATE_READING;
+
+                    IO::AsyncIO file( entry.file );
+                    if ( !file.Read( block.mapped + offset, entry.offset, entry.size, queue, ( void* )( uintptr_t )MakeHandle( slot ) ) )
+                    {
+                        Notify( slot, false );
+                        Unreference( index );
+                        FreeSlot( slot );
+                        continue;
+                    }
+                    block.reading++;
+                    reading++;
+                }
+            }
+
+            const Device*           device;
+            IO::AsyncIOQueue        queue;
+            Uint32                  blockSize;
+            int                     maxBlocks;
+            Uint32                  frameBudget;
+            int                     current;        // block taking new reads
+            int                     reading;
+            Uint64                  frame;
+            Uint64                  sequence;       // of the next request
+            Uint64                  frameBytes;
+            Uint64                  lastFrameBytes;
+            int                     frameUploads;
+            Array<Entry>            requests;
+            Array<int>              freeSlots;
+            Array<int>              queued;         // in request order
+            Array<int>              ready;          // read, in request order
+            Array<int>              uploaded;
+            Array<Frame>            frames;
+            Array<Block>            blocks;
+            Array<Notification>     notifications;
+            Stats                   counters;
+        };
+    }
+}
+#endif //!__SDL_TEXTURE_STREAMER_HPP__
@@ -0,0 +1,520 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_TRANSFER_RING_HPP__
+#define __SDL_TRANSFER_RING_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+TransferRing
+==================================================================
+    Sub-allocates upload ( or download ) ranges out of a few large
+    transfer buffers instead of creating and releasing a transfer
+    buffer for every upload.
+
+    Every block is a ring: ranges are bump allocated at the head, and
+    at EndFrame the head of every block touched in the frame is tagged
+    with the fence of the frame's command buffer. Once that fence
+    signals, the tail moves up to the tagged head and the space is
+    reused. When no block has room, a new block is created ( at least
+    the block size, or the size of the request ).
+
+    Blocks stay mapped while ranges are written, Unmap must be called
+    before the copy pass that reads them is recorded; the next Allocate
+    maps again. The ring takes ownership of the fences given to
+    EndFrame and releases them once signaled. The ranges of a frame
+    ended without a fence are tagged with the next frame's fence.
+
+    Example usage:
+        SDL::GPU::TransferRing ring;
+        ring.Create( device, 8 * 1024 * 1024 );
+        ...
+        SDL::GPU::TransferRing::Allocation vertices;
+        if ( ring.Write( data, size, 16, vertices ) )
+        {
+            ring.Unmap();
+            SDL_GPUTransferBufferLocation source = vertices.Location();
+            SDL_GPUBufferRegion destination = { buffer, 0, size };
+            copyPass.UploadToBuffer( &source, &destination, false );
+        }
+        ...
+        ring.EndFrame( commandBuffer.SubmitAndAcquireFence() );
+        ...
+        ring.Release();
+==================================================================
+*/
+        class TransferRing
+        {
+        public:
+            // block sizes are rounded to this, so any power of two alignment up to it stays aligned after a wrap
+            static const Uint32 BLOCK_GRANULARITY = 64 * 1024;
+
+            struct Allocation
+            {
+                SDL_GPUTransferBuffer*  buffer;
+                Uint32                  offset;
+                Uint32                  size;
+                Uint8*                  data;
+
+                SDL_INLINE SDL_GPUTransferBufferLocation Location( void ) const
+                {
+                    SDL_GPUTransferBufferLocation location;
+                    location.transfer_buffer = buffer;
+                    location.offset = offset;
+                    return location;
+                }
+            };
+
+            struct Stats
+            {
+                int     blocks;
+                int     framesInFlight;
+                Uint64  capacity;
+                Uint64  used;           // bytes between the tails and heads, in flight or written this frame
+                Uint64  peakUsed;
+                Uint64  frameBytes;     // requested this frame, without alignment padding
+                Uint32  frameAllocations;
+                Uint32  grows;          // blocks created after the first one
+                double  utilization;    // used / capacity
+            };
+
+            TransferRing( void ) : device( nullptr ), usage( SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD ), blockSize( 0 ), current( -1 ), frameId( 0 ), peakUsed( 0 ), frameBytes( 0 ), frameAllocations( 0 ), grows( 0 ) {}
+            ~TransferRing( void ) { Release(); }
+
+            /// @brief Create the first block.
+            /// @param device the device, it must outlive the ring.
+            /// @param block_size size of each block in bytes, rounded up to BLOCK_GRANULARITY.
+            /// @param transfer_usage upload or download.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool Create( const Device &_device, const Uint32 block_size, const SDL_GPUTransferBufferUsage transfer_usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD )
+            {
+                Release();
+
+                device = &_device;
+                usage = transfer_usage;
+                blockSize = RoundUp( block_size > 0 ? block_size : BLOCK_GRANULARITY, BLOCK_GRANULARITY );
+                if ( AddBlock( blockSize ) < 0 )
+                {
+                    device = nullptr;
+                    return false;
+                }
+                grows = 0;
+                return true;
+            }
+
+            /// @brief Wait for the frames in flight and release the fences and the transfer buffers.
+            SDL_INLINE void Release( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    if ( frames[i].fence == nullptr )
+                        continue;
+                    Fence fence( frames[i].fence );
+                    fence.WaitForFence( *device, true );
+                    fence.Release( *device );
+                }
+
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    TransferBuffer buffer( blocks[i].buffer );
+                    if ( blocks[i].mapped != nullptr )
+                        buffer.Unmap( *device );
+                    buffer.Release( *device );
+                }
+
+                frames.Free();
+                marks.Free();
+                blocks.Free();
+                device = nullptr;
+                current = -1;
+                peakUsed = 0;
+                frameBytes = 0;
+                frameAllocations = 0;
+                grows = 0;
+            }
+
+            /// @brief Reserve size bytes for this frame.
+            /// @param alignment power of two, up to BLOCK_GRANULARITY.
+            /// @return false if the request is invalid or a new block could not be created.
+            SDL_INLINE bool Allocate( const Uint32 size, const Uint32 alignment, Allocation &out )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "TransferRing: not created" );
+
+                if ( size == 0 || alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 || alignment > BLOCK_GRANULARITY )
+                    return SDL_SetError( "TransferRing: invalid size %u or alignment %u", size, alignment );
+
+                // the current block first, then any other block, then again after reclaiming, then grow
+                int index = -1;
+                Uint64 offset = 0;
+                for ( int pass = 0; pass < 2 && index < 0; pass++ )
+                {
+                    if ( pass == 1 )
+                        Reclaim();
+
+                    if ( current >= 0 && Fit( blocks[current], size, alignment, offset ) )
+                        index = current;
+
+                    for ( int i = 0; i < blocks.Num() && index < 0; i++ )
+                    {
+                        if ( i != current && Fit( blocks[i], size, alignment, offset ) )
+                            index = i;
+                    }
+                }
+
+                if ( index < 0 )
+                {
+                    index = AddBlock( RoundUp( size > blockSize ? size : blockSize, BLOCK_GRANULARITY ) );
+                    if ( index < 0 || !Fit( blocks[index], size, alignment, offset ) )
+                        return false;
+                }
+
+                Block &block = blocks[index];
+                if ( block.mapped == nullptr )
+                {
+                    TransferBuffer buffer( block.buffer );
+                    block.mapped = static_cast<Uint8*>( buffer.Map( *device, false ) );
+                    if ( block.mapped == nullptr )
+                        return false;
+                }
+
+                const Uint32 physical = ( Uint32 )( offset % block.size );
+                block.head = offset + size;
+                block.touched = true;
+                current = index;
+
+                out.buffer = block.buffer;
+                out.offset = physical;
+                out.size = size;
+                out.data = block.mapped + physical;
+
+                frameBytes += size;
+                frameAllocations++;
+                const Uint64 used = Used();
+                if ( used > peakUsed )
+                    peakUsed = used;
+                return true;
+            }
+
+            /// @brief Allocate and copy data into the range.
+            SDL_INLINE bool Write( const void *data, const Uint32 size, const Uint32 alignment, Allocation &out )
+            {
+                if ( !Allocate( size, alignment, out ) )
+                    return false;
+                SDL_memcpy( out.data, data, size );
+                return true;
+            }
+
+            /// @brief Unmap the blocks written this frame, call it before recording the copy pass.
+            SDL_INLINE void Unmap( void )
+            {
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( blocks[i].mapped != nullptr )
+                    {
+                        TransferBuffer buffer( blocks[i].buffer );
+                        buffer.Unmap( *device );
+                        blocks[i].mapped = nullptr;
+                    }
+                }
+            }
+
+            /// @brief Close the frame, the ranges allocated since the previous EndFrame are reused once fence signals.
+            /// @param fence the fence of the command buffer reading the ranges, the ring releases it.
+            /// @return false if fence is null, the ranges then wait for the fence of the next frame ( or ReclaimAll ).
+            SDL_INLINE bool EndFrame( SDL_GPUFence *fence )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "TransferRing: not created" );
+
+                Unmap();
+
+                if ( fence == nullptr )
+                {
+                    // nothing to wait on: carry the ranges over to the next frame with a fence
+                    for ( int i = 0; i < blocks.Num(); i++ )
+                    {
+                        if ( blocks[i].touched )
+                        {
+                            blocks[i].carried = true;
+                            blocks[i].touched = false;
+                        }
+                    }
+                    frameBytes = 0;
+                    frameAllocations = 0;
+                    Reclaim();
+                    return SDL_SetError( "TransferRing: EndFrame without a fence" );
+                }
+
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    if ( !blocks[i].touched && !blocks[i].carried )
+                        continue;
+
+                    Mark mark;
+                    mark.frame = frameId;
+                    mark.block = i;
+                    mark.head = blocks[i].head;
+                    marks.Append( mark );
+                    blocks[i].touched = false;
+                    blocks[i].carried = false;
+                }
+
+                Frame frame;
+                frame.fence = fence;
+                frame.id = frameId++;
+                frames.Append( frame );
+
+                frameBytes = 0;
+                frameAllocations = 0;
+                Reclaim();
+                return true;
+            }
+
+            /// @brief Reuse the ranges of the frames whose fence signaled, in submission order.
+            SDL_INLINE void Reclaim( void )
+            {
+                while ( !frames.Empty() )
+                {
+                    Fence fence( frames[0].fence );
+                    if ( !fence.Query( *device ) )
+                        break;
+
+                    fence.Release( *device );
+                    Retire( frames[0].id );
+                    frames.RemoveIndex( 0 );
+                }
+            }
+
+            /// @brief Reuse every range, only call it once the GPU is idle ( Device::WaitForGPUIdle ).
+            SDL_INLINE void ReclaimAll( void )
+            {
+                for ( int i = 0; i < frames.Num(); i++ )
+                {
+                    Fence fence( frames[i].fence );
+                    fence.Release( *device );
+                }
+                frames.Clear();
+                marks.Clear();
+
+                for ( int i = 0; i < blocks.Num(); i++ )
+                {
+                    // keep the head where it is, only the touched ranges of this frame stay live
+                    if ( !blocks[i].touched )
+                        blocks[i].tail = blocks[i].head;
+                    blocks[i].carried = false;
+                }
+            }
+
+            /// @brief Release the blocks with nothing in flight, except the first one.
+            SDL_INLINE void Trim( void )
+            {
+                for ( int i = blocks.Num() - 1; i > 0; i-- )
+                {
+                    Block &block = blocks[i];
+                    if ( block.head != block.tail || block.touched || HasMarks( i ) )
+                        continue;
+
+                    TransferBuffer buffer( block.buffer );
+                    if ( block.mapped != nullptr )
+                        buffer.Unmap( *device );
+                    buffer.Release( *device );
+
+                    // block indices in the marks above i move down by one
+                    for ( int m = 0; m < marks.Num(); m++ )
+                    {
+                        if ( marks[m].block > i )
+                            marks[m].block--;
+                    }
+                    blocks.RemoveIndex( i );
+                    if ( current == i )
+                        current = -1;
+                    else if ( current > i )
+                        current--;
+                }
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats;
+                stats.blocks = blocks.Num();
+                stats.framesInFlight = frames.Num();
+                stats.capacity = 0;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                    stats.capacity += blocks[i].size;
+                stats.used = Used();
+                stats.peakUsed = peakUsed;
+                stats.frameBytes = frameBytes;
+                stats.frameAllocations = frameAllocations;
+                stats.grows = grows;
+                stats.utilization = stats.capacity > 0 ? ( double )stats.used / ( double )stats.capacity : 0.0;
+                return stats;
+            }
+
+        private:
+            // head and tail are virtual offsets that only grow, the physical offset is modulo the block size
+            struct Block
+            {
+                SDL_GPUTransferBuffer*  buffer;
+                Uint8*                  mapped;
+                Uint32                  size;
+                Uint64                  head;
+                Uint64                  tail;
+                bool                    touched;
+                bool                    carried;        // written in a frame that ended without a fence
+            };
+
+            // the head of a block at the end of a frame
+            struct Mark
+            {
+                Uint64  frame;
+                int     block;
+                Uint64  head;
+            };
+
+            struct Frame
+            {
+                SDL_GPUFence*   fence;
+                Uint64          id;
+            };
+
+            TransferRing( const TransferRing &ref );
+            TransferRing& operator=( const TransferRing &ref );
+
+            static SDL_INLINE Uint32 RoundUp( const Uint32 value, const Uint32 multiple )
+            {
+                return ( value + multiple - 1 ) / multiple * multiple;
+            }
+
+            static SDL_INLINE bool Fit( const Block &block, const Uint32 size, const Uint32 alignment, Uint64 &offset )
+            {
+                if ( size > block.size )
+                    return false;
+
+                Uint64 start = ( block.head + alignment - 1 ) & ~( Uint64 )( alignment - 1 );
+                // a range never wraps, skip to the start of the buffer instead
+                if ( start % block.size + size > block.size )
+                    start = ( start / block.size + 1 ) * block.size;
+
+                if ( start + size - block.tail > block.size )
+                    return false;
+
+                offset = start;
+                return true;
+            }
+
+            SDL_INLINE int AddBlock( const Uint32 size )
+            {
+                SDL_GPUTransferBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = usage;
+                info.size = size;
+
+                TransferBuffer buffer;
+                if ( !buffer.Create( *device, &info ) )
+                    return -1;
+
+                Block block;
+                block.buffer = buffer;
+                block.mapped = nullptr;
+                block.size = size;
+                block.head = 0;
+                block.tail = 0;
+                block.touched = false;
+                block.carried = false;
+                if ( blocks.Append( block ) == nullptr )
+                {
+                    buffer.Release( *device );
+                    SDL_OutOfMemory();
+                    return -1;
+                }
+
+                grows++;
+                return blocks.Num() - 1;
+            }
+
+            SDL_INLINE void Retire( const Uint64 frame )
+            {
+                int count = 0;
+                while ( count < marks.Num() && marks[count].frame <= frame )
+                {
+                    blocks[marks[count].block].tail = marks[count].head;
+                    count++;
+                }
+
+                if ( count > 0 )
+                {
+                    SDL_memmove( marks.Ptr(), marks.Ptr() + count, sizeof( Mark ) * ( marks.Num() - count ) );
+                    marks.Resize( marks.Num() - count );
+                }
+            }
+
+            SDL_INLINE bool HasMarks( const int block ) const
+            {
+                for ( int i = 0; i < marks.Num(); i++ )
+                {
+                    if ( marks[i].block == block )
+                        return true;
+                }
+                return false;
+            }
+
+            SDL_INLINE Uint64 Used( void ) const
+            {
+                Uint64 used = 0;
+                for ( int i = 0; i < blocks.Num(); i++ )
+                    used += blocks[i].head - blocks[i].tail;
+                return used;
+            }
+
+            const Device*               device;
+            SDL_GPUTransferBufferUsage  usage;
+            Uint32                      blockSize;
+            int                         current;
+            Uint64                      frameId;
+            Uint64                      peakUsed;
+            Uint64                      frameBytes;
+            Uint32                      frameAllocations;
+            Uint32                      grows;
+            Array<Block>                blocks;
+            Array<Mark>                 marks;
+            Array<Frame>                frames;
+        };
+    };
+};
+
+#endif //!__SDL_TRANSFER_RING_HPP__
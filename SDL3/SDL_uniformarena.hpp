@@ -0,0 +1,369 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_UNIFORM_ARENA_HPP__
+#define __SDL_UNIFORM_ARENA_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_gpu.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+UniformArena
+==================================================================
+    Packs the per draw uniform blocks of a frame into one storage
+    buffer. Blocks are written into a mapped transfer buffer between
+    Begin and Upload, Upload sends them with a single copy, and draws
+    only push the offset ( or element index ) of their block, a
+    4 byte uniform, instead of the whole block.
+
+    Both the transfer buffer and the storage buffer are cycled every
+    frame, so the previous frames can still read theirs. The transfer
+    buffer grows when a frame does not fit, the storage buffer follows
+    at the next Upload. Every block must be written before the copy
+    pass that uploads them, so the render passes using them come after.
+
+    Shader side ( HLSL, vertex stage ):
+        struct DrawData { float4x4 mvp; float4 color; };
+        StructuredBuffer<DrawData> Draws : register( t0, space0 );
+        cbuffer DrawIndex : register( b0, space1 ) { uint drawIndex; };
+        ...
+        DrawData draw = Draws[drawIndex];
+
+    Example usage:
+        SDL::GPU::UniformArena arena;
+        arena.Create( device, 256 * 1024 );
+        ...
+        arena.Begin();
+        for ( int i = 0; i < numDraws; i++ )
+            draws[i].index = arena.PushElement( draws[i].data );
+        arena.Upload( copyPass );
+        copyPass.End();
+        ...
+        arena.BindVertex( renderPass, 0 );
+        for ( int i = 0; i < numDraws; i++ )
+        {
+            SDL::GPU::UniformArena::PushVertexIndex( commandBuffer, 0, draws[i].index );
+            renderPass.DrawGPUPrimitives( 36, 1, 0, 0 );
+        }
+==================================================================
+*/
+        class UniformArena
+        {
+        public:
+            static const Uint32 DEFAULT_ALIGNMENT = 16;
+            static const Uint32 INVALID_OFFSET = 0xffffffff;
+
+            struct Stats
+            {
+                Uint32  capacity;       // transfer buffer size
+                Uint32  bufferSize;     // storage buffer size
+                Uint32  used;           // bytes written this frame, padding included
+                Uint32  peakUsed;
+                Uint32  blocks;         // blocks written this frame
+                Uint32  grows;
+            };
+
+            UniformArena( void ) : device( nullptr ), transfer( nullptr ), buffer( nullptr ), mapped( nullptr ), usage( 0 ),
+                                   capacity( 0 ), bufferSize( 0 ), used( 0 ), peakUsed( 0 ), blocks( 0 ), grows( 0 ) {}
+            ~UniformArena( void ) { Release(); }
+
+            /// @brief Create the transfer and storage buffers.
+            /// @param device the device, it must outlive the arena.
+            /// @param size initial size in bytes.
+            /// @param buffer_usage the stages reading the blocks.
+            /// @return true on success or false on failure; call SDL_GetError() for more information.
+            SDL_INLINE bool Create( const Device &_device, const Uint32 size, const SDL_GPUBufferUsageFlags buffer_usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ )
+            {
+                Release();
+
+                device = &_device;
+                usage = buffer_usage;
+                transfer = CreateTransfer( size > 0 ? size : 64 * 1024 );
+                if ( transfer == nullptr || !CreateBuffer( capacity ) )
+                {
+                    Release();
+                    return false;
+                }
+                grows = 0;
+                return true;
+            }
+
+            SDL_INLINE void Release( void )
+            {
+                if ( device == nullptr )
+                    return;
+
+                TransferBuffer staging( transfer );
+                if ( mapped != nullptr )
+                    staging.Unmap( *device );
+                staging.Release( *device );
+                Buffer storage( buffer );
+                storage.Release( *device );
+
+                device = nullptr;
+                transfer = nullptr;
+                buffer = nullptr;
+                mapped = nullptr;
+                capacity = 0;
+                bufferSize = 0;
+                used = 0;
+                peakUsed = 0;
+                blocks = 0;
+                grows = 0;
+            }
+
+            /// @brief Start a frame, the blocks of the previous frame are left to the GPU.
+            SDL_INLINE bool Begin( void )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "UniformArena: not created" );
+
+                used = 0;
+                blocks = 0;
+                if ( mapped == nullptr )
+                {
+                    TransferBuffer staging( transfer );
+                    mapped = static_cast<Uint8*>( staging.Map( *device, true ) );
+                }
+                return mapped != nullptr;
+            }
+
+            /// @brief Reserve a block to write in place.
+            /// @param alignment the offset is a multiple of it, it does not need to be a power of two.
+            /// @return the block memory, valid until Upload, or nullptr on failure.
+            SDL_INLINE void* Allocate( const Uint32 size, const Uint32 alignment, Uint32 &offset )
+            {
+                offset = INVALID_OFFSET;
+                if ( mapped == nullptr )
+                {
+                    SDL_SetError( "UniformArena: Begin was not called" );
+                    return nullptr;
+                }
+                if ( size == 0 || alignment == 0 )
+                {
+                    SDL_SetError( "UniformArena: invalid size %u or alignment %u", size, alignment );
+                    return nullptr;
+                }
+
+                const Uint64 start = ( ( Uint64 )used + alignment - 1 ) / alignment * alignment;
+                const Uint64 end = start + size;
+                if ( end > 0x7fffffff )
+                {
+                    SDL_SetError( "UniformArena: frame too large" );
+                    return nullptr;
+                }
+                if ( end > capacity && !Grow( ( Uint32 )end ) )
+                    return nullptr;
+
+                offset = ( Uint32 )start;
+                used = ( Uint32 )end;
+                blocks++;
+                return mapped + start;
+            }
+
+            /// @brief Copy a block in.
+            /// @return the byte offset of the block, or INVALID_OFFSET on failure.
+            SDL_INLINE Uint32 Push( const void *data, const Uint32 size, const Uint32 alignment = DEFAULT_ALIGNMENT )
+            {
+                Uint32 offset;
+                void *dst = Allocate( size, alignment, offset );
+                if ( dst != nullptr )
+                    SDL_memcpy( dst, data, size );
+                return offset;
+            }
+
+            /// @brief Copy a block in at a multiple of its size.
+            /// @return the index of the block in a StructuredBuffer<t_>, or INVALID_OFFSET on failure.
+            template<typename t_>
+            SDL_INLINE Uint32 PushElement( const t_ &block )
+            {
+                const Uint32 offset = Push( &block, sizeof( t_ ), sizeof( t_ ) );
+                return offset != INVALID_OFFSET ? offset / ( Uint32 )sizeof( t_ ) : INVALID_OFFSET;
+            }
+
+            /// @brief Unmap and record the copy of the frame's blocks.
+            SDL_INLINE bool Upload( const CopyPass &copyPass )
+            {
+                if ( mapped == nullptr )
+                    return SDL_SetError( "UniformArena: Begin was not called" );
+
+                TransferBuffer staging( transfer );
+                staging.Unmap( *device );
+                mapped = nullptr;
+                if ( used > peakUsed )
+                    peakUsed = used;
+                if ( used == 0 )
+                    return true;
+
+                if ( used > bufferSize )
+                {
+                    // the old buffer is released once the frames reading it are done
+                    Buffer storage( buffer );
+                    storage.Release( *device );
+                    buffer = nullptr;
+                    if ( !CreateBuffer( capacity ) )
+                        return false;
+                }
+
+                SDL_GPUTransferBufferLocation source;
+                source.transfer_buffer = transfer;
+                source.offset = 0;
+                SDL_GPUBufferRegion destination;
+                destination.buffer = buffer;
+                destination.offset = 0;
+                destination.size = used;
+                copyPass.UploadToBuffer( &source, &destination, true );
+                return true;
+            }
+
+            SDL_INLINE void BindVertex( const RenderPass &renderPass, const Uint32 slot ) const
+            {
+                renderPass.BindVertexStorageBuffers( slot, &buffer, 1 );
+            }
+
+            SDL_INLINE void BindFragment( const RenderPass &renderPass, const Uint32 slot ) const
+            {
+                renderPass.BindFragmentStorageBuffers( slot, &buffer, 1 );
+            }
+
+            SDL_INLINE void BindCompute( const ComputePass &computePass, const Uint32 slot ) const
+            {
+                computePass.BindComputeStorageBuffers( slot, &buffer, 1 );
+            }
+
+            /// @brief Push the offset ( or index ) of a block to a vertex uniform slot.
+            static SDL_INLINE void PushVertexIndex( const CommandBuffer &commandBuffer, const Uint32 slot, const Uint32 index )
+            {
+                commandBuffer.PushGPUVertexUniformData( slot, &index, sizeof( index ) );
+            }
+
+            static SDL_INLINE void PushFragmentIndex( const CommandBuffer &commandBuffer, const Uint32 slot, const Uint32 index )
+            {
+                commandBuffer.PushFragmentUniformData( slot, &index, sizeof( index ) );
+            }
+
+            static SDL_INLINE void PushComputeIndex( const CommandBuffer &commandBuffer, const Uint32 slot, const Uint32 index )
+            {
+                commandBuffer.PushComputeUniformData( slot, &index, sizeof( index ) );
+            }
+
+            SDL_INLINE SDL_GPUBuffer* GetBuffer( void ) const { return buffer; }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats;
+                stats.capacity = capacity;
+                stats.bufferSize = bufferSize;
+                stats.used = used;
+                stats.peakUsed = used > peakUsed ? used : peakUsed;
+                stats.blocks = blocks;
+                stats.grows = grows;
+                return stats;
+            }
+
+        private:
+            UniformArena( const UniformArena & );
+            UniformArena &operator=( const UniformArena & );
+
+            SDL_INLINE SDL_GPUTransferBuffer* CreateTransfer( const Uint32 size )
+            {
+                SDL_GPUTransferBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+                info.size = size;
+                TransferBuffer staging;
+                if ( !staging.Create( *device, &info ) )
+                    return nullptr;
+                capacity = size;
+                return staging;
+            }
+
+            SDL_INLINE bool CreateBuffer( const Uint32 size )
+            {
+                SDL_GPUBufferCreateInfo info;
+                SDL_zero( info );
+                info.usage = usage;
+                info.size = size;
+                Buffer storage;
+                if ( !storage.Create( *device, &info ) )
+                    return false;
+                buffer = storage;
+                bufferSize = size;
+                return true;
+            }
+
+            // the frame does not fit: move what was written to a larger transfer buffer
+            SDL_INLINE bool Grow( const Uint32 needed )
+            {
+                Uint32 size = capacity;
+                while ( size < needed )
+                    size = size < 0x40000000 ? size * 2 : needed;
+
+                const Uint32 oldCapacity = capacity;
+                SDL_GPUTransferBuffer *grown = CreateTransfer( size );
+                if ( grown == nullptr )
+                    return false;
+
+                TransferBuffer staging( grown );
+                Uint8 *data = static_cast<Uint8*>( staging.Map( *device, false ) );
+                if ( data == nullptr )
+                {
+                    staging.Release( *device );
+                    capacity = oldCapacity;
+                    return false;
+                }
+                if ( used > 0 )
+                    SDL_memcpy( data, mapped, used );
+
+                TransferBuffer old( transfer );
+                old.Unmap( *device );
+                old.Release( *device );
+                transfer = grown;
+                mapped = data;
+                grows++;
+                return true;
+            }
+
+            const Device*           device;
+            SDL_GPUTransferBuffer*  transfer;
+            SDL_GPUBuffer*          buffer;
+            Uint8*                  mapped;         // while between Begin and Upload
+            SDL_GPUBufferUsageFlags usage;
+            Uint32                  capacity;
+            Uint32                  bufferSize;
+            Uint32                  used;
+            Uint32                  peakUsed;
+            Uint32                  blocks;
+            Uint32                  grows;
+        };
+    }
+}
+#endif //!__SDL_UNIFORM_ARENA_HPP__
@@ -0,0 +1,316 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+#ifndef __SDL_UPLOAD_BATCHER_HPP__
+#define __SDL_UPLOAD_BATCHER_HPP__
+
+#include <SDL3/SDL_gpu.h>
+#include "SDL_array.hpp"
+#include "SDL_gpu.hpp"
+#include "SDL_transferring.hpp"
+
+namespace SDL
+{
+    namespace GPU
+    {
+/*
+==================================================================
+UploadBatcher
+==================================================================
+    Gathers the small buffer writes of a frame and uploads them
+    together, instead of a transfer location and an UploadToBuffer
+    call for each one.
+
+    Write copies the bytes aside ( Allocate returns the space to fill
+    in place ). Flush sorts the writes by buffer and offset, merges the
+    ones that touch or overlap into runs, packs the runs into a single
+    range of a TransferRing and records one upload per run, in one
+    copy pass. Where writes overlap, the later write wins, as if they
+    had been uploaded in order.
+
+    Uploads do not cycle the buffers, since a run only covers part of
+    a buffer; SDL orders them after the draws of the previous frames
+    still reading those buffers. EndFrame passes the fence of the
+    frame to the ring, which reuses the transfer space once it
+    signals.
+
+    Example usage:
+        SDL::GPU::UploadBatcher uploads;
+        uploads.Create( device );
+        ...
+        for ( int i = 0; i < numBones; i++ )
+            uploads.Write( boneBuffer, i * sizeof( Matrix ), &bones[i], sizeof( Matrix ) );
+        uploads.Flush( commandBuffer );
+        ...
+        uploads.EndFrame( commandBuffer.SubmitAndAcquireFence() );
+==================================================================
+*/
+        class UploadBatcher
+        {
+        public:
+            static const Uint32 DEFAULT_BLOCK_SIZE = 1024 * 1024;
+            // start of each run in the transfer range
+            static const Uint32 RUN_ALIGNMENT = 16;
+
+            struct Stats
+            {
+                Uint64  writes;
+                Uint64  bytes;
+                Uint64  uploads;        // UploadToBuffer calls, one per run
+                Uint64  flushes;
+                Uint32  pendingWrites;
+                Uint32  pendingBytes;
+            };
+
+            UploadBatcher( void ) : device( nullptr ) { SDL_zero( counters ); }
+            ~UploadBatcher( void ) { Destroy(); }
+
+            /// @param block_size size of the transfer ring blocks.
+            SDL_INLINE bool Create( const Device &_device, const Uint32 block_size = DEFAULT_BLOCK_SIZE )
+            {
+                Destroy();
+                if ( !ring.Create( _device, block_size ) )
+                    return false;
+                device = &_device;
+                SDL_zero( counters );
+                return true;
+            }
+
+            SDL_INLINE void Destroy( void )
+            {
+                if ( device == nullptr )
+                    return;
+                ring.Release();
+                writes.Free();
+                bytes.Free();
+                runs.Free();
+                device = nullptr;
+            }
+
+            /// @brief Reserve size bytes to upload at offset in buffer, the caller fills them.
+            /// @return the space, valid until the next Write, Allocate or Flush; nullptr on failure.
+            SDL_INLINE void* Allocate( SDL_GPUBuffer *buffer, const Uint32 offset, const Uint32 size )
+            {
+                if ( device == nullptr )
+                {
+                    SDL_SetError( "UploadBatcher: not created" );
+                    return nullptr;
+                }
+                if ( buffer == nullptr || size == 0 || offset > 0xffffffffu - size || ( Uint64 )bytes.Num() + size > 0x7fffffff )
+                {
+                    SDL_SetError( "UploadBatcher: invalid write of %u bytes at %u", size, offset );
+                    return nullptr;
+                }
+
+                const int start = bytes.Num();
+                Uint8 *data = bytes.AppendUninitialized( ( int )size );
+                PendingWrite *write = data != nullptr ? writes.AppendUninitialized( 1 ) : nullptr;
+                if ( write == nullptr )
+                {
+                    bytes.Resize( start );
+                    SDL_OutOfMemory();
+                    return nullptr;
+                }
+                write->buffer = buffer;
+                write->offset = offset;
+                write->size = size;
+                write->data = ( Uint32 )start;
+                write->order = ( Uint32 )( writes.Num() - 1 );
+                return data;
+            }
+
+            /// @brief Copy size bytes to upload at offset in buffer.
+            SDL_INLINE bool Write( SDL_GPUBuffer *buffer, const Uint32 offset, const void *data, const Uint32 size )
+            {
+                void *dst = Allocate( buffer, offset, size );
+                if ( dst == nullptr )
+                    return false;
+                SDL_memcpy( dst, data, size );
+                return true;
+            }
+
+            /// @brief Record the uploads of the pending writes into a copy pass.
+            /// @return false if the transfer space could not be allocated, the writes are then kept.
+            SDL_INLINE bool Flush( const CopyPass &copyPass )
+            {
+                if ( writes.Num() == 0 )
+                    return true;
+
+                SDL_qsort( writes.Ptr(), ( size_t )writes.Num(), sizeof( PendingWrite ), CompareDestination );
+
+                // runs of writes to the same buffer touching or overlapping each other
+                runs.Clear();
+                Uint64 total = 0;
+                for ( int i = 0; i < writes.Num(); )
+                {
+                    Run run;
+                    run.first = i;
+                    run.start = writes[i].offset;
+                    Uint64 end = ( Uint64 )writes[i].offset + writes[i].size;
+                    run.overlapping = false;
+                    for ( i++; i < writes.Num() && writes[i].buffer == writes[run.first].buffer && writes[i].offset <= end; i++ )
+                    {
+                        const PendingWrite &write = writes[i];
+                        run.overlapping |= write.offset < end;
+                        if ( ( Uint64 )write.offset + write.size > end )
+                            end = ( Uint64 )write.offset + write.size;
+                    }
+                    run.count = i - run.first;
+                    run.size = ( Uint32 )( end - run.start );
+                    run.source = ( Uint32 )total;
+                    total += ( run.size + RUN_ALIGNMENT - 1 ) & ~( Uint64 )( RUN_ALIGNMENT - 1 );
+                    if ( !runs.Append( run ) )
+                        return SDL_OutOfMemory();
+                }
+                if ( total > 0xffffffffu )
+                    return SDL_SetError( "UploadBatcher: %llu bytes in one flush", ( unsigned long long )total );
+
+                TransferRing::Allocation range;
+                if ( !ring.Allocate( ( Uint32 )total, RUN_ALIGNMENT, range ) )
+                    return false;
+                for ( int r = 0; r < runs.Num(); r++ )
+                {
+                    const Run &run = runs[r];
+                    PendingWrite *first = writes.Ptr() + run.first;
+                    // copied in call order, so the later of overlapping writes wins
+                    if ( run.overlapping )
+                        SDL_qsort( first, ( size_t )run.count, sizeof( PendingWrite ), CompareOrder );
+                    Uint8 *dst = range.data + run.source;
+                    for ( int i = 0; i < run.count; i++ )
+                        SDL_memcpy( dst + ( first[i].offset - run.start ), bytes.Ptr() + first[i].data, first[i].size );
+                }
+                ring.Unmap();
+
+                for ( int r = 0; r < runs.Num(); r++ )
+                {
+                    const Run &run = runs[r];
+                    SDL_GPUTransferBufferLocation source;
+                    source.transfer_buffer = range.buffer;
+                    source.offset = range.offset + run.source;
+                    SDL_GPUBufferRegion destination;
+                    destination.buffer = writes[run.first].buffer;
+                    destination.offset = run.start;
+                    destination.size = run.size;
+                    copyPass.UploadToBuffer( &source, &destination, false );
+                }
+
+                counters.writes += ( Uint64 )writes.Num();
+                counters.bytes += ( Uint64 )bytes.Num();
+                counters.uploads += ( Uint64 )runs.Num();
+                counters.flushes++;
+                writes.Clear();
+                bytes.Clear();
+                return true;
+            }
+
+            /// @brief Record the uploads of the pending writes in a copy pass of their own.
+            SDL_INLINE bool Flush( const CommandBuffer &commandBuffer )
+            {
+                if ( writes.Num() == 0 )
+                    return true;
+                CopyPass copyPass;
+                if ( !copyPass.Begin( commandBuffer ) )
+                    return false;
+                const bool ok = Flush( copyPass );
+                copyPass.End();
+                return ok;
+            }
+
+            /// @brief Drop the pending writes.
+            SDL_INLINE void Clear( void )
+            {
+                writes.Clear();
+                bytes.Clear();
+            }
+
+            /// @brief Close the frame, the transfer space is reused once fence signals.
+            /// @param fence the fence of the command buffer holding the uploads, the batcher releases it.
+            SDL_INLINE bool EndFrame( SDL_GPUFence *fence )
+            {
+                if ( device == nullptr )
+                    return SDL_SetError( "UploadBatcher: not created" );
+                return ring.EndFrame( fence );
+            }
+
+            SDL_INLINE Stats GetStats( void ) const
+            {
+                Stats stats = counters;
+                stats.pendingWrites = ( Uint32 )writes.Num();
+                stats.pendingBytes = ( Uint32 )bytes.Num();
+                return stats;
+            }
+
+        private:
+            UploadBatcher( const UploadBatcher & );
+            UploadBatcher &operator=( const UploadBatcher & );
+
+            struct PendingWrite
+            {
+                SDL_GPUBuffer*  buffer;
+                Uint32          offset;
+                Uint32          size;
+                Uint32          data;       // offset in bytes
+                Uint32          order;      // call order
+            };
+
+            struct Run
+            {
+                int     first;              // in writes, after sorting
+                int     count;
+                Uint32  start;              // in the destination buffer
+                Uint32  size;
+                Uint32  source;             // in the transfer range
+                bool    overlapping;
+            };
+
+            static int SDLCALL CompareDestination( const void *a, const void *b )
+            {
+                const PendingWrite *x = static_cast<const PendingWrite*>( a );
+                const PendingWrite *y = static_cast<const PendingWrite*>( b );
+                if ( x->buffer != y->buffer )
+                    return ( uintptr_t )x->buffer < ( uintptr_t )y->buffer ? -1 : 1;
+                if ( x->offset != y->offset )
+                    return x->offset < y->offset ? -1 : 1;
+                return x->order < y->order ? -1 : ( x->order > y->order ? 1 : 0 );
+            }
+
+            static int SDLCALL CompareOrder( const void *a, const void *b )
+            {
+                const PendingWrite *x = static_cast<const PendingWrite*>( a );
+                const PendingWrite *y = static_cast<const PendingWrite*>( b );
+                return x->order < y->order ? -1 : ( x->order > y->order ? 1 : 0 );
+            }
+
+            const Device*       device;
+            TransferRing        ring;
+            Array<PendingWrite> writes;
+            Array<Uint8>        bytes;      // the data of the pending writes
+            Array<Run>          runs;
+            Stats               counters;
+        };
+    }
+}
+#endif //!__SDL_UPLOAD_BATCHER_HPP__
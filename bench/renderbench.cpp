@@ -0,0 +1,572 @@
+/*
+===========================================================================================
+    This file is part of SDL3++.
+
+    Copyright (c) 2025 Cristiano B. Santos <cristianobeato_dm@hotmail.com>
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------------------
+    This software is provided 'as-is', without any express or implied
+    warranty.  In no event will the authors be held liable for any damages
+    arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+  
+1.  The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required. 
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+3.  This notice may not be removed or altered from any source distribution.
+
+===========================================================================================
+*/
+
+/*
+==================================================================
+renderbench
+==================================================================
+    Headless benchmark for SDL::Renderer. Everything is drawn by the
+    software renderer into an SDL::Surface, and the video subsystem is
+    forced to the offscreen/dummy drivers, so it runs on machines
+    without a GPU or a display server.
+
+    Each case is measured at several batch sizes and the results are
+    written as JSON so two runs ( two commits ) can be diffed.
+
+    Build:
+        c++ -std=c++11 -O2 renderbench.cpp $(pkg-config --cflags --libs sdl3) -o renderbench
+
+    A session recorded with SDL::Capture::Recorder can be replayed
+    instead of the synthetic cases with --replay, the per frame times
+    ( the fastest of --loops runs ) are written to the JSON.
+
+    Usage:
+        renderbench [--out file.json] [--tag name] [--size WxH]
+                    [--batches 1,16,256,4096] [--min-time ms] [--case name]
+        renderbench --replay session.s3pc [--loops 5] [--out file.json] [--tag name]
+==================================================================
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include "../SDL3/SDL_render.hpp"
+#include "../SDL3/SDL_iostream.hpp"
+#include "../SDL3/SDL_rendercapture.hpp"
+#include "../SDL3/SDL_statsoverlay.hpp"
+
+#define BENCH_MAX_BATCHES   16
+#define BENCH_WARMUP        3
+#define BENCH_MIN_SAMPLES   10
+#define BENCH_MAX_SAMPLES   100000
+#define BENCH_TEXTURE_SIZE  64
+
+struct BenchContext
+{
+    BenchContext( void ) : width( 0 ), height( 0 ), capacity( 0 ), points( nullptr ), rects( nullptr ), vertices( nullptr ), indices( nullptr ) {}
+
+    SDL::Surface    target;
+    SDL::Renderer   renderer;
+    SDL::Texture    texture;
+    SDL::StatsOverlay overlay;
+    int             width;
+    int             height;
+    int             capacity;
+    SDL_FPoint*     points;
+    SDL_FRect*      rects;
+    SDL_Vertex*     vertices;
+    int*            indices;
+};
+
+// returns the number of items ( primitives or pixels ) processed, or -1 on failure
+typedef Sint64 ( *BenchFunc )( BenchContext &ctx, const int batch );
+
+struct BenchCase
+{
+    const char* name;
+    const char* unit;
+    BenchFunc   func;
+};
+
+struct BenchResult
+{
+    Uint64  iterations;
+    Sint64  items;
+    double  minNS;
+    double  medianNS;
+    double  meanNS;
+};
+
+static Uint32 s_seed = 0x12345678;
+
+static float BenchRandom( const float max )
+{
+    s_seed = s_seed * 1664525u + 1013904223u;
+    return ( float )( s_seed >> 8 ) / ( float )( 1 << 24 ) * max;
+}
+
+static int CompareDouble( const void *a, const void *b )
+{
+    const double da = *( const double* )a;
+    const double db = *( const double* )b;
+    return ( da < db ) ? -1 : ( da > db ) ? 1 : 0;
+}
+
+/*
+==================================================================
+Cases
+==================================================================
+*/
+static Sint64 BenchPoints( BenchContext &ctx, const int batch )
+{
+    ctx.renderer.SetDrawColor( 255, 255, 255, 255 );
+    if ( !ctx.renderer.RenderPoints( ctx.points, batch ) )
+        return -1;
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchLines( BenchContext &ctx, const int batch )
+{
+    ctx.renderer.SetDrawColor( 0, 255, 0, 255 );
+    // a polyline of batch segments
+    if ( !ctx.renderer.RenderLines( ctx.points, batch + 1 ) )
+        return -1;
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchFillRects( BenchContext &ctx, const int batch )
+{
+    ctx.renderer.SetDrawColor( 255, 0, 0, 255 );
+    if ( !ctx.renderer.RenderFillRects( ctx.rects, batch ) )
+        return -1;
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchTexturedQuads( BenchContext &ctx, const int batch )
+{
+    for ( int i = 0; i < batch; i++ )
+    {
+        if ( !ctx.renderer.RenderTexture( ctx.texture, nullptr, &ctx.rects[i] ) )
+            return -1;
+    }
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchRotatedQuads( BenchContext &ctx, const int batch )
+{
+    for ( int i = 0; i < batch; i++ )
+    {
+        const double angle = ( double )( i * 37 % 360 );
+        if ( !ctx.renderer.RenderTextureRotated( ctx.texture, nullptr, &ctx.rects[i], angle, nullptr, SDL_FLIP_NONE ) )
+            return -1;
+    }
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchGeometry( BenchContext &ctx, const int batch )
+{
+    // one call for the whole batch of quads
+    if ( !ctx.renderer.RenderGeometry( ctx.texture, ctx.vertices, batch * 4, ctx.indices, batch * 6 ) )
+        return -1;
+    return ctx.renderer.Flush() ? batch : -1;
+}
+
+static Sint64 BenchReadback( BenchContext &ctx, const int batch )
+{
+    // batch is the number of full width rows read back
+    const int rows = SDL_min( batch, ctx.height );
+    const SDL_Rect rect = { 0, 0, ctx.width, rows };
+    SDL::Surface pixels( ctx.renderer.RenderReadPixels( &rect ) );
+    if ( !pixels.GetHandle() )
+        return -1;
+    return ( Sint64 )rows * ctx.width;
+}
+
+static Sint64 BenchStatsOverlay( BenchContext &ctx, const int batch )
+{
+    // the cost of building and queuing the overlay, the batch size does not apply
+    ( void )batch;
+    return ctx.overlay.Draw() ? 1 : -1;
+}
+
+static const BenchCase s_cases[] =
+{
+    { "points",         "points",   BenchPoints },
+    { "lines",          "lines",    BenchLines },
+    { "fill_rects",     "rects",    BenchFillRects },
+    { "textured_quads", "quads",    BenchTexturedQuads },
+    { "rotated_quads",  "quads",    BenchRotatedQuads },
+    { "geometry",       "quads",    BenchGeometry },
+    { "readback",       "pixels",   BenchReadback },
+    { "stats_overlay",  "frames",   BenchStatsOverlay },
+};
+
+/*
+==================================================================
+Setup
+==================================================================
+*/
+static bool BenchInit( BenchContext &ctx, const int width, const int height, const int capacity )
+{
+    ctx.width = width;
+    ctx.height = height;
+    ctx.capacity = capacity;
+
+    if ( !ctx.target.Create( width, height, SDL_PIXELFORMAT_ARGB8888 ) )
+        return false;
+
+    if ( !ctx.renderer.CreateSoftware( ctx.target ) )
+        return false;
+
+    // checkerboard source texture
+    Uint32 pixels[BENCH_TEXTURE_SIZE * BENCH_TEXTURE_SIZE];
+    for ( int y = 0; y < BENCH_TEXTURE_SIZE; y++ )
+    {
+        for ( int x = 0; x < BENCH_TEXTURE_SIZE; x++ )
+            pixels[y * BENCH_TEXTURE_SIZE + x] = ( ( x ^ y ) & 8 ) ? 0xFFFFFFFF : 0xFF3060A0;
+    }
+
+    if ( !ctx.texture.CreateTexture( ctx.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, BENCH_TEXTURE_SIZE, BENCH_TEXTURE_SIZE ) )
+        return false;
+
+    if ( !ctx.texture.Update( nullptr, pixels, BENCH_TEXTURE_SIZE * sizeof( Uint32 ) ) )
+        return false;
+
+    ctx.texture.SetBlendMode( SDL_BLENDMODE_BLEND );
+
+    if ( !ctx.overlay.Create( ctx.renderer ) )
+        return false;
+
+    ctx.points = static_cast<SDL_FPoint*>( SDL_malloc( sizeof( SDL_FPoint ) * ( capacity + 1 ) ) );
+    ctx.rects = static_cast<SDL_FRect*>( SDL_malloc( sizeof( SDL_FRect ) * capacity ) );
+    ctx.vertices = static_cast<SDL_Vertex*>( SDL_malloc( sizeof( SDL_Vertex ) * capacity * 4 ) );
+    ctx.indices = static_cast<int*>( SDL_malloc( sizeof( int ) * capacity * 6 ) );
+    if ( !ctx.points || !ctx.rects || !ctx.vertices || !ctx.indices )
+        return SDL_SetError( "renderbench: out of memory" );
+
+    for ( int i = 0; i <= capacity; i++ )
+    {
+        ctx.points[i].x = BenchRandom( ( float )width );
+        ctx.points[i].y = BenchRandom( ( float )height );
+    }
+
+    const float quad = ( float )BENCH_TEXTURE_SIZE * 0.5f;
+    for ( int i = 0; i < capacity; i++ )
+    {
+        SDL_FRect &r = ctx.rects[i];
+        r.x = BenchRandom( ( float )width - quad );
+        r.y = BenchRandom( ( float )height - quad );
+        r.w = quad;
+        r.h = quad;
+
+        const SDL_FColor white = { 1.0f, 1.0f, 1.0f, 1.0f };
+        SDL_Vertex *v = &ctx.vertices[i * 4];
+        v[0].position.x = r.x;          v[0].position.y = r.y;
+        v[1].position.x = r.x + r.w;    v[1].position.y = r.y;
+        v[2].position.x = r.x + r.w;    v[2].position.y = r.y + r.h;
+        v[3].position.x = r.x;          v[3].position.y = r.y + r.h;
+        v[0].tex_coord.x = 0.0f;        v[0].tex_coord.y = 0.0f;
+        v[1].tex_coord.x = 1.0f;        v[1].tex_coord.y = 0.0f;
+        v[2].tex_coord.x = 1.0f;        v[2].tex_coord.y = 1.0f;
+        v[3].tex_coord.x = 0.0f;        v[3].tex_coord.y = 1.0f;
+        for ( int j = 0; j < 4; j++ )
+            v[j].color = white;
+
+        int *idx = &ctx.indices[i * 6];
+        idx[0] = i * 4 + 0; idx[1] = i * 4 + 1; idx[2] = i * 4 + 2;
+        idx[3] = i * 4 + 0; idx[4] = i * 4 + 2; idx[5] = i * 4 + 3;
+    }
+
+    return true;
+}
+
+static void BenchShutdown( BenchContext &ctx )
+{
+    SDL_free( ctx.points );
+    SDL_free( ctx.rects );
+    SDL_free( ctx.vertices );
+    SDL_free( ctx.indices );
+    ctx.overlay.Destroy();
+    ctx.texture.Destroy();
+    ctx.renderer.Destroy();
+    ctx.target.Destroy();
+}
+
+/*
+==================================================================
+Measurement
+==================================================================
+*/
+static bool BenchRun( BenchContext &ctx, const BenchCase &bench, const int batch, const Uint64 minTimeNS, BenchResult &result )
+{
+    const double nsPerTick = 1e9 / ( double )SDL_GetPerformanceFrequency();
+    int sampleCapacity = 1024;
+    double *samples = static_cast<double*>( SDL_malloc( sizeof( double ) * sampleCapacity ) );
+    if ( !samples )
+        return SDL_SetError( "renderbench: out of memory" );
+
+    SDL_zero( result );
+
+    for ( int i = 0; i < BENCH_WARMUP; i++ )
+    {
+        ctx.renderer.Clear();
+        if ( bench.func( ctx, batch ) < 0 )
+        {
+            SDL_free( samples );
+            return false;
+        }
+    }
+
+    double total = 0.0;
+    Uint64 count = 0;
+    while ( count < BENCH_MIN_SAMPLES || ( total < ( double )minTimeNS && count < BENCH_MAX_SAMPLES ) )
+    {
+        // clearing is not part of the measured work
+        ctx.renderer.Clear();
+        ctx.renderer.Flush();
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        const Sint64 items = bench.func( ctx, batch );
+        const Uint64 end = SDL_GetPerformanceCounter();
+        if ( items < 0 )
+        {
+            SDL_free( samples );
+            return false;
+        }
+
+        if ( count == ( Uint64 )sampleCapacity )
+        {
+            sampleCapacity *= 2;
+            double *grown = static_cast<double*>( SDL_realloc( samples, sizeof( double ) * sampleCapacity ) );
+            if ( !grown )
+            {
+                SDL_free( samples );
+                return SDL_SetError( "renderbench: out of memory" );
+            }
+            samples = grown;
+        }
+
+        samples[count] = ( double )( end - start ) * nsPerTick;
+        total += samples[count];
+        result.items = items;
+        count++;
+    }
+
+    SDL_qsort( samples, ( size_t )count, sizeof( double ), CompareDouble );
+    result.iterations = count;
+    result.minNS = samples[0];
+    result.medianNS = samples[count / 2];
+    result.meanNS = total / ( double )count;
+
+    SDL_free( samples );
+    return true;
+}
+
+static int BenchReplay( const char *path, const int loops, const char *outPath, const char *tag )
+{
+    SDL::Capture::Replayer replay;
+    if ( !replay.Load( path ) )
+    {
+        SDL_Log( "renderbench: can't load %s: %s", path, SDL_GetError() );
+        return 1;
+    }
+
+    // keep the fastest time of every frame over all the loops
+    SDL::Array<double> best;
+    SDL::Array<double> frames;
+    for ( int loop = 0; loop < loops; loop++ )
+    {
+        if ( !replay.Play( frames ) )
+        {
+            SDL_Log( "renderbench: replay failed: %s", SDL_GetError() );
+            return 1;
+        }
+
+        if ( loop == 0 )
+        {
+            best.Resize( frames.Num() );
+            for ( int i = 0; i < frames.Num(); i++ )
+                best[i] = frames[i];
+        }
+
+        for ( int i = 0; i < frames.Num() && i < best.Num(); i++ )
+            best[i] = SDL_min( best[i], frames[i] );
+    }
+
+    const SDL::Capture::Replayer::Summary summary = SDL::Capture::Replayer::Summarize( best );
+    SDL_Log( "%s: %d frames  median %.3f ms  p95 %.3f ms  max %.3f ms", path, summary.frames, summary.medianMS, summary.p95MS, summary.maxMS );
+
+    SDL::IO::Stream out;
+    if ( !out.FromFile( outPath, "w" ) )
+    {
+        SDL_Log( "renderbench: can't open %s: %s", outPath, SDL_GetError() );
+        return 1;
+    }
+
+    const int version = SDL_GetVersion();
+    out.printf( "{\n  \"suite\": \"renderbench-replay\",\n  \"tag\": \"%s\",\n  \"capture\": \"%s\",\n", tag, path );
+    out.printf( "  \"sdl_version\": \"%d.%d.%d\",\n", SDL_VERSIONNUM_MAJOR( version ), SDL_VERSIONNUM_MINOR( version ), SDL_VERSIONNUM_MICRO( version ) );
+    out.printf( "  \"width\": %d,\n  \"height\": %d,\n  \"loops\": %d,\n", replay.GetWidth(), replay.GetHeight(), loops );
+    out.printf( "  \"summary\": { \"frames\": %d, \"total_ms\": %.3f, \"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"p95_ms\": %.4f, \"max_ms\": %.4f },\n",
+        summary.frames, summary.totalMS, summary.minMS, summary.medianMS, summary.meanMS, summary.p95MS, summary.maxMS );
+    out.printf( "  \"frame_ms\": [" );
+    for ( int i = 0; i < best.Num(); i++ )
+        out.printf( "%s%.4f", i ? ", " : "", best[i] );
+    out.printf( "]\n}\n" );
+    out.Close();
+    return 0;
+}
+
+static int ParseBatches( const char *list, int *batches )
+{
+    int count = 0;
+    const char *p = list;
+    while ( *p && count < BENCH_MAX_BATCHES )
+    {
+        const int value = SDL_atoi( p );
+        if ( value > 0 )
+            batches[count++] = value;
+        while ( *p && *p != ',' )
+            p++;
+        if ( *p == ',' )
+            p++;
+    }
+    return count;
+}
+
+int main( int argc, char *argv[] )
+{
+    const char *outPath = "renderbench.json";
+    const char *tag = "";
+    const char *filter = nullptr;
+    const char *replayPath = nullptr;
+    int loops = 5;
+    int width = 1280;
+    int height = 720;
+    Uint64 minTimeNS = SDL_MS_TO_NS( 200 );
+    int batches[BENCH_MAX_BATCHES] = { 1, 16, 256, 4096 };
+    int numBatches = 4;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const bool hasValue = i + 1 < argc;
+        if ( SDL_strcmp( argv[i], "--out" ) == 0 && hasValue )
+            outPath = argv[++i];
+        else if ( SDL_strcmp( argv[i], "--tag" ) == 0 && hasValue )
+            tag = argv[++i];
+        else if ( SDL_strcmp( argv[i], "--case" ) == 0 && hasValue )
+            filter = argv[++i];
+        else if ( SDL_strcmp( argv[i], "--min-time" ) == 0 && hasValue )
+            minTimeNS = SDL_MS_TO_NS( SDL_atoi( argv[++i] ) );
+        else if ( SDL_strcmp( argv[i], "--replay" ) == 0 && hasValue )
+            replayPath = argv[++i];
+        else if ( SDL_strcmp( argv[i], "--loops" ) == 0 && hasValue )
+            loops = SDL_max( 1, SDL_atoi( argv[++i] ) );
+        else if ( SDL_strcmp( argv[i], "--batches" ) == 0 && hasValue )
+            numBatches = ParseBatches( argv[++i], batches );
+        else if ( SDL_strcmp( argv[i], "--size" ) == 0 && hasValue )
+        {
+            const char *size = argv[++i];
+            width = SDL_atoi( size );
+            while ( *size && *size != 'x' )
+                size++;
+            height = *size ? SDL_atoi( size + 1 ) : 0;
+        }
+        else
+        {
+            SDL_Log( "usage: %s [--out file.json] [--tag name] [--size WxH] [--batches 1,16,256] [--min-time ms] [--case name] [--replay file [--loops n]]", argv[0] );
+            return 1;
+        }
+    }
+
+    if ( width <= 0 || height <= 0 || numBatches <= 0 )
+    {
+        SDL_Log( "renderbench: invalid size or batch list" );
+        return 1;
+    }
+
+    // keep SDL away from any real display or GPU
+    SDL_SetHint( SDL_HINT_VIDEO_DRIVER, "offscreen,dummy" );
+    SDL_SetHint( SDL_HINT_RENDER_DRIVER, "software" );
+    if ( !SDL_Init( SDL_INIT_VIDEO ) )
+    {
+        SDL_Log( "renderbench: SDL_Init failed: %s", SDL_GetError() );
+        return 1;
+    }
+
+    if ( replayPath != nullptr )
+    {
+        const int status = BenchReplay( replayPath, loops, outPath, tag );
+        SDL_Quit();
+        return status;
+    }
+
+    int capacity = 0;
+    for ( int i = 0; i < numBatches; i++ )
+        capacity = SDL_max( capacity, batches[i] );
+
+    BenchContext ctx;
+    if ( !BenchInit( ctx, width, height, capacity ) )
+    {
+        SDL_Log( "renderbench: setup failed: %s", SDL_GetError() );
+        BenchShutdown( ctx );
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL::IO::Stream out;
+    if ( !out.FromFile( outPath, "w" ) )
+    {
+        SDL_Log( "renderbench: can't open %s: %s", outPath, SDL_GetError() );
+        BenchShutdown( ctx );
+        SDL_Quit();
+        return 1;
+    }
+
+    const int version = SDL_GetVersion();
+    out.printf( "{\n  \"suite\": \"renderbench\",\n  \"tag\": \"%s\",\n", tag );
+    out.printf( "  \"sdl_version\": \"%d.%d.%d\",\n", SDL_VERSIONNUM_MAJOR( version ), SDL_VERSIONNUM_MINOR( version ), SDL_VERSIONNUM_MICRO( version ) );
+    out.printf( "  \"renderer\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n", ctx.renderer.GetName(), width, height );
+    out.printf( "  \"results\": [" );
+
+    int failures = 0;
+    bool first = true;
+    for ( size_t c = 0; c < SDL_arraysize( s_cases ); c++ )
+    {
+        const BenchCase &bench = s_cases[c];
+        if ( filter != nullptr && SDL_strcmp( filter, bench.name ) != 0 )
+            continue;
+
+        for ( int b = 0; b < numBatches; b++ )
+        {
+            BenchResult result;
+            if ( !BenchRun( ctx, bench, batches[b], minTimeNS, result ) )
+            {
+                SDL_Log( "%-16s batch %6d  FAILED: %s", bench.name, batches[b], SDL_GetError() );
+                failures++;
+                continue;
+            }
+
+            const double perItem = result.items > 0 ? result.medianNS / ( double )result.items : 0.0;
+            const double itemsPerSec = result.medianNS > 0.0 ? ( double )result.items * 1e9 / result.medianNS : 0.0;
+
+            SDL_Log( "%-16s batch %6d  median %12.1f ns  %10.2f ns/%s  %14.0f %s/s", bench.name, batches[b], result.medianNS, perItem, bench.unit, itemsPerSec, bench.unit );
+
+            out.printf( "%s\n    { \"case\": \"%s\", \"batch\": %d, \"unit\": \"%s\", \"items\": %" SDL_PRIs64 ", \"iterations\": %" SDL_PRIu64 ", ",
+                first ? "" : ",", bench.name, batches[b], bench.unit, result.items, result.iterations );
+            out.printf( "\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"ns_per_item\": %.3f, \"items_per_sec\": %.1f }",
+                result.minNS, result.medianNS, result.meanNS, perItem, itemsPerSec );
+            first = false;
+        }
+    }
+
+    out.printf( "\n  ]\n}\n" );
+    out.Close();
+
+    BenchShutdown( ctx );
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}